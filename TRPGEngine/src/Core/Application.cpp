@@ -13,7 +13,11 @@
 
 #include "Application.hpp"
 #include "EngineManager.hpp"
+#include "JobSystem.hpp"
 #include "Engine/GameplaySystem/GameInstance.hpp"
+#include "Engine/World.hpp"
+#include "Engine/EntitySystem/EntityManager.hpp"
+#include "Project/AutosaveService.hpp"
 #include "UI/EditorUI.hpp"
 #include "UI/ImGuiUtils/ImGuiUtils.hpp"
 
@@ -30,6 +34,11 @@ Application::~Application() {
 void Application::shutdown() {
     std::cout << "[Application] Shutting down...\n";
 
+    // Finish background jobs while the GL context still exists for their main-thread follow-ups
+    JobSystem::get().shutdown();
+    JobSystem::get().pumpMainThread();
+    World::endPlaySession();
+
     if (m_editorUI) {
         std::cout << "[Application] Shutting down Editor UI\n";
         m_editorUI->shutdown();
@@ -138,9 +147,15 @@ void Application::mainLoop() {
         float deltaTime = static_cast<float>(start - m_lastFrameTime);
         m_lastFrameTime = start;
 
+        // GL/ImGui work handed back from job threads
+        JobSystem::get().pumpMainThread();
+
         update(deltaTime);
         render();
 
+        // Sync point: structural ECS changes queued during update/UI are applied here
+        EntityManager::get().flushDeferred();
+
         glfwPollEvents();  // Essential to prevent freezing
 
         double end = glfwGetTime();
@@ -158,9 +173,11 @@ void Application::update(float deltaTime) {
     // Game and editor logic update
     // std::cout << "[Application] Updating (dt=" << deltaTime << ")\n";
 
-    if (GameInstance::get().isRunning()) {
-        GameInstance::get().update(deltaTime);
-    }
+    // The editor's world, or the play session's fork while playing
+    World::current().update(deltaTime);
+
+    // Snapshots the editor's world now and then; the writing happens on a job thread
+    AutosaveService::get().update(deltaTime);
 }
 
 void Application::render() {
@@ -185,8 +202,8 @@ void Application::togglePlayMode() {
     std::cout << "[Application] Play mode: " << (m_playing ? "ON" : "OFF") << "\n";
 
     if (m_playing) {
-        GameInstance::get().startGame();
+        World::beginPlaySession().game().startGame();
     } else {
-        GameInstance::get().reset();
+        World::endPlaySession();    // drops every change made while playing
     }
 }
@@ -0,0 +1,112 @@
+#include "Atom.hpp"
+
+#include <array>
+#include <atomic>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace {
+    struct Entry {
+        std::string text;
+        uint32_t hash = 0;
+    };
+
+    // Entries live in fixed-size chunks that never move, so ids resolve to
+    // text without locking and the lookup map can key on views of that text
+    constexpr uint32_t CHUNK_BITS = 12;
+    constexpr uint32_t CHUNK_SIZE = 1u << CHUNK_BITS;
+    constexpr uint32_t MAX_CHUNKS = 1u << 14;
+
+    uint32_t fnv1a(std::string_view text) {
+        uint32_t h = 2166136261u;
+        for (unsigned char c : text) {
+            h ^= c;
+            h *= 16777619u;
+        }
+        return h;
+    }
+
+    struct ViewHash {
+        size_t operator()(std::string_view text) const { return fnv1a(text); }
+    };
+
+    struct Table {
+        std::shared_mutex mutex;
+        std::unordered_map<std::string_view, uint32_t, ViewHash> ids;
+        std::array<std::atomic<Entry*>, MAX_CHUNKS> chunks{};
+        uint32_t count = 0;
+
+        Table() { add(std::string_view()); }
+
+        const Entry& at(uint32_t id) const {
+            return chunks[id >> CHUNK_BITS].load(std::memory_order_acquire)[id & (CHUNK_SIZE - 1)];
+        }
+
+        // Caller holds the unique lock
+        uint32_t add(std::string_view text) {
+            const uint32_t id = count;
+            const uint32_t chunk = id >> CHUNK_BITS;
+            if (chunk >= MAX_CHUNKS) {
+                std::cerr << "[Atom] Table full; interning as the empty atom.\n";
+                return 0;
+            }
+            Entry* entries = chunks[chunk].load(std::memory_order_relaxed);
+            if (!entries) {
+                entries = new Entry[CHUNK_SIZE];
+                chunks[chunk].store(entries, std::memory_order_release);
+            }
+            Entry& entry = entries[id & (CHUNK_SIZE - 1)];
+            entry.text.assign(text.data(), text.size());
+            entry.hash = fnv1a(text);
+            ids.emplace(std::string_view(entry.text), id);
+            ++count;
+            return id;
+        }
+    };
+
+    // Never destroyed: atoms held by other statics must stay valid during exit
+    Table& table() {
+        static Table* instance = new Table();
+        return *instance;
+    }
+}
+
+Atom::Atom(std::string_view text) {
+    if (text.empty()) return;
+    Table& t = table();
+    {
+        std::shared_lock<std::shared_mutex> lock(t.mutex);
+        auto it = t.ids.find(text);
+        if (it != t.ids.end()) {
+            m_id = it->second;
+            return;
+        }
+    }
+    std::unique_lock<std::shared_mutex> lock(t.mutex);
+    auto it = t.ids.find(text);
+    m_id = (it != t.ids.end()) ? it->second : t.add(text);
+}
+
+Atom Atom::find(std::string_view text) {
+    if (text.empty()) return Atom();
+    Table& t = table();
+    std::shared_lock<std::shared_mutex> lock(t.mutex);
+    auto it = t.ids.find(text);
+    return it != t.ids.end() ? Atom(it->second, 0) : Atom();
+}
+
+uint32_t Atom::hash() const {
+    return table().at(m_id).hash;
+}
+
+const std::string& Atom::str() const {
+    return table().at(m_id).text;
+}
+
+bool Atom::startsWith(std::string_view prefix) const {
+    const std::string& text = str();
+    return text.size() >= prefix.size() && text.compare(0, prefix.size(), prefix) == 0;
+}
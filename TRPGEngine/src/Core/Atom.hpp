@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <json.hpp>
+
+/**
+ * Interned string: equal text always maps to the same 32-bit id, so
+ * comparing, hashing and copying an Atom are integer operations. Text and
+ * its hash are stored once in a process-wide, thread-safe table that never
+ * shrinks, so intern names, keys and link targets rather than free text.
+ *
+ * Converts implicitly from and to strings so fields can switch from
+ * std::string without touching every reader; constructing an Atom from a
+ * string interns it (use Atom::find() to only look one up).
+ */
+class Atom {
+public:
+    Atom() = default;               // the empty string, id 0
+    Atom(std::string_view text);
+    Atom(const std::string& text) : Atom(std::string_view(text)) {}
+    Atom(const char* text) : Atom(std::string_view(text ? text : "")) {}
+
+    // The atom for `text` if it was interned before; the empty atom otherwise
+    static Atom find(std::string_view text);
+
+    uint32_t id() const { return m_id; }
+    uint32_t hash() const;
+    bool empty() const { return m_id == 0; }
+    size_t size() const { return str().size(); }
+
+    const std::string& str() const;
+    const char* c_str() const { return str().c_str(); }
+    operator const std::string&() const { return str(); }
+
+    bool startsWith(std::string_view prefix) const;
+
+    friend bool operator==(Atom a, Atom b) { return a.m_id == b.m_id; }
+    friend bool operator!=(Atom a, Atom b) { return a.m_id != b.m_id; }
+
+private:
+    explicit Atom(uint32_t id, int) : m_id(id) {}
+
+    uint32_t m_id = 0;
+};
+
+struct AtomHash {
+    size_t operator()(Atom a) const { return a.hash(); }
+};
+
+inline void to_json(nlohmann::json& j, const Atom& a) { j = a.str(); }
+inline void from_json(const nlohmann::json& j, Atom& a) { a = Atom(j.get_ref<const std::string&>()); }
+
+inline std::ostream& operator<<(std::ostream& os, const Atom& a) { return os << a.str(); }
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+/**
+ * Little helpers for flat binary records. Values are copied in host byte
+ * order (little-endian on every platform we ship), strings as a 32-bit
+ * length and their bytes.
+ *
+ * A ByteWriter without a buffer only counts, so the same code first sizes a
+ * record and then writes it into a buffer allocated once:
+ *
+ *   ByteWriter counter;  encode(counter);
+ *   std::vector<uint8_t> out(counter.position());
+ *   ByteWriter writer(out.data(), out.size());  encode(writer);
+ */
+class ByteWriter {
+public:
+    ByteWriter() = default;
+    ByteWriter(uint8_t* data, size_t capacity) : m_data(data), m_capacity(capacity) {}
+
+    size_t position() const { return m_pos; }
+    bool isCounting() const { return m_data == nullptr; }
+
+    void bytes(const void* src, size_t n) {
+        if (m_data) {
+            if (n > m_capacity - m_pos) throw std::runtime_error("[ByteStream] write past the end of the buffer");
+            std::memcpy(m_data + m_pos, src, n);
+        }
+        m_pos += n;
+    }
+
+    template <typename T>
+    void pod(const T& v) { bytes(&v, sizeof(T)); }
+
+    void u8(uint8_t v) { pod(v); }
+    void u32(uint32_t v) { pod(v); }
+    void u64(uint64_t v) { pod(v); }
+
+    void string(std::string_view s) {
+        u32(static_cast<uint32_t>(s.size()));
+        bytes(s.data(), s.size());
+    }
+
+    // Leaves room for a u32 filled in later by patchU32(); returns where
+    size_t reserveU32() {
+        const size_t at = m_pos;
+        u32(0);
+        return at;
+    }
+    void patchU32(size_t at, uint32_t v) {
+        if (m_data) std::memcpy(m_data + at, &v, sizeof(v));
+    }
+
+private:
+    uint8_t* m_data = nullptr;
+    size_t m_capacity = 0;
+    size_t m_pos = 0;
+};
+
+// Reads what ByteWriter wrote. Throws std::runtime_error on truncated data.
+class ByteReader {
+public:
+    ByteReader(const uint8_t* data, size_t size) : m_data(data), m_size(size) {}
+
+    size_t position() const { return m_pos; }
+    size_t remaining() const { return m_size - m_pos; }
+    bool atEnd() const { return m_pos == m_size; }
+
+    void seek(size_t pos) {
+        if (pos > m_size) fail();
+        m_pos = pos;
+    }
+
+    const uint8_t* bytes(size_t n) {
+        if (n > m_size - m_pos) fail();
+        const uint8_t* p = m_data + m_pos;
+        m_pos += n;
+        return p;
+    }
+
+    template <typename T>
+    T pod() {
+        T v;
+        std::memcpy(&v, bytes(sizeof(T)), sizeof(T));
+        return v;
+    }
+
+    uint8_t u8() { return pod<uint8_t>(); }
+    uint32_t u32() { return pod<uint32_t>(); }
+    uint64_t u64() { return pod<uint64_t>(); }
+
+    // Points into the buffer: valid as long as it is
+    std::string_view string() {
+        const uint32_t n = u32();
+        return std::string_view(reinterpret_cast<const char*>(bytes(n)), n);
+    }
+
+private:
+    [[noreturn]] static void fail() { throw std::runtime_error("[ByteStream] unexpected end of data"); }
+
+    const uint8_t* m_data;
+    size_t m_size;
+    size_t m_pos = 0;
+};
@@ -0,0 +1,121 @@
+#include "Compression.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace Compression {
+
+namespace {
+    constexpr size_t MIN_MATCH = 4;
+    constexpr size_t MAX_OFFSET = 65535;
+    constexpr size_t LAST_LITERALS = 5;     // the block always ends in literals
+    constexpr size_t MATCH_LIMIT = 12;      // no match starts this close to the end
+    constexpr uint32_t HASH_BITS = 16;
+
+    uint32_t read32(const uint8_t* p) {
+        uint32_t v;
+        std::memcpy(&v, p, sizeof(v));
+        return v;
+    }
+
+    uint32_t hash(uint32_t sequence) {
+        return (sequence * 2654435761u) >> (32 - HASH_BITS);
+    }
+
+    void putLength(std::vector<uint8_t>& out, size_t length) {
+        for (; length >= 255; length -= 255) out.push_back(255);
+        out.push_back(static_cast<uint8_t>(length));
+    }
+
+    void putSequence(std::vector<uint8_t>& out, const uint8_t* literals, size_t literalCount,
+                     size_t offset, size_t matchLength) {
+        const size_t matchCode = matchLength ? matchLength - MIN_MATCH : 0;
+        out.push_back(static_cast<uint8_t>((std::min<size_t>(literalCount, 15) << 4) | std::min<size_t>(matchCode, 15)));
+        if (literalCount >= 15) putLength(out, literalCount - 15);
+        out.insert(out.end(), literals, literals + literalCount);
+        if (!matchLength) return;   // last sequence
+        out.push_back(static_cast<uint8_t>(offset & 0xFF));
+        out.push_back(static_cast<uint8_t>(offset >> 8));
+        if (matchCode >= 15) putLength(out, matchCode - 15);
+    }
+
+    // Reads an extra length after a nibble of 15; false if the input ends first
+    bool getLength(const uint8_t* data, size_t size, size_t& pos, size_t& length) {
+        uint8_t b;
+        do {
+            if (pos >= size) return false;
+            b = data[pos++];
+            length += b;
+        } while (b == 255);
+        return true;
+    }
+}
+
+std::vector<uint8_t> compress(const uint8_t* data, size_t size) {
+    std::vector<uint8_t> out;
+    out.reserve(size / 2 + 16);
+
+    size_t anchor = 0;
+    if (size > MATCH_LIMIT) {
+        std::vector<uint32_t> table(size_t(1) << HASH_BITS, 0);
+        const size_t matchLimit = size - MATCH_LIMIT;
+        const size_t matchEnd = size - LAST_LITERALS;
+        size_t pos = 0;
+        while (pos < matchLimit) {
+            const uint32_t sequence = read32(data + pos);
+            uint32_t& slot = table[hash(sequence)];
+            const size_t candidate = slot;
+            slot = static_cast<uint32_t>(pos);
+
+            if (candidate >= pos || pos - candidate > MAX_OFFSET || read32(data + candidate) != sequence) {
+                pos += 1 + ((pos - anchor) >> 6);   // skip faster through data that does not compress
+                continue;
+            }
+
+            size_t length = MIN_MATCH;
+            while (pos + length < matchEnd && data[candidate + length] == data[pos + length]) ++length;
+            putSequence(out, data + anchor, pos - anchor, pos - candidate, length);
+            pos += length;
+            anchor = pos;
+        }
+    }
+    putSequence(out, data + anchor, size - anchor, 0, 0);
+    return out;
+}
+
+bool decompress(const uint8_t* data, size_t size, uint8_t* out, size_t outSize) {
+    size_t in = 0, pos = 0;
+    while (in < size) {
+        const uint8_t token = data[in++];
+
+        size_t literals = token >> 4;
+        if (literals == 15 && !getLength(data, size, in, literals)) return false;
+        if (literals > size - in || literals > outSize - pos) return false;
+        if (literals) std::memcpy(out + pos, data + in, literals);
+        in += literals;
+        pos += literals;
+        if (in == size) break;  // the last sequence has no match
+
+        if (size - in < 2) return false;
+        const size_t offset = data[in] | (size_t(data[in + 1]) << 8);
+        in += 2;
+        if (offset == 0 || offset > pos) return false;
+
+        size_t length = token & 15;
+        if (length == 15 && !getLength(data, size, in, length)) return false;
+        length += MIN_MATCH;
+        if (length > outSize - pos) return false;
+
+        // A match closer than its length overlaps the bytes it produces: copy those one at a time
+        const uint8_t* from = out + pos - offset;
+        if (offset >= length) {
+            std::memcpy(out + pos, from, length);
+        } else {
+            for (size_t i = 0; i < length; ++i) out[pos + i] = from[i];
+        }
+        pos += length;
+    }
+    return pos == outSize;
+}
+
+}
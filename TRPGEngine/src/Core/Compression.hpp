@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Byte-oriented LZ77 in the LZ4 block layout: sequences of a token (literal
+ * and match length nibbles), the literals, a 16-bit back offset and extra
+ * length bytes. It trades ratio for speed; serialized projects, with their
+ * repeated keys and component layouts, still shrink several times over.
+ *
+ * Blocks carry no header; the caller stores the uncompressed size.
+ */
+namespace Compression {
+
+    std::vector<uint8_t> compress(const uint8_t* data, size_t size);
+
+    // `outSize` must be the exact uncompressed size. False if the block is
+    // corrupt or does not decode to exactly `outSize` bytes.
+    bool decompress(const uint8_t* data, size_t size, uint8_t* out, size_t outSize);
+}
@@ -0,0 +1,27 @@
+#include "DurableFile.hpp"
+
+#include <cstdio>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace DurableFile {
+
+bool write(const std::string& path, std::initializer_list<Part> parts, bool append) {
+    std::FILE* f = std::fopen(path.c_str(), append ? "ab" : "wb");
+    if (!f) return false;
+    bool ok = true;
+    for (const Part& part : parts) ok = ok && std::fwrite(part.data, 1, part.size, f) == part.size;
+    ok = ok && std::fflush(f) == 0;
+#ifdef _WIN32
+    ok = ok && _commit(_fileno(f)) == 0;
+#else
+    ok = ok && fsync(fileno(f)) == 0;
+#endif
+    return (std::fclose(f) == 0) && ok;
+}
+
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstddef>
+#include <initializer_list>
+#include <string>
+
+/**
+ * File writes that return once the bytes have reached the disk, so a rename
+ * that publishes a file, or a journal segment counted as saved, cannot
+ * survive a crash that the contents do not.
+ */
+namespace DurableFile {
+
+    struct Part {
+        const void* data;
+        size_t size;
+    };
+
+    // Writes the parts in order to a new (or truncated) file, or appends
+    // them. False if any step fails; the file may then hold part of them.
+    bool write(const std::string& path, std::initializer_list<Part> parts, bool append = false);
+
+    inline bool write(const std::string& path, const void* data, size_t size) {
+        return write(path, { Part{ data, size } });
+    }
+}
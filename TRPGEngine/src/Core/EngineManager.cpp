@@ -1,10 +1,12 @@
 #include "EngineManager.hpp"
+#include "JobSystem.hpp"
 #include "Project/BuildSystem.hpp"
 #include "Project/ProjectManager.hpp"
 #include "Engine/EntitySystem/EntityManager.hpp"
 #include "Engine/EntitySystem/ComponentType.hpp"
 #include "Engine/EntitySystem/Components/ProjectMetaComponent.hpp"
 
+#include <cstdlib>
 #include <iostream>
 
 
@@ -16,9 +18,16 @@ EngineManager& EngineManager::get() {
 void EngineManager::initialize() {
     std::cout << "[EngineManager] Initializing...\n";
 
+    // TRPG_JOB_WORKERS caps the worker pool (0 or unset: hardware_concurrency() - 1)
+    size_t maxWorkers = 0;
+    if (const char* env = std::getenv("TRPG_JOB_WORKERS")) {
+        maxWorkers = static_cast<size_t>(std::strtoul(env, nullptr, 10));
+    }
+    JobSystem::get().initialize(maxWorkers);
+
     // Populate the known component types and their factories/inspectors
     ComponentTypeRegistry::registerBuiltins();
-    std::cout << "[Init] Registered components: " << ComponentTypeRegistry::getAllInfos().size() << "\n";
+    std::cout << "[Init] Registered components: " << ComponentTypeRegistry::getRegisteredTypes().size() << "\n";
 
     // Initialize EntityManager & Project Meta
 
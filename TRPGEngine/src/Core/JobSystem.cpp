@@ -0,0 +1,290 @@
+#include "JobSystem.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <iostream>
+#include <mutex>
+
+struct JobSystem::Job {
+    JobFn fn;
+    std::atomic<uint32_t> pendingDependencies{ 1 };    // +1 held by schedule() until wiring is done
+    std::atomic<bool> finished{ false };
+    std::mutex mutex;                                   // guards dependents/finished hand-off
+    std::vector<std::shared_ptr<Job>> dependents;
+};
+
+struct JobSystem::WorkerQueue {
+    std::mutex mutex;
+    std::deque<std::shared_ptr<Job>> jobs;  // owner uses the back, thieves the front
+};
+
+struct JobSystem::MainThreadNode {
+    std::atomic<MainThreadNode*> next{ nullptr };
+    JobFn fn;
+};
+
+struct JobSystem::Sleep {
+    std::mutex mutex;
+    std::condition_variable cv;
+};
+
+namespace {
+    // Queue index of the current thread: 0 is the injection queue used by
+    // non-worker threads, worker i owns queue i + 1
+    thread_local const JobSystem* t_owner = nullptr;
+    thread_local size_t t_queueIndex = 0;
+
+    constexpr size_t INJECTION_QUEUE = 0;
+}
+
+bool JobSystem::JobHandle::isDone() const {
+    return !m_job || m_job->finished.load(std::memory_order_acquire);
+}
+
+JobSystem& JobSystem::get() {
+    static JobSystem instance;
+    return instance;
+}
+
+JobSystem::JobSystem()
+    : m_mainStub(std::make_unique<MainThreadNode>()),
+      m_sleep(std::make_unique<Sleep>()) {
+    m_mainHead.store(m_mainStub.get());
+    m_mainTail = m_mainStub.get();
+    m_queues.push_back(std::make_unique<WorkerQueue>());
+    initialize();
+}
+
+JobSystem::~JobSystem() {
+    shutdown();
+    while (pumpMainThread(1) != 0) {}
+}
+
+void JobSystem::initialize(size_t maxWorkers) {
+    shutdown();
+
+    const unsigned hw = std::thread::hardware_concurrency();
+    size_t count = hw > 1 ? hw - 1 : 1;     // leave a core for the main thread
+    if (maxWorkers != 0) count = std::min(count, maxWorkers);
+    count = std::max<size_t>(count, 1);
+
+    m_stopping = false;
+    for (size_t i = 0; i < count; ++i) {
+        m_queues.push_back(std::make_unique<WorkerQueue>());
+    }
+    for (size_t i = 0; i < count; ++i) {
+        m_workers.emplace_back([this, i] { workerLoop(i + 1); });
+    }
+    std::cout << "[JobSystem] Started " << count << " worker(s).\n";
+}
+
+void JobSystem::shutdown() {
+    if (m_workers.empty()) return;
+
+    m_stopping = true;
+    {
+        std::lock_guard<std::mutex> lock(m_sleep->mutex);
+    }
+    m_sleep->cv.notify_all();
+    for (auto& worker : m_workers) {
+        worker.join();
+    }
+    m_workers.clear();
+
+    // Finish whatever was still queued so waiters and dependents are released
+    while (runOneJob()) {}
+    m_queues.resize(1);
+}
+
+bool JobSystem::isWorkerThread() const {
+    return t_owner == this && t_queueIndex != INJECTION_QUEUE;
+}
+
+JobSystem::JobHandle JobSystem::schedule(JobFn fn) {
+    return schedule(std::move(fn), {});
+}
+
+JobSystem::JobHandle JobSystem::schedule(JobFn fn, const std::vector<JobHandle>& dependencies) {
+    auto job = std::make_shared<Job>();
+    job->fn = std::move(fn);
+
+    for (const JobHandle& dep : dependencies) {
+        if (!dep.m_job) continue;
+        std::lock_guard<std::mutex> lock(dep.m_job->mutex);
+        if (!dep.m_job->finished.load(std::memory_order_relaxed)) {
+            job->pendingDependencies.fetch_add(1, std::memory_order_relaxed);
+            dep.m_job->dependents.push_back(job);
+        }
+    }
+
+    if (job->pendingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        enqueue(job);
+    }
+    return JobHandle(std::move(job));
+}
+
+void JobSystem::wait(const JobHandle& handle) {
+    while (!handle.isDone()) {
+        if (!runOneJob()) std::this_thread::yield();
+    }
+}
+
+void JobSystem::waitAll(const std::vector<JobHandle>& handles) {
+    for (const JobHandle& handle : handles) {
+        wait(handle);
+    }
+}
+
+void JobSystem::enqueue(std::shared_ptr<Job> job) {
+    const size_t index = (t_owner == this && t_queueIndex < m_queues.size()) ? t_queueIndex : INJECTION_QUEUE;
+    {
+        WorkerQueue& queue = *m_queues[index];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.jobs.push_back(std::move(job));
+    }
+    m_queuedJobs.fetch_add(1, std::memory_order_release);
+
+    // Taking the sleep mutex orders this against a worker that is about to wait
+    {
+        std::lock_guard<std::mutex> lock(m_sleep->mutex);
+    }
+    m_sleep->cv.notify_one();
+}
+
+std::shared_ptr<JobSystem::Job> JobSystem::takeJob(size_t self) {
+    if (m_queuedJobs.load(std::memory_order_acquire) == 0) return nullptr;
+
+    auto take = [this](WorkerQueue& queue, bool fromBack) -> std::shared_ptr<Job> {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.jobs.empty()) return nullptr;
+        std::shared_ptr<Job> job;
+        if (fromBack) {
+            job = std::move(queue.jobs.back());
+            queue.jobs.pop_back();
+        } else {
+            job = std::move(queue.jobs.front());
+            queue.jobs.pop_front();
+        }
+        m_queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+        return job;
+    };
+
+    // Own work first (LIFO keeps it cache-warm), then new external work, then steal
+    if (self != INJECTION_QUEUE) {
+        if (auto job = take(*m_queues[self], true)) return job;
+    }
+    if (auto job = take(*m_queues[INJECTION_QUEUE], false)) return job;
+
+    const size_t count = m_queues.size();
+    for (size_t n = 1; n < count; ++n) {
+        const size_t victim = 1 + (self + n) % (count - 1);
+        if (victim == self) continue;
+        if (auto job = take(*m_queues[victim], false)) return job;
+    }
+    return nullptr;
+}
+
+bool JobSystem::runOneJob() {
+    const size_t self = (t_owner == this) ? t_queueIndex : INJECTION_QUEUE;
+    std::shared_ptr<Job> job = takeJob(self);
+    if (!job) return false;
+    execute(job);
+    return true;
+}
+
+void JobSystem::execute(const std::shared_ptr<Job>& job) {
+    try {
+        if (job->fn) job->fn();
+    } catch (const std::exception& ex) {
+        std::cerr << "[JobSystem] Job threw: " << ex.what() << "\n";
+    } catch (...) {
+        std::cerr << "[JobSystem] Job threw an unknown exception.\n";
+    }
+    job->fn = nullptr;  // release captures now rather than with the last handle
+
+    std::vector<std::shared_ptr<Job>> dependents;
+    {
+        std::lock_guard<std::mutex> lock(job->mutex);
+        job->finished.store(true, std::memory_order_release);
+        dependents.swap(job->dependents);
+    }
+    for (auto& dependent : dependents) {
+        if (dependent->pendingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            enqueue(std::move(dependent));
+        }
+    }
+}
+
+void JobSystem::workerLoop(size_t index) {
+    t_owner = this;
+    t_queueIndex = index;
+
+    while (!m_stopping.load(std::memory_order_acquire)) {
+        if (std::shared_ptr<Job> job = takeJob(index)) {
+            execute(job);
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(m_sleep->mutex);
+        m_sleep->cv.wait_for(lock, std::chrono::milliseconds(10), [this] {
+            return m_stopping.load(std::memory_order_acquire) || m_queuedJobs.load(std::memory_order_acquire) > 0;
+        });
+    }
+}
+
+// --- Main-thread queue (multi-producer, single consumer, lock-free) ---
+
+void JobSystem::runOnMainThread(JobFn fn) {
+    auto* node = new MainThreadNode();
+    node->fn = std::move(fn);
+    MainThreadNode* prev = m_mainHead.exchange(node, std::memory_order_acq_rel);
+    prev->next.store(node, std::memory_order_release);
+}
+
+size_t JobSystem::pumpMainThread(size_t maxJobs) {
+    MainThreadNode* stub = m_mainStub.get();
+
+    // Pops the oldest node, or nullptr if empty or a producer is mid-push
+    auto pop = [&]() -> MainThreadNode* {
+        MainThreadNode* tail = m_mainTail;
+        MainThreadNode* next = tail->next.load(std::memory_order_acquire);
+        if (tail == stub) {
+            if (!next) return nullptr;
+            m_mainTail = next;
+            tail = next;
+            next = next->next.load(std::memory_order_acquire);
+        }
+        if (next) {
+            m_mainTail = next;
+            return tail;
+        }
+        if (tail != m_mainHead.load(std::memory_order_acquire)) return nullptr;
+
+        // tail is the last real node: re-insert the stub behind it so it can be detached
+        stub->next.store(nullptr, std::memory_order_relaxed);
+        MainThreadNode* prev = m_mainHead.exchange(stub, std::memory_order_acq_rel);
+        prev->next.store(stub, std::memory_order_release);
+
+        next = tail->next.load(std::memory_order_acquire);
+        if (next) {
+            m_mainTail = next;
+            return tail;
+        }
+        return nullptr;
+    };
+
+    size_t ran = 0;
+    while (ran < maxJobs) {
+        MainThreadNode* node = pop();
+        if (!node) break;
+        try {
+            if (node->fn) node->fn();
+        } catch (const std::exception& ex) {
+            std::cerr << "[JobSystem] Main-thread job threw: " << ex.what() << "\n";
+        }
+        delete node;
+        ++ran;
+    }
+    return ran;
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+/**
+ * Engine-wide worker pool.
+ *
+ * Every worker owns a deque: it pushes and pops its own jobs at the back while
+ * idle workers steal from the front of the others. Jobs scheduled from
+ * non-worker threads go through a shared injection queue. A job may depend on
+ * other jobs and is queued only once all of them finished.
+ *
+ * Anything that must touch the GL context or ImGui goes through
+ * runOnMainThread(); Application drains that queue once per frame.
+ *
+ *     auto decode = jobs.schedule([&] { pixels = decodeImage(path); });
+ *     jobs.schedule([&] { jobs.runOnMainThread([&] { uploadTexture(pixels); }); }, { decode });
+ *
+ *     jobs.parallelFor(0, files.size(), 8, [&](size_t i) { copy(files[i]); });
+ */
+class JobSystem {
+public:
+    using JobFn = std::function<void()>;
+
+    struct Job;
+
+    class JobHandle {
+    public:
+        JobHandle() = default;
+        bool valid() const { return m_job != nullptr; }
+        bool isDone() const;
+
+    private:
+        friend class JobSystem;
+        explicit JobHandle(std::shared_ptr<Job> job) : m_job(std::move(job)) {}
+        std::shared_ptr<Job> m_job;
+    };
+
+    static JobSystem& get();
+
+    // Starts min(hardware_concurrency() - 1, maxWorkers) workers, at least one.
+    // maxWorkers == 0 means no cap. Safe to call again to resize.
+    void initialize(size_t maxWorkers = 0);
+    void shutdown();
+
+    size_t getWorkerCount() const { return m_workers.size(); }
+    bool isWorkerThread() const;
+
+    JobHandle schedule(JobFn fn);
+    JobHandle schedule(JobFn fn, const std::vector<JobHandle>& dependencies);
+
+    // Blocks until the job finished, running other queued jobs meanwhile
+    void wait(const JobHandle& handle);
+    void waitAll(const std::vector<JobHandle>& handles);
+
+    // Calls fn(i) for every i in [begin, end), `grain` indices per job.
+    // Returns when all are done; the calling thread takes part.
+    template <typename Fn>
+    void parallelFor(size_t begin, size_t end, size_t grain, Fn&& fn);
+
+    // Lock-free, callable from any thread. Jobs run in FIFO order during pumpMainThread().
+    void runOnMainThread(JobFn fn);
+    // Runs up to maxJobs queued main-thread jobs; returns how many ran
+    size_t pumpMainThread(size_t maxJobs = SIZE_MAX);
+
+private:
+    JobSystem();
+    ~JobSystem();
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    struct WorkerQueue;
+    struct MainThreadNode;
+
+    void enqueue(std::shared_ptr<Job> job);
+    std::shared_ptr<Job> takeJob(size_t self);
+    bool runOneJob();
+    void execute(const std::shared_ptr<Job>& job);
+    void workerLoop(size_t index);
+
+    std::vector<std::unique_ptr<WorkerQueue>> m_queues;    // injection queue first, then one per worker
+    std::vector<std::thread> m_workers;
+    std::atomic<bool> m_stopping{ false };
+    std::atomic<size_t> m_queuedJobs{ 0 };
+
+    // Vyukov MPSC queue for main-thread work
+    std::atomic<MainThreadNode*> m_mainHead;
+    MainThreadNode* m_mainTail;
+    std::unique_ptr<MainThreadNode> m_mainStub;
+
+    struct Sleep;
+    std::unique_ptr<Sleep> m_sleep;
+};
+
+template <typename Fn>
+void JobSystem::parallelFor(size_t begin, size_t end, size_t grain, Fn&& fn) {
+    if (begin >= end) return;
+    grain = std::max<size_t>(grain, 1);
+
+    std::vector<JobHandle> handles;
+    handles.reserve((end - begin + grain - 1) / grain);
+    for (size_t chunk = begin; chunk < end; chunk += grain) {
+        const size_t chunkEnd = std::min(end, chunk + grain);
+        handles.push_back(schedule([&fn, chunk, chunkEnd] {
+            for (size_t i = chunk; i < chunkEnd; ++i) fn(i);
+        }));
+    }
+    waitAll(handles);
+}
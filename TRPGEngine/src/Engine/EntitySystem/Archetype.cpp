@@ -0,0 +1,82 @@
+#include "Archetype.hpp"
+#include "ComponentBase.hpp"
+
+Archetype::Archetype(const ComponentMask& mask)
+    : m_mask(mask) {
+    m_columnIndex.fill(-1);
+    m_addEdges.fill(INVALID_ARCHETYPE);
+    m_removeEdges.fill(INVALID_ARCHETYPE);
+
+    for (size_t t = 0; t < COMPONENT_TYPE_COUNT; ++t) {
+        if (!m_mask.test(t)) continue;
+        m_columnIndex[t] = static_cast<int>(m_columns.size());
+        m_columns.emplace_back();
+        m_versions.emplace_back();
+    }
+}
+
+Archetype::Column* Archetype::column(ComponentType t) {
+    int idx = m_columnIndex[static_cast<size_t>(t)];
+    return idx >= 0 ? &m_columns[idx] : nullptr;
+}
+
+const Archetype::Column* Archetype::column(ComponentType t) const {
+    int idx = m_columnIndex[static_cast<size_t>(t)];
+    return idx >= 0 ? &m_columns[idx] : nullptr;
+}
+
+Archetype::VersionColumn* Archetype::versions(ComponentType t) {
+    int idx = m_columnIndex[static_cast<size_t>(t)];
+    return idx >= 0 ? &m_versions[idx] : nullptr;
+}
+
+const Archetype::VersionColumn* Archetype::versions(ComponentType t) const {
+    int idx = m_columnIndex[static_cast<size_t>(t)];
+    return idx >= 0 ? &m_versions[idx] : nullptr;
+}
+
+size_t Archetype::append(Entity e) {
+    m_entities.push_back(e);
+    for (auto& col : m_columns) {
+        col.emplace_back();
+    }
+    for (auto& ver : m_versions) {
+        ver.push_back(0);
+    }
+    return m_entities.size() - 1;
+}
+
+Entity Archetype::swapRemove(size_t row) {
+    const size_t last = m_entities.size() - 1;
+    Entity moved = INVALID_ENTITY;
+
+    if (row != last) {
+        m_entities[row] = m_entities[last];
+        for (auto& col : m_columns) {
+            col[row] = std::move(col[last]);
+        }
+        for (auto& ver : m_versions) {
+            ver[row] = ver[last];
+        }
+        moved = m_entities[row];
+    }
+
+    m_entities.pop_back();
+    for (auto& col : m_columns) {
+        col.pop_back();
+    }
+    for (auto& ver : m_versions) {
+        ver.pop_back();
+    }
+    return moved;
+}
+
+void Archetype::reserve(size_t count) {
+    m_entities.reserve(count);
+    for (auto& col : m_columns) {
+        col.reserve(count);
+    }
+    for (auto& ver : m_versions) {
+        ver.reserve(count);
+    }
+}
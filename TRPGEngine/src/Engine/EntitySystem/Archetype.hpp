@@ -0,0 +1,68 @@
+#pragma once
+
+#include <array>
+#include <bitset>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "Entity.hpp"
+#include "ComponentType.hpp"
+
+class ComponentBase;
+
+// One bit per ComponentType; identifies the component set of an archetype.
+using ComponentMask = std::bitset<COMPONENT_TYPE_COUNT>;
+
+constexpr uint32_t INVALID_ARCHETYPE = UINT32_MAX;
+
+/**
+ * Storage for every entity that has exactly the same set of components.
+ * Each component type present in the mask owns one column; row N of every
+ * column belongs to entities()[N], so iterating a type touches one
+ * contiguous array per archetype instead of a hash map per entity.
+ */
+class Archetype {
+public:
+    using Column = std::vector<std::shared_ptr<ComponentBase>>;
+    using VersionColumn = std::vector<uint64_t>;    // EntityManager version of each row's last write
+
+    explicit Archetype(const ComponentMask& mask);
+
+    const ComponentMask& mask() const { return m_mask; }
+    bool has(ComponentType t) const { return m_mask.test(static_cast<size_t>(t)); }
+
+    size_t size() const { return m_entities.size(); }
+    bool empty() const { return m_entities.empty(); }
+    const std::vector<Entity>& entities() const { return m_entities; }
+
+    // Column for a type contained in mask(); nullptr otherwise
+    Column* column(ComponentType t);
+    const Column* column(ComponentType t) const;
+    VersionColumn* versions(ComponentType t);
+    const VersionColumn* versions(ComponentType t) const;
+
+    // Appends an entity with empty slots in every column and returns its row.
+    size_t append(Entity e);
+
+    // Removes a row by moving the last row into it. Returns the entity that now
+    // occupies `row`, or INVALID_ENTITY if the removed row was the last one.
+    Entity swapRemove(size_t row);
+
+    void reserve(size_t count);
+
+    // Cached archetype transitions (add/remove a single component type)
+    uint32_t addEdge(ComponentType t) const { return m_addEdges[static_cast<size_t>(t)]; }
+    uint32_t removeEdge(ComponentType t) const { return m_removeEdges[static_cast<size_t>(t)]; }
+    void setAddEdge(ComponentType t, uint32_t archetype) { m_addEdges[static_cast<size_t>(t)] = archetype; }
+    void setRemoveEdge(ComponentType t, uint32_t archetype) { m_removeEdges[static_cast<size_t>(t)] = archetype; }
+
+private:
+    ComponentMask m_mask;
+    std::vector<Entity> m_entities;
+    std::vector<Column> m_columns;
+    std::vector<VersionColumn> m_versions;          // parallel to m_columns
+    std::array<int, COMPONENT_TYPE_COUNT> m_columnIndex;
+    std::array<uint32_t, COMPONENT_TYPE_COUNT> m_addEdges;
+    std::array<uint32_t, COMPONENT_TYPE_COUNT> m_removeEdges;
+};
@@ -3,9 +3,19 @@
 #include "Entity.hpp"
 #include "ComponentType.hpp"
 #include <json.hpp>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+class EntityRemap;
 
 class ComponentBase {
 public:
+    ComponentBase() = default;
+    // Copies start out unowned (see EntityManager::forkFrom)
+    ComponentBase(const ComponentBase&) {}
+    ComponentBase& operator=(const ComponentBase&) { return *this; }
     virtual ~ComponentBase() = default;
 
     virtual std::string getID() const = 0;
@@ -14,4 +24,28 @@ public:
 
     virtual void Init(Entity& entity) {}          
     virtual void Update(float deltaTime) {}  
-};
\ No newline at end of file
+
+    // Rewrites saved entity ids to the ids they were loaded as (EntityManager::createBatch)
+    virtual void remapEntities(const EntityRemap& /*remap*/) {}
+
+private:
+    friend class EntityManager;
+    friend class PrefabManager;
+    // Never a manager's tag: instances carrying it are copied before any write
+    static constexpr uint64_t COW_FROZEN = ~uint64_t(0);
+    // Copy-on-write tag of the EntityManager that may write this instance in place; 0 until stored
+    std::atomic<uint64_t> m_cowOwner{ 0 };
+};
+
+// Compile-time id of a component class. Lets typed lookups index archetype
+// columns and registry tables directly and downcast with static_cast.
+template <typename T>
+constexpr ComponentType componentTypeOf() {
+    static_assert(std::is_base_of_v<ComponentBase, T>, "T must derive from ComponentBase");
+    static_assert(T::getStaticType() != ComponentType::Unknown && T::getStaticType() != ComponentType::Count,
+                  "T::getStaticType() must name a concrete ComponentType");
+    return T::getStaticType();
+}
+
+template <typename T>
+constexpr std::size_t componentIndex = static_cast<std::size_t>(componentTypeOf<T>());
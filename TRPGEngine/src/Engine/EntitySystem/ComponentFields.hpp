@@ -0,0 +1,405 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <json.hpp>
+#include <glm.hpp>
+
+#include "ComponentBase.hpp"
+#include "ComponentPool.hpp"
+#include "EntityRefs.hpp"
+#include "EntityRemap.hpp"
+#include "Core/Atom.hpp"
+#include "Core/ByteStream.hpp"
+
+/**
+ * Compile-time field lists. A component (or a plain struct stored in one)
+ * lists its saved fields once:
+ *
+ *   static constexpr auto fields() {
+ *       return std::make_tuple(
+ *           ComponentFields::field("lines", &DialogueComponent::lines),
+ *           ComponentFields::ref("speaker", &DialogueComponent::speaker),
+ *           ComponentFields::target("targetFlowNode", &DialogueComponent::targetFlowNode));
+ *   }
+ *
+ * and gets from it:
+ *  - JSON: toJson() and patch(), which reads the keys present and leaves
+ *    the rest alone, so fromJson() is patch() over a default instance and a
+ *    prefab override is patch() over a copy of the prefab's component;
+ *  - binary: encode()/decode(), straight between the fields and a caller's
+ *    buffer (see ByteWriter);
+ *  - diff(): the JSON of the fields that differ from another instance;
+ *  - encodeState()/decodeState(): the same binary records for an optional
+ *    second list, stateFields(), of what a running game changes (SaveGame);
+ *  - remap(): the entity references rewritten for EntityRemap.
+ *
+ * Entity is a plain integer, so references must use ref()/refs()/target()/
+ * textTarget(): field() would save an id that means nothing after a reload.
+ * Anything not listed (GL handles, caches) is not saved.
+ *
+ * Binary records are {u32 size, u8 field count, fields in list order}: new
+ * fields go at the end of the list, and a reader skips fields it does not
+ * know and leaves missing ones at their defaults.
+ */
+namespace ComponentFields {
+
+    // Codecs: how one kind of value is saved. Value<T> covers plain data.
+    template <typename T, typename = void>
+    struct Value;
+
+    template <typename T>
+    struct Plain {
+        static void remap(const EntityRemap&, T&) {}
+        static bool equal(const T& a, const T& b) { return a == b; }
+    };
+
+    template <>
+    struct Value<bool> : Plain<bool> {
+        static nlohmann::json save(bool v) { return v; }
+        static void load(const nlohmann::json& j, bool& v) { if (j.is_boolean()) v = j.get<bool>(); }
+        static void write(ByteWriter& w, bool v) { w.u8(v ? 1 : 0); }
+        static void read(ByteReader& r, bool& v) { v = r.u8() != 0; }
+    };
+
+    template <typename T>
+    struct Value<T, std::enable_if_t<std::is_arithmetic_v<T> && !std::is_same_v<T, bool>>> : Plain<T> {
+        static nlohmann::json save(T v) { return v; }
+        static void load(const nlohmann::json& j, T& v) {
+            if (std::is_floating_point_v<T> ? j.is_number() : (j.is_number_integer() || j.is_number_unsigned())) v = j.get<T>();
+        }
+        static void write(ByteWriter& w, T v) { w.pod(v); }
+        static void read(ByteReader& r, T& v) { v = r.pod<T>(); }
+    };
+
+    template <typename T>
+    struct Value<T, std::enable_if_t<std::is_enum_v<T>>> : Plain<T> {
+        using Int = std::underlying_type_t<T>;
+        static nlohmann::json save(T v) { return static_cast<Int>(v); }
+        static void load(const nlohmann::json& j, T& v) {
+            if (j.is_number_integer() || j.is_number_unsigned()) v = static_cast<T>(j.get<Int>());
+        }
+        static void write(ByteWriter& w, T v) { w.pod(static_cast<Int>(v)); }
+        static void read(ByteReader& r, T& v) { v = static_cast<T>(r.pod<Int>()); }
+    };
+
+    template <>
+    struct Value<std::string> : Plain<std::string> {
+        static nlohmann::json save(const std::string& v) { return v; }
+        static void load(const nlohmann::json& j, std::string& v) { if (j.is_string()) v = j.get_ref<const std::string&>(); }
+        static void write(ByteWriter& w, const std::string& v) { w.string(v); }
+        static void read(ByteReader& r, std::string& v) { v = r.string(); }
+    };
+
+    template <>
+    struct Value<Atom> : Plain<Atom> {
+        static nlohmann::json save(Atom v) { return v.str(); }
+        static void load(const nlohmann::json& j, Atom& v) { if (j.is_string()) v = Atom(j.get_ref<const std::string&>()); }
+        static void write(ByteWriter& w, Atom v) { w.string(v.str()); }
+        static void read(ByteReader& r, Atom& v) { v = Atom(r.string()); }
+    };
+
+    template <glm::length_t N, glm::qualifier Q>
+    struct Value<glm::vec<N, float, Q>> : Plain<glm::vec<N, float, Q>> {
+        using V = glm::vec<N, float, Q>;
+        static nlohmann::json save(const V& v) {
+            nlohmann::json j = nlohmann::json::array();
+            for (glm::length_t i = 0; i < N; ++i) j.push_back(v[i]);
+            return j;
+        }
+        static void load(const nlohmann::json& j, V& v) {
+            if (!j.is_array() || j.size() != N) return;
+            for (glm::length_t i = 0; i < N; ++i) {
+                if (!j[i].is_number()) return;
+            }
+            for (glm::length_t i = 0; i < N; ++i) v[i] = j[i].get<float>();
+        }
+        static void write(ByteWriter& w, const V& v) { w.pod(v); }
+        static void read(ByteReader& r, V& v) { v = r.pod<V>(); }
+    };
+
+    // Elements that do not load are default-constructed
+    template <typename E>
+    struct Value<std::vector<E>> {
+        using V = std::vector<E>;
+        static nlohmann::json save(const V& v) {
+            nlohmann::json j = nlohmann::json::array();
+            for (const E& e : v) j.push_back(Value<E>::save(e));
+            return j;
+        }
+        static void load(const nlohmann::json& j, V& v) {
+            if (!j.is_array()) return;
+            v.clear();
+            v.reserve(j.size());
+            for (const auto& ej : j) {
+                E e{};
+                Value<E>::load(ej, e);
+                v.push_back(std::move(e));
+            }
+        }
+        static void write(ByteWriter& w, const V& v) {
+            w.u32(static_cast<uint32_t>(v.size()));
+            for (const E& e : v) Value<E>::write(w, e);
+        }
+        static void read(ByteReader& r, V& v) {
+            const uint32_t n = r.u32();
+            v.clear();
+            v.reserve(std::min<size_t>(n, r.remaining()));
+            for (uint32_t i = 0; i < n; ++i) Value<E>::read(r, v.emplace_back());
+        }
+        static void remap(const EntityRemap& remap, V& v) {
+            for (E& e : v) Value<E>::remap(remap, e);
+        }
+        static bool equal(const V& a, const V& b) {
+            if (a.size() != b.size()) return false;
+            for (size_t i = 0; i < a.size(); ++i) {
+                if (!Value<E>::equal(a[i], b[i])) return false;
+            }
+            return true;
+        }
+    };
+
+    // Atom-keyed maps save as JSON objects
+    template <typename M>
+    struct Value<std::unordered_map<Atom, M, AtomHash>> : Plain<std::unordered_map<Atom, M, AtomHash>> {
+        using V = std::unordered_map<Atom, M, AtomHash>;
+        static nlohmann::json save(const V& v) {
+            nlohmann::json j = nlohmann::json::object();
+            for (const auto& [key, value] : v) j[key.str()] = Value<M>::save(value);
+            return j;
+        }
+        static void load(const nlohmann::json& j, V& v) {
+            if (!j.is_object()) return;
+            v.clear();
+            for (auto it = j.begin(); it != j.end(); ++it) Value<M>::load(it.value(), v[Atom(it.key())]);
+        }
+        static void write(ByteWriter& w, const V& v) {
+            w.u32(static_cast<uint32_t>(v.size()));
+            for (const auto& [key, value] : v) {
+                w.string(key.str());
+                Value<M>::write(w, value);
+            }
+        }
+        static void read(ByteReader& r, V& v) {
+            const uint32_t n = r.u32();
+            v.clear();
+            for (uint32_t i = 0; i < n; ++i) {
+                const Atom key(r.string());
+                Value<M>::read(r, v[key]);
+            }
+        }
+    };
+
+    // Entity references: GUIDs in files, ids in memory (see EntityRefs)
+    struct Ref {
+        static nlohmann::json save(Entity e) { return EntityRefs::save(e); }
+        static void load(const nlohmann::json& j, Entity& e) { e = EntityRefs::load(j); }
+        static void write(ByteWriter& w, Entity e) { w.u64(EntityRefs::saveId(e)); }
+        static void read(ByteReader& r, Entity& e) { e = EntityRefs::loadId(r.u64()); }
+        static void remap(const EntityRemap& remap, Entity& e) { remap.apply(e); }
+        static bool equal(Entity a, Entity b) { return a == b; }
+    };
+
+    struct RefList {
+        using V = std::vector<Entity>;
+        static nlohmann::json save(const V& v) { return EntityRefs::saveList(v); }
+        static void load(const nlohmann::json& j, V& v) { if (j.is_array()) v = EntityRefs::loadList(j); }
+        static void write(ByteWriter& w, const V& v) {
+            w.u32(static_cast<uint32_t>(v.size()));
+            for (Entity e : v) Ref::write(w, e);
+        }
+        static void read(ByteReader& r, V& v) {
+            const uint32_t n = r.u32();
+            v.clear();
+            v.reserve(std::min<size_t>(n, r.remaining() / sizeof(uint64_t)));
+            for (uint32_t i = 0; i < n; ++i) Ref::read(r, v.emplace_back());
+        }
+        static void remap(const EntityRemap& remap, V& v) { remap.apply(v); }
+        static bool equal(const V& a, const V& b) { return a == b; }
+    };
+
+    // Link targets: a flow node name or "@Event:<entity>"
+    struct Target {
+        static nlohmann::json save(Atom t) { return EntityRefs::saveTarget(t.str()); }
+        static void load(const nlohmann::json& j, Atom& t) {
+            if (j.is_string()) t = EntityRefs::loadTarget(j.get_ref<const std::string&>());
+        }
+        static void write(ByteWriter& w, Atom t) { w.string(EntityRefs::saveTarget(t.str())); }
+        static void read(ByteReader& r, Atom& t) { t = EntityRefs::loadTarget(r.string()); }
+        static void remap(const EntityRemap& remap, Atom& t) { remap.applyTarget(t); }
+        static bool equal(Atom a, Atom b) { return a == b; }
+    };
+
+    // Text ending in " -> <target>" (choice options, see RenderChoicePanel)
+    struct TextTarget {
+        template <typename Fn>
+        static std::string withTarget(const std::string& text, Fn&& fn) {
+            constexpr std::string_view delim = " -> ";
+            const size_t pos = text.rfind(delim);
+            if (pos == std::string::npos) return text;
+            return text.substr(0, pos + delim.size()) + fn(std::string_view(text).substr(pos + delim.size()));
+        }
+
+        static nlohmann::json save(const std::string& v) { return withTarget(v, EntityRefs::saveTarget); }
+        static void load(const nlohmann::json& j, std::string& v) {
+            if (j.is_string()) v = withTarget(j.get_ref<const std::string&>(), EntityRefs::loadTarget);
+        }
+        static void write(ByteWriter& w, const std::string& v) { w.string(withTarget(v, EntityRefs::saveTarget)); }
+        static void read(ByteReader& r, std::string& v) { v = withTarget(std::string(r.string()), EntityRefs::loadTarget); }
+        static void remap(const EntityRemap& remap, std::string& v) {
+            v = withTarget(v, [&](std::string_view target) {
+                Atom a(target);
+                remap.applyTarget(a);
+                return a.str();
+            });
+        }
+        static bool equal(const std::string& a, const std::string& b) { return a == b; }
+    };
+
+    template <typename C, typename T, typename Codec>
+    struct Field {
+        const char* key;
+        T C::* member;
+    };
+
+    template <typename C, typename T>
+    constexpr Field<C, T, Value<T>> field(const char* key, T C::* member) { return { key, member }; }
+    template <typename C>
+    constexpr Field<C, Entity, Ref> ref(const char* key, Entity C::* member) { return { key, member }; }
+    template <typename C>
+    constexpr Field<C, std::vector<Entity>, RefList> refs(const char* key, std::vector<Entity> C::* member) { return { key, member }; }
+    template <typename C>
+    constexpr Field<C, Atom, Target> target(const char* key, Atom C::* member) { return { key, member }; }
+    template <typename C>
+    constexpr Field<C, std::string, TextTarget> textTarget(const char* key, std::string C::* member) { return { key, member }; }
+
+    template <typename Fields, typename Fn>
+    void forEachIn(const Fields& fields, Fn&& fn) {
+        std::apply([&](const auto&... f) { (fn(f), ...); }, fields);
+    }
+
+    template <typename C, typename Fn>
+    void forEach(Fn&& fn) { forEachIn(C::fields(), fn); }
+
+    template <typename F> struct CodecOf;
+    template <typename C, typename T, typename Codec>
+    struct CodecOf<Field<C, T, Codec>> { using type = Codec; };
+    template <typename F>
+    using Codec = typename CodecOf<std::decay_t<F>>::type;
+
+    template <typename C>
+    nlohmann::json toJson(const C& c) {
+        nlohmann::json j = nlohmann::json::object();
+        forEach<C>([&](const auto& f) { j[f.key] = Codec<decltype(f)>::save(c.*f.member); });
+        return j;
+    }
+
+    // Keys `j` does not have, or has with the wrong type, keep their value
+    template <typename C>
+    void patch(C& c, const nlohmann::json& j) {
+        if (!j.is_object()) return;
+        forEach<C>([&](const auto& f) {
+            if (auto it = j.find(f.key); it != j.end()) Codec<decltype(f)>::load(*it, c.*f.member);
+        });
+    }
+
+    template <typename C>
+    nlohmann::json diff(const C& c, const C& base) {
+        nlohmann::json j = nlohmann::json::object();
+        forEach<C>([&](const auto& f) {
+            using FC = Codec<decltype(f)>;
+            if (!FC::equal(c.*f.member, base.*f.member)) j[f.key] = FC::save(c.*f.member);
+        });
+        return j;
+    }
+
+    template <typename C>
+    void remap(const EntityRemap& remap, C& c) {
+        forEach<C>([&](const auto& f) { Codec<decltype(f)>::remap(remap, c.*f.member); });
+    }
+
+    template <typename C, typename Fields>
+    void encodeFields(ByteWriter& w, const C& c, const Fields& fields) {
+        static_assert(std::tuple_size_v<Fields> <= UINT8_MAX, "too many fields for one record");
+        const size_t sizeAt = w.reserveU32();
+        w.u8(static_cast<uint8_t>(std::tuple_size_v<Fields>));
+        forEachIn(fields, [&](const auto& f) { Codec<decltype(f)>::write(w, c.*f.member); });
+        w.patchU32(sizeAt, static_cast<uint32_t>(w.position() - sizeAt - sizeof(uint32_t)));
+    }
+
+    template <typename C, typename Fields>
+    void decodeFields(ByteReader& r, C& c, const Fields& fields) {
+        const uint32_t size = r.u32();
+        const size_t end = r.position() + size;
+        if (size > r.remaining()) r.bytes(size);    // throws
+        const uint8_t count = r.u8();
+        size_t i = 0;
+        forEachIn(fields, [&](const auto& f) {
+            if (i++ < count) Codec<decltype(f)>::read(r, c.*f.member);
+        });
+        r.seek(end);
+    }
+
+    template <typename C>
+    void encode(ByteWriter& w, const C& c) { encodeFields(w, c, C::fields()); }
+    template <typename C>
+    void decode(ByteReader& r, C& c) { decodeFields(r, c, C::fields()); }
+
+    // stateFields(), for types that have one
+    template <typename C, typename = void>
+    struct HasState : std::false_type {};
+    template <typename C>
+    struct HasState<C, std::void_t<decltype(C::stateFields())>> : std::true_type {};
+
+    template <typename C>
+    void encodeState(ByteWriter& w, const C& c) { encodeFields(w, c, C::stateFields()); }
+    template <typename C>
+    void decodeState(ByteReader& r, C& c) { decodeFields(r, c, C::stateFields()); }
+
+    template <typename C, typename = void>
+    struct HasFields : std::false_type {};
+    template <typename C>
+    struct HasFields<C, std::void_t<decltype(C::fields())>> : std::true_type {};
+
+    // Structs with their own fields() nest as objects / records
+    template <typename S>
+    struct Value<S, std::enable_if_t<HasFields<S>::value>> {
+        static nlohmann::json save(const S& s) { return toJson(s); }
+        static void load(const nlohmann::json& j, S& s) { patch(s, j); }
+        static void write(ByteWriter& w, const S& s) { encode(w, s); }
+        static void read(ByteReader& r, S& s) { decode(r, s); }
+        static void remap(const EntityRemap& remap, S& s) { ComponentFields::remap(remap, s); }
+        static bool equal(const S& a, const S& b) { return diff(a, b).empty(); }
+    };
+}
+
+/**
+ * Base for components described by a fields() list (see ComponentFields):
+ * toJson(), fromJson() and remapEntities() come from the list.
+ */
+template <typename T>
+class ReflectedComponent : public ComponentBase {
+public:
+    nlohmann::json toJson() const override { return ComponentFields::toJson(self()); }
+
+    // Missing keys keep their defaults
+    static std::shared_ptr<T> fromJson(const nlohmann::json& j) {
+        auto c = makeComponent<T>();
+        ComponentFields::patch(*c, j);
+        return c;
+    }
+
+    void remapEntities(const EntityRemap& remap) override { ComponentFields::remap(remap, self()); }
+
+private:
+    const T& self() const { return static_cast<const T&>(*this); }
+    T& self() { return static_cast<T&>(*this); }
+};
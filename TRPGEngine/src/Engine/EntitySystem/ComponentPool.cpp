@@ -0,0 +1,100 @@
+#include "ComponentPool.hpp"
+
+#include <algorithm>
+#include <array>
+#include <new>
+
+namespace {
+    constexpr size_t BLOCK_ALIGN = alignof(std::max_align_t);
+
+    size_t roundToBlock(size_t bytes) {
+        bytes = std::max(bytes, sizeof(void*));
+        return (bytes + BLOCK_ALIGN - 1) & ~(BLOCK_ALIGN - 1);
+    }
+}
+
+ComponentPool& componentPoolFor(ComponentType type) {
+    static std::array<ComponentPool, COMPONENT_TYPE_COUNT> s_pools;
+    return s_pools[static_cast<size_t>(type)];
+}
+
+ComponentPool::~ComponentPool() {
+    // Anything still alive at shutdown (e.g. a shared_ptr held by a static)
+    // keeps pointing into the slabs, so leak them rather than free under it.
+    if (m_live == 0) freeSlabs();
+}
+
+bool ComponentPool::usesPool(size_t bytes, size_t alignment) const {
+    return alignment <= BLOCK_ALIGN && (m_blockSize == 0 || roundToBlock(bytes) == m_blockSize);
+}
+
+void* ComponentPool::allocate(size_t bytes, size_t alignment) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (!usesPool(bytes, alignment)) {
+        return ::operator new(bytes);   // oversized/over-aligned request; not expected for components
+    }
+    if (m_blockSize == 0) m_blockSize = roundToBlock(bytes);
+
+    ++m_live;
+    if (m_freeList) {
+        FreeBlock* block = m_freeList;
+        m_freeList = block->next;
+        return block;
+    }
+    if (m_slabs.empty() || m_bumpNext == m_slabs.back().second) {
+        addSlab();
+    }
+    return m_slabs.back().first + (m_bumpNext++) * m_blockSize;
+}
+
+void ComponentPool::deallocate(void* p, size_t bytes, size_t alignment) noexcept {
+    if (!p) return;
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (!usesPool(bytes, alignment)) {
+        ::operator delete(p);
+        return;
+    }
+    auto* block = static_cast<FreeBlock*>(p);
+    block->next = m_freeList;
+    m_freeList = block;
+    --m_live;
+}
+
+bool ComponentPool::release() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_live != 0) return false;
+    freeSlabs();
+    return true;
+}
+
+size_t ComponentPool::liveCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_live;
+}
+
+size_t ComponentPool::slabCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_slabs.size();
+}
+
+void ComponentPool::addSlab() {
+    // Grow geometrically so big projects settle on a few large slabs
+    const size_t blocks = m_slabs.empty()
+        ? MIN_SLAB_BLOCKS
+        : std::min(m_slabs.back().second * 2, MAX_SLAB_BLOCKS);
+
+    auto* memory = static_cast<std::byte*>(::operator new(blocks * m_blockSize));
+    m_slabs.emplace_back(memory, blocks);
+    m_bumpNext = 0;
+}
+
+void ComponentPool::freeSlabs() noexcept {
+    for (auto& [memory, blocks] : m_slabs) {
+        ::operator delete(memory);
+    }
+    m_slabs.clear();
+    m_freeList = nullptr;
+    m_bumpNext = 0;
+}
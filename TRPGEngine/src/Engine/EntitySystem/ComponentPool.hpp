@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "ComponentBase.hpp"
+
+/**
+ * Slab allocator backing every component of one type. Blocks are carved out
+ * of large slabs and recycled through an intrusive free list, so creating
+ * thousands of components during a project load costs a handful of heap
+ * allocations, and a reload hands whole slabs back at once.
+ *
+ * Components stay std::shared_ptr: makeComponent<T>() uses allocate_shared,
+ * which puts the control block and the object in the same pool block.
+ * Addresses are stable for the lifetime of the component.
+ */
+class ComponentPool {
+public:
+    ComponentPool() = default;
+    ~ComponentPool();
+
+    ComponentPool(const ComponentPool&) = delete;
+    ComponentPool& operator=(const ComponentPool&) = delete;
+
+    void* allocate(size_t bytes, size_t alignment);
+    void deallocate(void* p, size_t bytes, size_t alignment) noexcept;
+
+    // Frees every slab at once. No-op while any block is still handed out.
+    bool release();
+
+    size_t liveCount() const;
+    size_t slabCount() const;
+
+private:
+    struct FreeBlock { FreeBlock* next; };
+
+    static constexpr size_t MIN_SLAB_BLOCKS = 64;
+    static constexpr size_t MAX_SLAB_BLOCKS = 4096;
+
+    bool usesPool(size_t bytes, size_t alignment) const;
+    void addSlab();
+    void freeSlabs() noexcept;
+
+    mutable std::mutex m_mutex;     // components can be released from worker threads
+    size_t m_blockSize = 0;         // fixed by the first allocation
+    std::vector<std::pair<std::byte*, size_t>> m_slabs;    // (memory, block count)
+    FreeBlock* m_freeList = nullptr;
+    size_t m_bumpNext = 0;          // first never-used block in the newest slab
+    size_t m_live = 0;
+};
+
+// Process-wide pool for a component type, shared by every World. Pools are
+// thread-safe, so components can move between worlds (e.g. shared by a fork).
+ComponentPool& componentPoolFor(ComponentType type);
+
+// Minimal std allocator over a ComponentPool, for use with allocate_shared.
+template <typename T>
+class PoolAllocator {
+public:
+    using value_type = T;
+
+    explicit PoolAllocator(ComponentPool* pool) noexcept : m_pool(pool) {}
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U>& other) noexcept : m_pool(other.pool()) {}
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(m_pool->allocate(n * sizeof(T), alignof(T)));
+    }
+    void deallocate(T* p, size_t n) noexcept {
+        m_pool->deallocate(p, n * sizeof(T), alignof(T));
+    }
+
+    ComponentPool* pool() const noexcept { return m_pool; }
+
+    template <typename U>
+    bool operator==(const PoolAllocator<U>& o) const noexcept { return m_pool == o.pool(); }
+    template <typename U>
+    bool operator!=(const PoolAllocator<U>& o) const noexcept { return m_pool != o.pool(); }
+
+private:
+    ComponentPool* m_pool;
+};
+
+// Use instead of std::make_shared for anything derived from ComponentBase.
+template <typename T, typename... Args>
+std::shared_ptr<T> makeComponent(Args&&... args) {
+    return std::allocate_shared<T>(PoolAllocator<T>(&componentPoolFor(componentTypeOf<T>())),
+                                   std::forward<Args>(args)...);
+}
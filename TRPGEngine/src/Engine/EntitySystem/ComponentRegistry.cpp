@@ -1,71 +1,70 @@
 // ComponentRegistry.cpp
 #include "ComponentRegistry.hpp"
 #include "ComponentType.hpp"
+#include "EntityManager.hpp"
 #include <imgui.h>
 #include <iostream>
-#include <algorithm>
 
-using json = nlohmann::json;
-
-std::unordered_map<ComponentType, std::vector<std::shared_ptr<ComponentBase>>> ComponentRegistry::m_components;
-std::unordered_map<ComponentType, ComponentRegistry::InspectorFunc> ComponentRegistry::m_inspectors;
+std::array<ComponentRegistry::InspectorFunc, COMPONENT_TYPE_COUNT> ComponentRegistry::m_inspectors;
 
 ComponentRegistry& ComponentRegistry::get() {
     static ComponentRegistry instance;
     return instance;
 }
 
-void ComponentRegistry::add(const std::shared_ptr<ComponentBase>& component) {
-    m_components[component->getType()].push_back(component);
+std::shared_ptr<ComponentBase> ComponentRegistry::getComponent(const ComponentKey& key) const {
+    return EntityManager::get().getComponent(key.entity, key.type);
 }
 
-std::vector<std::shared_ptr<ComponentBase>> ComponentRegistry::getComponents(ComponentType type) const {
-    auto it = m_components.find(type);
-    if (it != m_components.end()) return it->second;
-    return {};
+std::vector<ComponentSpan> ComponentRegistry::getComponents(ComponentType type) const {
+    std::vector<ComponentSpan> spans;
+    for (const Archetype& arch : EntityManager::get().getArchetypes()) {
+        const Archetype::Column* col = arch.column(type);
+        if (col && !col->empty()) spans.push_back({ col->data(), col->size() });
+    }
+    return spans;
 }
 
-std::shared_ptr<ComponentBase> ComponentRegistry::getComponentByID(ComponentType type, const std::string& id) const {
-    auto it = m_components.find(type);
-    if (it != m_components.end()) {
-        for (const auto& component : it->second) {
-            if (component->getID() == id) return component;
+std::vector<ComponentSpan> ComponentRegistry::getAllComponents() const {
+    std::vector<ComponentSpan> spans;
+    for (const Archetype& arch : EntityManager::get().getArchetypes()) {
+        if (arch.empty()) continue;
+        for (size_t t = 0; t < COMPONENT_TYPE_COUNT; ++t) {
+            if (const Archetype::Column* col = arch.column(static_cast<ComponentType>(t))) {
+                spans.push_back({ col->data(), col->size() });
+            }
         }
     }
-    return nullptr;
+    return spans;
 }
 
-std::vector<std::shared_ptr<ComponentBase>> ComponentRegistry::getAllComponents() const {
-    std::vector<std::shared_ptr<ComponentBase>> all;
-    for (const auto& [_, comps] : m_components) {
-        all.insert(all.end(), comps.begin(), comps.end());
+size_t ComponentRegistry::getComponentCount(ComponentType type) const {
+    size_t count = 0;
+    for (const Archetype& arch : EntityManager::get().getArchetypes()) {
+        if (arch.has(type)) count += arch.size();
     }
-    return all;
-}
-
-std::vector<std::shared_ptr<ComponentBase>>& ComponentRegistry::getMutableComponents(ComponentType type) {
-    return m_components[type];
-}
-
-
-void ComponentRegistry::clear() {
-    m_components.clear();
+    return count;
 }
 
 void ComponentRegistry::registerInspector(ComponentType type, InspectorFunc func) {
-    m_inspectors[type] = std::move(func);
+    const size_t index = static_cast<size_t>(type);
+    if (index >= COMPONENT_TYPE_COUNT) {
+        std::cerr << "[ComponentRegistry] Inspector for out-of-range component type " << index << "\n";
+        return;
+    }
+    m_inspectors[index] = std::move(func);
 }
 
-void ComponentRegistry::renderInspector(ComponentType type, const std::string& id) {
-    auto component = ComponentRegistry::get().getComponentByID(type, id);
+void ComponentRegistry::renderInspector(const ComponentKey& key) {
+    auto component = ComponentRegistry::get().getComponent(key);
     if (!component) {
         ImGui::Text("Component not found.");
         return;
     }
 
-    auto it = m_inspectors.find(type);
-    if (it != m_inspectors.end()) {
-        it->second(component);
+    const size_t index = static_cast<size_t>(key.type);
+    if (index < COMPONENT_TYPE_COUNT && m_inspectors[index]) {
+        m_inspectors[index](component);
     } else {
         ImGui::Text("No inspector registered for this component type.");
     }
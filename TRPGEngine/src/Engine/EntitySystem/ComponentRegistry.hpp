@@ -1,33 +1,64 @@
 // ComponentRegistry.h
 #pragma once
 
-#include <string>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <memory>
-#include <unordered_map>
 #include <vector>
-#include <functional>
-#include <json.hpp>
 
 #include "ComponentBase.hpp"
 #include "ComponentType.hpp"
+#include "Archetype.hpp"
+
+// Identifies one component of the current world. Unlike ComponentBase::getID(),
+// which many components return as a constant, it is unique per entity and type.
+struct ComponentKey {
+    Entity entity = INVALID_ENTITY;
+    ComponentType type = ComponentType::Unknown;
+
+    bool operator==(const ComponentKey& other) const { return entity == other.entity && type == other.type; }
+    bool operator!=(const ComponentKey& other) const { return !(*this == other); }
+};
+
+struct ComponentKeyHash {
+    size_t operator()(const ComponentKey& key) const {
+        return std::hash<uint64_t>()((static_cast<uint64_t>(key.entity) << 8) | static_cast<uint64_t>(key.type));
+    }
+};
 
+// Non-owning view of one archetype column. Valid until the next structural
+// change to the world; read-only, modify through getComponent() instead.
+struct ComponentSpan {
+    const std::shared_ptr<ComponentBase>* data = nullptr;
+    size_t size = 0;
+
+    const std::shared_ptr<ComponentBase>* begin() const { return data; }
+    const std::shared_ptr<ComponentBase>* end() const { return data + size; }
+};
+
+/**
+ * Component lookups and inspectors over the current World's EntityManager.
+ * Lookups go entity record -> archetype column, so they cost the same no
+ * matter how many components a project has, and listing a type returns the
+ * archetype columns themselves rather than copies of every shared_ptr.
+ */
 class ComponentRegistry {
 public:
     static ComponentRegistry& get();
     using InspectorFunc = std::function<void(std::shared_ptr<ComponentBase>)>;
 
-    static void add(const std::shared_ptr<ComponentBase>& component);
-    static void clear();
-
     static void registerInspector(ComponentType type, InspectorFunc func);
-    static void renderInspector(ComponentType type, const std::string& id);
+    static void renderInspector(const ComponentKey& key);
+
+    // nullptr if the entity does not exist or lacks the type
+    std::shared_ptr<ComponentBase> getComponent(const ComponentKey& key) const;
 
-    std::vector<std::shared_ptr<ComponentBase>> getComponents(ComponentType type) const;
-    std::shared_ptr<ComponentBase> getComponentByID(ComponentType type, const std::string& id) const;
-    std::vector<std::shared_ptr<ComponentBase>> getAllComponents() const;
-    std::vector<std::shared_ptr<ComponentBase>>& getMutableComponents(ComponentType type);
+    std::vector<ComponentSpan> getComponents(ComponentType type) const;
+    std::vector<ComponentSpan> getAllComponents() const;
+    size_t getComponentCount(ComponentType type) const;
 
 private:
-    static std::unordered_map<ComponentType, std::vector<std::shared_ptr<ComponentBase>>> m_components;
-    static std::unordered_map<ComponentType, InspectorFunc> m_inspectors;
-};
\ No newline at end of file
+    static std::array<InspectorFunc, COMPONENT_TYPE_COUNT> m_inspectors;
+};
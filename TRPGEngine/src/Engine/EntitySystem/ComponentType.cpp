@@ -1,7 +1,14 @@
 #include "ComponentType.hpp"
 #include "ComponentBase.hpp"
+#include "ComponentFields.hpp"
+#include "Core/Atom.hpp"
 #include "Engine/EntitySystem/EntityManager.tpp"
 
+#include <array>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+
 #include "UI/ComponentPanel/RenderScriptPanel.hpp"
 #include "UI/ComponentPanel/RenderCharacterPanel.hpp"
 #include "UI/ComponentPanel/RenderDialoguePanel.hpp"
@@ -31,111 +38,130 @@ extern void renderTransform2DInspector(const std::shared_ptr<Transform2DComponen
 
 namespace ComponentTypeRegistry {
 
-static std::unordered_map<ComponentType, RegisteredComponent> componentsByType;
-static std::unordered_map<std::string, ComponentType> stringToType;
+static std::array<RegisteredComponent, COMPONENT_TYPE_COUNT> componentsByType;
+static std::vector<ComponentType> registeredTypes;
+static std::unordered_map<Atom, ComponentType, AtomHash> stringToType;
+
+template <typename T>
+static std::shared_ptr<ComponentBase> loadComponent(const nlohmann::json& j) {
+    return T::fromJson(j);
+}
+
+template <typename T>
+static std::shared_ptr<ComponentBase> cloneComponent(const ComponentBase& c) {
+    return makeComponent<T>(static_cast<const T&>(c));
+}
+
+template <typename T>
+static void encodeComponent(const ComponentBase& c, ByteWriter& out) {
+    ComponentFields::encode(out, static_cast<const T&>(c));
+}
+
+template <typename T>
+static std::shared_ptr<ComponentBase> decodeComponent(ByteReader& in) {
+    auto c = makeComponent<T>();
+    ComponentFields::decode(in, *c);
+    return c;
+}
+
+template <typename T>
+static nlohmann::json diffComponent(const ComponentBase& c, const ComponentBase& base) {
+    return ComponentFields::diff(static_cast<const T&>(c), static_cast<const T&>(base));
+}
+
+template <typename T>
+static std::shared_ptr<ComponentBase> patchComponent(const ComponentBase& base, const nlohmann::json& changes) {
+    auto c = makeComponent<T>(static_cast<const T&>(base));
+    ComponentFields::patch(*c, changes);
+    return c;
+}
+
+template <typename T>
+static void encodeComponentState(const ComponentBase& c, ByteWriter& out) {
+    ComponentFields::encodeState(out, static_cast<const T&>(c));
+}
+
+template <typename T>
+static void decodeComponentState(ComponentBase& c, ByteReader& in) {
+    ComponentFields::decodeState(in, static_cast<T&>(c));
+}
+
+// &T::Update names ComponentBase::Update unless T or a base between them declares its own
+template <typename T>
+constexpr bool overridesUpdate = !std::is_same_v<decltype(&T::Update), void (ComponentBase::*)(float)>;
+
+template <typename T, void (*Render)(const std::shared_ptr<T>&)>
+static void renderComponent(const std::shared_ptr<ComponentBase>& base) {
+    Render(std::static_pointer_cast<T>(base));
+}
+
+// One line per component: type id and codecs come from T, the key is what scene files store
+template <typename T, void (*Render)(const std::shared_ptr<T>&) = nullptr>
+static void registerComponent(const std::string& key) {
+    RegisteredComponent& info = componentsByType[componentIndex<T>];
+    info.loader = &loadComponent<T>;
+    info.clone = &cloneComponent<T>;
+    info.encode = &encodeComponent<T>;
+    info.decode = &decodeComponent<T>;
+    info.diff = &diffComponent<T>;
+    info.patch = &patchComponent<T>;
+    if constexpr (ComponentFields::HasState<T>::value) {
+        info.encodeState = &encodeComponentState<T>;
+        info.decodeState = &decodeComponentState<T>;
+    }
+    info.updates = overridesUpdate<T>;
+    info.key = key;
+    if constexpr (Render != nullptr) {
+        info.inspectorRenderer = &renderComponent<T, Render>;
+    }
+    stringToType[key] = componentTypeOf<T>();
+}
 
 void registerBuiltins() {
-    componentsByType.clear();
+    componentsByType.fill(RegisteredComponent{});
+    registeredTypes.clear();
     stringToType.clear();
 
-    auto registerComponent = [](ComponentType type, const std::string& key, LoaderFn loader, InspectorRendererFn renderer = nullptr) {
-        componentsByType[type] = RegisteredComponent{ loader, key, renderer };
-        stringToType[key] = type;
-    };
-
-        registerComponent(ComponentType::ProjectMetadata, "project",
-            [](const nlohmann::json& j) { return ProjectMetaComponent::fromJson(j); }
-            // No inspector function provided
-        );
-
-    registerComponent(ComponentType::Character, "character",
-        [](const nlohmann::json& j) { return CharacterComponent::fromJson(j); },
-        [](std::shared_ptr<ComponentBase> base) {
-            renderCharacterInspector(std::static_pointer_cast<CharacterComponent>(base));
-        });
-
-    registerComponent(ComponentType::Script, "script",
-        [](const nlohmann::json& j) { return ScriptComponent::fromJson(j); },
-        [](std::shared_ptr<ComponentBase> base) {
-            renderScriptInspector(std::static_pointer_cast<ScriptComponent>(base));
-        });
-
-    registerComponent(ComponentType::Dialogue, "dialogue",
-        [](const nlohmann::json& j) { return DialogueComponent::fromJson(j); },
-        [](std::shared_ptr<ComponentBase> base) {
-            renderDialogueInspector(std::static_pointer_cast<DialogueComponent>(base));
-        });
-
-    registerComponent(ComponentType::FlowNode, "flownode",
-        [](const nlohmann::json& j) { return FlowNodeComponent::fromJson(j); },
-        [](std::shared_ptr<ComponentBase> base) {
-            renderFlowNodeInspector(std::static_pointer_cast<FlowNodeComponent>(base));
-        });
-
-    registerComponent(ComponentType::Model, "model",
-        [](const nlohmann::json& j) { return ModelComponent::fromJson(j); },
-        [](std::shared_ptr<ComponentBase> base) {
-            renderModelInspector(std::static_pointer_cast<ModelComponent>(base));
-        });
-
-    registerComponent(ComponentType::Transform, "transform",
-        [](const nlohmann::json& j) { return TransformComponent::fromJson(j); },
-        [](std::shared_ptr<ComponentBase> base) {
-            renderTransform3DInspector(std::static_pointer_cast<TransformComponent>(base));
-        });
-
-    registerComponent(ComponentType::Transform2D, "transform2d",
-        [](const nlohmann::json& j) { return Transform2DComponent::fromJson(j); },
-        [](std::shared_ptr<ComponentBase> base) {
-            renderTransform2DInspector(std::static_pointer_cast<Transform2DComponent>(base));
-        });
-
-    registerComponent(ComponentType::Choice, "choice",
-        [](const nlohmann::json& j) { return ChoiceComponent::fromJson(j); },
-        [](std::shared_ptr<ComponentBase> base) {
-            renderChoiceInspector(std::static_pointer_cast<ChoiceComponent>(base));
-        });
-
-    registerComponent(ComponentType::DiceRoll, "dice",
-        [](const nlohmann::json& j) { return DiceRollComponent::fromJson(j); },
-        [](std::shared_ptr<ComponentBase> base) {
-            renderDiceInspector(std::static_pointer_cast<DiceRollComponent>(base));
-        });
-
-    registerComponent(ComponentType::Background, "background",
-        [](const nlohmann::json& j) { return BackgroundComponent::fromJson(j); },
-        [](std::shared_ptr<ComponentBase> base) {
-            renderBackgroundInspector(std::static_pointer_cast<BackgroundComponent>(base));
-        });
-    registerComponent(
-        ComponentType::UIButton, "ui_button",
-        [](const nlohmann::json& j) { return UIButtonComponent::fromJson(j); },
-        [](std::shared_ptr<ComponentBase> base) {
-            renderUIButtonInspector(std::static_pointer_cast<UIButtonComponent>(base));
-        }
-    );
-}
-
-const ComponentTypeRegistry::RegisteredComponent* ComponentTypeRegistry::getInfo(ComponentType type) {
-    auto it = componentsByType.find(type);
-    return it != componentsByType.end() ? &it->second : nullptr;
-}
-
-const ComponentTypeRegistry::RegisteredComponent* ComponentTypeRegistry::getInfo(int typeInt) {
-    ComponentType type = static_cast<ComponentType>(typeInt);
-    return getInfo(type); 
-}
-
-const std::unordered_map<ComponentType, RegisteredComponent>& getAllInfos() {
-    return componentsByType;
-}
-
-ComponentType ComponentTypeRegistry::getTypeFromString(const std::string& key) {
-    auto it = stringToType.find(key);
+    registerComponent<ProjectMetaComponent>("project");     // No inspector function provided
+    registerComponent<CharacterComponent,   renderCharacterInspector>("character");
+    registerComponent<ScriptComponent,      renderScriptInspector>("script");
+    registerComponent<DialogueComponent,    renderDialogueInspector>("dialogue");
+    registerComponent<FlowNodeComponent,    renderFlowNodeInspector>("flownode");
+    registerComponent<ModelComponent,       renderModelInspector>("model");
+    registerComponent<TransformComponent,   renderTransform3DInspector>("transform");
+    registerComponent<Transform2DComponent, renderTransform2DInspector>("transform2d");
+    registerComponent<ChoiceComponent,      renderChoiceInspector>("choice");
+    registerComponent<DiceRollComponent,    renderDiceInspector>("dice");
+    registerComponent<BackgroundComponent,  renderBackgroundInspector>("background");
+    registerComponent<UIButtonComponent,    renderUIButtonInspector>("ui_button");
+
+    for (size_t i = 0; i < COMPONENT_TYPE_COUNT; ++i) {
+        if (componentsByType[i].loader) registeredTypes.push_back(static_cast<ComponentType>(i));
+    }
+}
+
+const RegisteredComponent* getInfo(ComponentType type) {
+    const size_t idx = static_cast<size_t>(type);
+    if (idx >= COMPONENT_TYPE_COUNT || !componentsByType[idx].loader) return nullptr;
+    return &componentsByType[idx];
+}
+
+const RegisteredComponent* getInfo(int typeInt) {
+    if (typeInt < 0) return nullptr;
+    return getInfo(static_cast<ComponentType>(typeInt));
+}
+
+const std::vector<ComponentType>& getRegisteredTypes() {
+    return registeredTypes;
+}
+
+ComponentType getTypeFromString(std::string_view key) {
+    // find() rather than interning: unknown keys from a bad file stay out of the atom table
+    auto it = stringToType.find(Atom::find(key));
     if (it != stringToType.end()) {
         return it->second;
     } else {
-        throw std::runtime_error("Unknown component type string: " + key);
+        throw std::runtime_error("Unknown component type string: " + std::string(key));
     }
 }
 
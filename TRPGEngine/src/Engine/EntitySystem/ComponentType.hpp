@@ -2,11 +2,14 @@
 
 #include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
-#include <functional>
+#include <cstddef>
 #include <json.hpp>
 
 class ComponentBase;
+class ByteWriter;
+class ByteReader;
 
 enum class ComponentType {
     Unknown = 0,
@@ -22,26 +25,52 @@ enum class ComponentType {
     UIButton,
     DiceRoll,
     Background,
+
+    Count // Keep last
 };
 
+constexpr std::size_t COMPONENT_TYPE_COUNT = static_cast<std::size_t>(ComponentType::Count);
+
 
 namespace ComponentTypeRegistry {
 
-    ComponentType getTypeFromString(const std::string& key);
+    // Throws std::runtime_error for keys no component registered
+    ComponentType getTypeFromString(std::string_view key);
 
-    using LoaderFn = std::function<std::shared_ptr<ComponentBase>(const nlohmann::json&)>;
+    // Plain function pointers; instantiated per component type by registerComponent<T>()
+    using LoaderFn = std::shared_ptr<ComponentBase>(*)(const nlohmann::json&);
     using ExtensionList = std::vector<std::string>;
-    using InspectorRendererFn = std::function<void(std::shared_ptr<ComponentBase>)>;
+    using InspectorRendererFn = void(*)(const std::shared_ptr<ComponentBase>&);
+    using CloneFn = std::shared_ptr<ComponentBase>(*)(const ComponentBase&);
+    using EncodeFn = void(*)(const ComponentBase&, ByteWriter&);
+    using DecodeFn = std::shared_ptr<ComponentBase>(*)(ByteReader&);
+    using DiffFn = nlohmann::json(*)(const ComponentBase& comp, const ComponentBase& base);
+    using PatchFn = std::shared_ptr<ComponentBase>(*)(const ComponentBase& base, const nlohmann::json& changes);
+    using DecodeIntoFn = void(*)(ComponentBase&, ByteReader&);
 
+    // Everything but the key and the inspector comes from the type's
+    // fields() list (see ComponentFields)
     struct RegisteredComponent {
-        LoaderFn loader;
+        LoaderFn loader = nullptr;
         std::string key;
         InspectorRendererFn inspectorRenderer = nullptr;
+        CloneFn clone = nullptr;        // copy-constructs into the type's pool
+        EncodeFn encode = nullptr;      // binary record; decode() throws std::runtime_error on bad data
+        DecodeFn decode = nullptr;
+        DiffFn diff = nullptr;          // JSON of the fields that differ from `base`
+        PatchFn patch = nullptr;        // copy of `base` with the fields in `changes`
+        EncodeFn encodeState = nullptr; // stateFields() records; null for types without play state
+        DecodeIntoFn decodeState = nullptr;
+        bool updates = false;           // overrides ComponentBase::Update (see ComponentUpdateSystem)
     };
 
     void registerBuiltins();
+
+    // Table lookups indexed by ComponentType; nullptr for unregistered types
     const RegisteredComponent* getInfo(ComponentType type);
     const RegisteredComponent* getInfo(int typeInt);
-    const std::unordered_map<ComponentType, RegisteredComponent>& getAllInfos();
+
+    // Registered types in ComponentType order
+    const std::vector<ComponentType>& getRegisteredTypes();
 
 }
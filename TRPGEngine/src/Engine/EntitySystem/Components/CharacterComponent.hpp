@@ -1,38 +1,35 @@
 #pragma once
-#include "Engine/EntitySystem/ComponentBase.hpp"
+#include "Engine/EntitySystem/ComponentFields.hpp"
 #include "Engine/EntitySystem/ComponentType.hpp"
+#include "Core/Atom.hpp"
 #include <string>
 #include <memory>
 #include <json.hpp>
 #include <unordered_map>
 #include <vector>
 
-class CharacterComponent : public ComponentBase {
+class CharacterComponent : public ReflectedComponent<CharacterComponent> {
 public:
-    std::string name;
-    std::unordered_map<std::string, int> stats;
+    Atom name;
+    std::unordered_map<Atom, int, AtomHash> stats;
     std::string iconImage = "Assets/Icons/no_image.png";
-    std::unordered_map<std::string, std::string> stateImages;
+    std::unordered_map<Atom, std::string, AtomHash> stateImages;
 
     std::string getID() const override { return name; }
     ComponentType getType() const override { return ComponentType::Character; }
-    static ComponentType getStaticType() { return ComponentType::Character; }
-    nlohmann::json toJson() const override {
-        return {
-            {"name", name},
-            {"stats", stats},
-            {"icon", iconImage},
-            {"states", stateImages}
-        };
+    static constexpr ComponentType getStaticType() { return ComponentType::Character; }
+
+    static constexpr auto fields() {
+        using namespace ComponentFields;
+        return std::make_tuple(
+            field("name", &CharacterComponent::name),
+            field("stats", &CharacterComponent::stats),
+            field("icon", &CharacterComponent::iconImage),
+            field("states", &CharacterComponent::stateImages));
     }
 
-    static std::shared_ptr<CharacterComponent> fromJson(const nlohmann::json& j) {
-        auto comp = std::make_shared<CharacterComponent>();
-        comp->name = j.value("name", "");
-        comp->stats = j.value("stats", std::unordered_map<std::string, int>{});
-        comp->iconImage = j.value("icon", "Assets/Icons/no_image.png");
-        comp->stateImages = j.value("states", std::unordered_map<std::string, std::string>{});
-        return comp;
+    static constexpr auto stateFields() {
+        return std::make_tuple(ComponentFields::field("stats", &CharacterComponent::stats));
     }
 
-};
\ No newline at end of file
+};
@@ -1,34 +1,29 @@
 #pragma once
-#include "Engine/EntitySystem/ComponentBase.hpp"
+#include "Engine/EntitySystem/ComponentFields.hpp"
 #include "Engine/EntitySystem/ComponentType.hpp"
+#include "Core/Atom.hpp"
 #include <string>
 #include <memory>
 #include <json.hpp>
 
-struct DiceRollComponent : public ComponentBase {
+struct DiceRollComponent : public ReflectedComponent<DiceRollComponent> {
     int sides = 20;          // D20 roll
     int threshold = 10;      // Success if roll >= threshold
-    std::string onSuccess;   // FlowNode to trigger
-    std::string onFailure;
+    Atom onSuccess;          // FlowNode to trigger
+    Atom onFailure;
+    Atom resultVariable;     // story variable the roll is stored in; none if empty
 
     std::string getID() const override { return "dice_roll"; }
     ComponentType getType() const override { return ComponentType::DiceRoll; }
-    static ComponentType getStaticType() { return ComponentType::DiceRoll; }
-    nlohmann::json toJson() const override {
-        return {
-            { "sides", sides },
-            { "threshold", threshold },
-            { "onSuccess", onSuccess },
-            { "onFailure", onFailure }
-        };
-    }
+    static constexpr ComponentType getStaticType() { return ComponentType::DiceRoll; }
 
-    static std::shared_ptr<DiceRollComponent> fromJson(const nlohmann::json& j) {
-        auto comp = std::make_shared<DiceRollComponent>();
-        comp->sides = j.value("sides", 20);
-        comp->threshold = j.value("threshold", 10);
-        comp->onSuccess = j.value("onSuccess", "");
-        comp->onFailure = j.value("onFailure", "");
-        return comp;
+    static constexpr auto fields() {
+        using namespace ComponentFields;
+        return std::make_tuple(
+            field("sides", &DiceRollComponent::sides),
+            field("threshold", &DiceRollComponent::threshold),
+            target("onSuccess", &DiceRollComponent::onSuccess),
+            target("onFailure", &DiceRollComponent::onFailure),
+            field("resultVariable", &DiceRollComponent::resultVariable));
     }
 };
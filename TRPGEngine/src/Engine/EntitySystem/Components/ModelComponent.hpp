@@ -1,6 +1,6 @@
 #pragma once
 
-#include "Engine/EntitySystem/ComponentBase.hpp"
+#include "Engine/EntitySystem/ComponentFields.hpp"
 #include "Engine/EntitySystem/ComponentType.hpp"
 #include <vector>
 
@@ -13,7 +13,7 @@ struct Mesh {
     void draw() const;
 };
 
-class ModelComponent : public ComponentBase {
+class ModelComponent : public ReflectedComponent<ModelComponent> {
 public:
     std::string modelPath;
     std::vector<Mesh> meshes;
@@ -22,33 +22,14 @@ public:
 
     std::string getID() const override { return "model"; }
     ComponentType getType() const override { return ComponentType::Model; }
-    static ComponentType getStaticType() { return ComponentType::Model; }
-
-    nlohmann::json toJson() const override {
-        return {
-            {"modelPath", modelPath },
-            {"meshes", nlohmann::json::array()},
-            {"isLoaded", isLoaded},
-            {"isVisible", isVisible}
-        };
-    }
-
-    static std::shared_ptr<ModelComponent> fromJson(const nlohmann::json& j) {
-        auto model = std::make_shared<ModelComponent>();
-        model->modelPath = j.value("modelPath", "");
-        if (j.contains("meshes") && j["meshes"].is_array()) {
-            for (const auto& meshJson : j["meshes"]) {
-                Mesh mesh;
-                mesh.VAO = meshJson.value("VAO", 0);
-                mesh.VBO = meshJson.value("VBO", 0);
-                mesh.EBO = meshJson.value("EBO", 0);
-                mesh.indexCount = meshJson.value("indexCount", 0);
-                model->meshes.push_back(mesh);
-            }
-        }
-        model->isLoaded = j.value("isLoaded", false);
-        model->isVisible = j.value("isVisible", true);
-        // Load meshes if needed (not implemented here)
-        return model;
+    static constexpr ComponentType getStaticType() { return ComponentType::Model; }
+
+    // Meshes hold GL handles of this run and isLoaded says whether they
+    // exist: neither means anything in a file, so only these are saved
+    static constexpr auto fields() {
+        using namespace ComponentFields;
+        return std::make_tuple(
+            field("modelPath", &ModelComponent::modelPath),
+            field("isVisible", &ModelComponent::isVisible));
     }
 };
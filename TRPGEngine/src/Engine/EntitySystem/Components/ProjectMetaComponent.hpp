@@ -1,5 +1,5 @@
 #pragma once
-#include "Engine/EntitySystem/ComponentBase.hpp"
+#include "Engine/EntitySystem/ComponentFields.hpp"
 #include "Engine/EntitySystem/ComponentType.hpp"
 #include <string>
 #include <vector>
@@ -7,7 +7,7 @@
 #include <json.hpp>
 #include "Engine/EntitySystem/Entity.hpp"
 
-class ProjectMetaComponent : public ComponentBase {
+class ProjectMetaComponent : public ReflectedComponent<ProjectMetaComponent> {
 public:
     std::string projectName = "New TRPG Project";
     std::string version = "1.0.0";
@@ -18,36 +18,17 @@ public:
     std::vector<Entity> sceneNodes;
 
     std::string getID() const override { return projectName; }
-    static ComponentType getStaticType() { return ComponentType::ProjectMetadata; }
+    static constexpr ComponentType getStaticType() { return ComponentType::ProjectMetadata; }
     ComponentType getType() const override { return getStaticType(); }
 
-    nlohmann::json toJson() const override {
-        nlohmann::json j;
-        j["projectName"] = projectName;
-        j["version"] = version;
-        j["author"] = author;
-        j["isActive"] = isActive;
-        j["startNode"] = int(startNode);
-        std::vector<uint32_t> serializedSceneNodes;
-        for (Entity e : sceneNodes) {
-            serializedSceneNodes.push_back(e);
-        }
-        j["sceneNodes"] = serializedSceneNodes;
-
-        return j;
-    }
-
-    static std::shared_ptr<ProjectMetaComponent> fromJson(const nlohmann::json& j) {
-        auto comp = std::make_shared<ProjectMetaComponent>();
-        comp->projectName = j.value("projectName", "Untitled");
-        comp->version = j.value("version", "1.0.0");
-        comp->author = j.value("author", "Unknown");
-        comp->isActive = j.value("isActive", true);
-        comp->startNode = Entity(j.value("startNode", 0));
-        for (auto& id : j.value("sceneNodes", std::vector<uint32_t>{})) {
-            comp->sceneNodes.push_back(static_cast<Entity>(id));
-        }
-
-        return comp;
+    static constexpr auto fields() {
+        using namespace ComponentFields;
+        return std::make_tuple(
+            field("projectName", &ProjectMetaComponent::projectName),
+            field("version", &ProjectMetaComponent::version),
+            field("author", &ProjectMetaComponent::author),
+            field("isActive", &ProjectMetaComponent::isActive),
+            ref("startNode", &ProjectMetaComponent::startNode),
+            refs("sceneNodes", &ProjectMetaComponent::sceneNodes));
     }
-};
\ No newline at end of file
+};
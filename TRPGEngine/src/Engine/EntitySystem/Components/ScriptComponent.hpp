@@ -1,30 +1,23 @@
 #pragma once
-#include "Engine/EntitySystem/ComponentBase.hpp"
+#include "Engine/EntitySystem/ComponentFields.hpp"
 #include "Engine/EntitySystem/ComponentType.hpp"
 
-class ScriptComponent : public ComponentBase {
+class ScriptComponent : public ReflectedComponent<ScriptComponent> {
 public:
     std::string name;
     std::string scriptPath;
 
     std::string getID() const override { return name; }
 
-    nlohmann::json toJson() const override {
-        return {
-            {"name", name},
-            {"path", scriptPath}
-        };
-    }
-
-    static std::shared_ptr<ScriptComponent> fromJson(const nlohmann::json& j) {
-        auto comp = std::make_shared<ScriptComponent>();
-        comp->name = j.value("name", "");
-        comp->scriptPath = j.value("path", "");
-        return comp;
+    static constexpr auto fields() {
+        using namespace ComponentFields;
+        return std::make_tuple(
+            field("name", &ScriptComponent::name),
+            field("path", &ScriptComponent::scriptPath));
     }
 
     ComponentType getType() const override {
         return ComponentType::Script;
     }
-    static ComponentType getStaticType() { return ComponentType::Script; }
+    static constexpr ComponentType getStaticType() { return ComponentType::Script; }
 };
@@ -1,38 +1,33 @@
 #pragma once
-#include "Engine/EntitySystem/ComponentBase.hpp"
+#include "Engine/EntitySystem/ComponentFields.hpp"
 #include "Engine/EntitySystem/ComponentType.hpp"
+#include "Core/Atom.hpp"
 #include <string>
 #include <json.hpp>
 
-class UIButtonComponent : public ComponentBase {
+class UIButtonComponent : public ReflectedComponent<UIButtonComponent> {
 public:
     std::string text = "Button";
     std::string fontPath;
-    std::string targetFlowNode;  // Optional: name or ID of next flow node
+    Atom targetFlowNode;         // Optional: name or ID of next flow node
     std::string imagePath;       // Optional: button background image
     bool triggered = false;
 
-    static ComponentType getStaticType() { return ComponentType::UIButton; }
+    static constexpr ComponentType getStaticType() { return ComponentType::UIButton; }
     ComponentType getType() const override { return getStaticType(); }
     std::string getID() const override { return "ui_button"; }
 
-    nlohmann::json toJson() const override {
-        return {
-            {"text", text},
-            {"fontPath", fontPath},
-            {"targetFlowNode", targetFlowNode},
-            {"imagePath", imagePath},
-            {"triggered", triggered}
-        };
+    static constexpr auto fields() {
+        using namespace ComponentFields;
+        return std::make_tuple(
+            field("text", &UIButtonComponent::text),
+            field("fontPath", &UIButtonComponent::fontPath),
+            target("targetFlowNode", &UIButtonComponent::targetFlowNode),
+            field("imagePath", &UIButtonComponent::imagePath),
+            field("triggered", &UIButtonComponent::triggered));
     }
 
-    static std::shared_ptr<UIButtonComponent> fromJson(const nlohmann::json& j) {
-        auto c = std::make_shared<UIButtonComponent>();
-        c->text = j.value("text", "Button");
-        c->fontPath = j.value("fontPath", "");
-        c->targetFlowNode = j.value("targetFlowNode", "");
-        c->imagePath = j.value("imagePath", "");
-        c->triggered = j.value("triggered", false);
-        return c;
+    static constexpr auto stateFields() {
+        return std::make_tuple(ComponentFields::field("triggered", &UIButtonComponent::triggered));
     }
-};
\ No newline at end of file
+};
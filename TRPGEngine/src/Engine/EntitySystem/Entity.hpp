@@ -3,9 +3,23 @@
 #include <vector> 
 #include <string>      
 
+// 32-bit handle: low 24 bits index a dense slot, high 8 bits are the slot's
+// generation. Generation 0 keeps freshly created ids identical to the plain
+// sequential ids older project files contain.
 using Entity = uint32_t;
 constexpr Entity INVALID_ENTITY = 0;
 
+constexpr uint32_t ENTITY_INDEX_BITS = 24;
+constexpr uint32_t ENTITY_INDEX_MASK = (1u << ENTITY_INDEX_BITS) - 1;
+constexpr uint32_t ENTITY_GENERATION_MASK = 0xFFu;
+constexpr uint32_t ENTITY_MAX_INDEX = ENTITY_INDEX_MASK;
+
+constexpr uint32_t entityIndex(Entity e) { return e & ENTITY_INDEX_MASK; }
+constexpr uint32_t entityGeneration(Entity e) { return (e >> ENTITY_INDEX_BITS) & ENTITY_GENERATION_MASK; }
+constexpr Entity makeEntity(uint32_t index, uint32_t generation) {
+    return ((generation & ENTITY_GENERATION_MASK) << ENTITY_INDEX_BITS) | (index & ENTITY_INDEX_MASK);
+}
+
 enum class EntityType {
     Default,
     ProjectMeta,
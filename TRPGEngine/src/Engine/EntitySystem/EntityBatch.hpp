@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+#include <json.hpp>
+
+class ComponentBase;
+
+// One parsed entity that does not exist yet
+struct StagedEntity {
+    nlohmann::json shell = nlohmann::json::object();    // "_meta", "overrides", "removed"
+    std::vector<std::shared_ptr<ComponentBase>> components;
+    std::vector<uint64_t> refs;                         // GUIDs the components reference (EntityRefs::Staging)
+    uint32_t parent = UINT32_MAX;                       // index in the batch; UINT32_MAX for top-level
+};
+
+/**
+ * Entities parsed from one or more files, waiting for
+ * EntityManager::createBatch(). Staging touches no EntityManager, so
+ * several files can be staged on job threads and then appended together.
+ * Children may come before or after their parent; siblings keep their
+ * relative order.
+ */
+struct EntityBatch {
+    static constexpr uint32_t NO_PARENT = UINT32_MAX;
+
+    std::vector<StagedEntity> entities;
+
+    bool empty() const { return entities.empty(); }
+    size_t size() const { return entities.size(); }
+
+    void append(EntityBatch&& other) {
+        const uint32_t offset = static_cast<uint32_t>(entities.size());
+        entities.reserve(entities.size() + other.entities.size());
+        for (StagedEntity& staged : other.entities) {
+            if (staged.parent != NO_PARENT) staged.parent += offset;
+            entities.push_back(std::move(staged));
+        }
+        other.entities.clear();
+    }
+};
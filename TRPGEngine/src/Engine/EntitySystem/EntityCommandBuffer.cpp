@@ -0,0 +1,124 @@
+#include "EntityCommandBuffer.hpp"
+#include "EntityManager.hpp"
+
+#include <iostream>
+#include <unordered_map>
+
+EntityCommandBuffer::Pending EntityCommandBuffer::createEntity(Target parent) {
+    return createEntities(1, parent);
+}
+
+EntityCommandBuffer::Pending EntityCommandBuffer::createEntities(size_t count, Target parent) {
+    Pending first{ m_pendingCount };
+    m_commands.reserve(m_commands.size() + count);
+    for (size_t i = 0; i < count; ++i) {
+        m_commands.push_back({ Op::Create, Pending{ m_pendingCount++ }, parent });
+    }
+    return first;
+}
+
+void EntityCommandBuffer::destroyEntity(Target e) {
+    m_commands.push_back({ Op::Destroy, e });
+}
+
+void EntityCommandBuffer::addComponent(Target e, std::shared_ptr<ComponentBase> c) {
+    if (!c) {
+        std::cerr << "[EntityCommandBuffer] Null component.\n";
+        return;
+    }
+    Command cmd{ Op::Add, e };
+    cmd.type = c->getType();
+    cmd.component = std::move(c);
+    m_commands.push_back(std::move(cmd));
+}
+
+void EntityCommandBuffer::removeComponent(Target e, ComponentType t) {
+    Command cmd{ Op::Remove, e };
+    cmd.type = t;
+    m_commands.push_back(std::move(cmd));
+}
+
+void EntityCommandBuffer::setParent(Target child, Target parent) {
+    m_commands.push_back({ Op::SetParent, child, parent });
+}
+
+void EntityCommandBuffer::setMeta(Target e, const std::string& name, EntityType type) {
+    Command cmd{ Op::SetMeta, e };
+    cmd.name = name;
+    cmd.entityType = type;
+    m_commands.push_back(std::move(cmd));
+}
+
+void EntityCommandBuffer::clear() {
+    m_commands.clear();
+    m_pendingCount = 0;
+}
+
+std::vector<Entity> EntityCommandBuffer::playback(EntityManager& em) {
+    // Swap out first so commands recorded during playback land in a fresh buffer
+    std::vector<Command> commands;
+    commands.swap(m_commands);
+    const uint32_t pendingCount = m_pendingCount;
+    m_pendingCount = 0;
+
+    std::vector<Entity> created = em.createEntities(pendingCount);
+
+    auto resolve = [&](const Target& t) -> Entity {
+        if (!t.isPending()) return t.entity;
+        return t.pending < created.size() ? created[t.pending] : INVALID_ENTITY;
+    };
+
+    // Size each destination archetype once for the new entities
+    if (pendingCount > 0) {
+        std::vector<ComponentMask> masks(pendingCount);
+        for (const Command& cmd : commands) {
+            if (cmd.op == Op::Add && cmd.target.isPending()) {
+                masks[cmd.target.pending].set(static_cast<size_t>(cmd.type));
+            }
+        }
+        std::unordered_map<ComponentMask, size_t> counts;
+        for (const ComponentMask& mask : masks) {
+            if (mask.any()) ++counts[mask];
+        }
+        for (const auto& [mask, count] : counts) {
+            em.reserveArchetype(mask, count);
+        }
+    }
+
+    for (size_t i = 0; i < commands.size(); ++i) {
+        Command& cmd = commands[i];
+        const Entity e = resolve(cmd.target);
+
+        switch (cmd.op) {
+        case Op::Create: {
+            const Entity parent = resolve(cmd.other);
+            if (e != INVALID_ENTITY && parent != INVALID_ENTITY) em.setEntityParent(e, parent);
+            break;
+        }
+        case Op::Destroy:
+            em.destroyEntity(e);
+            break;
+        case Op::Add: {
+            // Merge the run of adds targeting the same entity into one archetype move
+            std::vector<std::shared_ptr<ComponentBase>> comps;
+            comps.push_back(std::move(cmd.component));
+            while (i + 1 < commands.size() && commands[i + 1].op == Op::Add
+                   && resolve(commands[i + 1].target) == e) {
+                comps.push_back(std::move(commands[++i].component));
+            }
+            em.addComponents(e, std::move(comps));
+            break;
+        }
+        case Op::Remove:
+            em.removeComponent(e, cmd.type);
+            break;
+        case Op::SetParent:
+            em.setEntityParent(e, resolve(cmd.other));
+            break;
+        case Op::SetMeta:
+            em.setEntityMeta(e, cmd.name, cmd.entityType);
+            break;
+        }
+    }
+    return created;
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Entity.hpp"
+#include "ComponentType.hpp"
+#include "ComponentPool.hpp"
+
+class EntityManager;
+
+/**
+ * Records structural changes (create/destroy/add/remove/reparent/meta) so they
+ * can be applied later in one pass, at a point where nobody is iterating
+ * archetypes or holding on to rows.
+ *
+ * Entities created through the buffer are referred to by Pending handles until
+ * playback; every method that takes a Target accepts either one.
+ *
+ *     auto& cmd = em.deferred();
+ *     auto evt = cmd.createEntity(sceneNode);
+ *     cmd.add<DialogueComponent>(evt).lines = { "..." };
+ *     cmd.destroyEntity(oldEvent);
+ *     // ... later, once per frame
+ *     em.flushDeferred();
+ *
+ * Playback allocates all pending entities with one createEntities() call,
+ * pre-sizes their destination archetypes, and merges runs of adds on the same
+ * entity into one addComponents() call, so large batches avoid repeated
+ * archetype moves and vector regrowth.
+ */
+class EntityCommandBuffer {
+public:
+    struct Pending {
+        uint32_t index;     // position in the vector returned by playback()
+    };
+
+    struct Target {
+        Target(Entity e) : entity(e) {}
+        Target(Pending p) : pending(p.index) {}
+
+        bool isPending() const { return pending != NO_PENDING; }
+
+        static constexpr uint32_t NO_PENDING = UINT32_MAX;
+        Entity entity = INVALID_ENTITY;
+        uint32_t pending = NO_PENDING;
+    };
+
+    Pending createEntity(Target parent = INVALID_ENTITY);
+    // Creates `count` entities; they are Pending{ first.index + i }
+    Pending createEntities(size_t count, Target parent = INVALID_ENTITY);
+    void destroyEntity(Target e);
+
+    void addComponent(Target e, std::shared_ptr<ComponentBase> c);
+    template <typename T, typename... Args>
+    T& add(Target e, Args&&... args);
+    void removeComponent(Target e, ComponentType t);
+
+    void setParent(Target child, Target parent);
+    void setMeta(Target e, const std::string& name, EntityType type);
+
+    // Applies every command in recording order and empties the buffer.
+    // Returns the created entities, indexed by Pending::index.
+    std::vector<Entity> playback(EntityManager& em);
+
+    bool empty() const { return m_commands.empty(); }
+    size_t size() const { return m_commands.size(); }
+    void clear();
+
+private:
+    enum class Op : uint8_t {
+        Create,
+        Destroy,
+        Add,
+        Remove,
+        SetParent,
+        SetMeta
+    };
+
+    struct Command {
+        Command(Op op, Target target, Target other = INVALID_ENTITY) : op(op), target(target), other(other) {}
+
+        Op op;
+        Target target;
+        Target other = INVALID_ENTITY;      // parent for Create/SetParent
+        ComponentType type = ComponentType::Unknown;
+        std::shared_ptr<ComponentBase> component;
+        std::string name;
+        EntityType entityType = EntityType::Default;
+    };
+
+    std::vector<Command> m_commands;
+    uint32_t m_pendingCount = 0;
+};
+
+template <typename T, typename... Args>
+T& EntityCommandBuffer::add(Target e, Args&&... args) {
+    auto comp = makeComponent<T>(std::forward<Args>(args)...);
+    T& ref = *comp;
+    addComponent(e, std::move(comp));
+    return ref;
+}
@@ -1,28 +1,179 @@
 #include "EntityManager.hpp"
 #include "Engine/EntitySystem/ComponentRegistry.hpp"
+#include "Engine/EntitySystem/EntityRefs.hpp"
+#include "Engine/EntitySystem/EntityRemap.hpp"
+#include "Engine/EntitySystem/EntityStreamReader.hpp"
+#include "Engine/EntitySystem/PrefabManager.hpp"
+#include "Engine/World.hpp"
+#include "Core/JobSystem.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <random>
+#include <unordered_set>
 
 EntityManager& EntityManager::get() {
-    static EntityManager instance;
-    return instance;
+    return World::current().entities();
+}
+
+EntityManager::EntityManager() {
+    componentPoolFor(ComponentType::Unknown);   // construct the pools first so they outlive this
+    clear();
 }
 
 void EntityManager::clear() {
-    m_entities.clear();
-    m_metadata.clear();
-    m_nextId = 1;
+    resetArchetypes();
+    m_records.assign(1, EntityRecord{});   // slot 0 backs INVALID_ENTITY and is never handed out
+    m_metadata.assign(1, EntityMeta{});
+    m_guidIndex.clear();
+    m_hierarchy.assign(1, HierarchyLinks{});
+    m_freeIndices.clear();
+    m_aliveCount = 0;
+    m_selectedEntity = INVALID_ENTITY;
+    m_deferred.clear();
+    m_changeLog.clear();
+    m_changeLogLimit = CHANGE_LOG_MIN_LIMIT;
+    m_changeLogStart = ++m_version;     // versions keep counting so stale consumers can tell
+    m_writableColumns.set();            // nothing stored, so nothing shared
+
+    // Columns are gone, so unless something outside (or another world) still
+    // holds a component every pool is empty and can drop its slabs wholesale
+    for (size_t t = 0; t < COMPONENT_TYPE_COUNT; ++t) {
+        componentPoolFor(static_cast<ComponentType>(t)).release();
+    }
+}
+
+void EntityManager::resetArchetypes() {
+    m_archetypes.clear();
+    m_archetypeIndex.clear();
+    m_queryCache.clear();
+    findOrCreateArchetype(ComponentMask{});  // index 0: entities without components
+}
+
+uint32_t EntityManager::findOrCreateArchetype(const ComponentMask& mask) {
+    auto it = m_archetypeIndex.find(mask);
+    if (it != m_archetypeIndex.end()) return it->second;
+
+    const uint32_t idx = static_cast<uint32_t>(m_archetypes.size());
+    m_archetypes.emplace_back(mask);
+    m_archetypeIndex.emplace(mask, idx);
+
+    // Keep cached queries current instead of rebuilding them
+    for (auto& [query, matches] : m_queryCache) {
+        if ((mask & query) == query) matches.push_back(idx);
+    }
+    return idx;
+}
+
+const std::vector<uint32_t>& EntityManager::queryArchetypes(const ComponentMask& mask) {
+    auto it = m_queryCache.find(mask);
+    if (it != m_queryCache.end()) return it->second;
+
+    std::vector<uint32_t> matches;
+    for (uint32_t i = 0; i < m_archetypes.size(); ++i) {
+        if ((m_archetypes[i].mask() & mask) == mask) matches.push_back(i);
+    }
+    return m_queryCache.emplace(mask, std::move(matches)).first->second;
+}
+
+uint32_t EntityManager::archetypeWith(uint32_t from, ComponentType t) {
+    uint32_t cached = m_archetypes[from].addEdge(t);
+    if (cached != INVALID_ARCHETYPE) return cached;
+
+    ComponentMask mask = m_archetypes[from].mask();
+    mask.set(static_cast<size_t>(t));
+    const uint32_t to = findOrCreateArchetype(mask);  // may grow m_archetypes
+    m_archetypes[from].setAddEdge(t, to);
+    m_archetypes[to].setRemoveEdge(t, from);
+    return to;
+}
+
+uint32_t EntityManager::archetypeWithout(uint32_t from, ComponentType t) {
+    uint32_t cached = m_archetypes[from].removeEdge(t);
+    if (cached != INVALID_ARCHETYPE) return cached;
+
+    ComponentMask mask = m_archetypes[from].mask();
+    mask.reset(static_cast<size_t>(t));
+    const uint32_t to = findOrCreateArchetype(mask);
+    m_archetypes[from].setRemoveEdge(t, to);
+    m_archetypes[to].setAddEdge(t, from);
+    return to;
+}
+
+// Moves an entity's row into another archetype, carrying over every component
+// both archetypes have in common. Slots for newly added types are left empty.
+void EntityManager::moveEntity(Entity e, EntityRecord& record, uint32_t dst) {
+    Archetype& from = m_archetypes[record.archetype];
+    Archetype& to = m_archetypes[dst];
+
+    const size_t newRow = to.append(e);
+    for (size_t t = 0; t < COMPONENT_TYPE_COUNT; ++t) {
+        const auto type = static_cast<ComponentType>(t);
+        Archetype::Column* src = from.column(type);
+        Archetype::Column* dstCol = to.column(type);
+        if (src && dstCol) {
+            (*dstCol)[newRow] = std::move((*src)[record.row]);
+            (*to.versions(type))[newRow] = (*from.versions(type))[record.row];
+        }
+    }
+
+    detachRow(record);
+    record.archetype = dst;
+    record.row = static_cast<uint32_t>(newRow);
+}
+
+void EntityManager::detachRow(const EntityRecord& record) {
+    Entity moved = m_archetypes[record.archetype].swapRemove(record.row);
+    if (moved != INVALID_ENTITY) {
+        m_records[entityIndex(moved)].row = record.row;
+    }
+}
+
+const EntityManager::EntityRecord* EntityManager::findRecord(Entity e) const {
+    const uint32_t idx = entityIndex(e);
+    if (idx == 0 || idx >= m_records.size()) return nullptr;
+    const EntityRecord& rec = m_records[idx];
+    return (rec.alive && rec.generation == entityGeneration(e)) ? &rec : nullptr;
+}
+
+EntityManager::EntityRecord* EntityManager::findRecord(Entity e) {
+    return const_cast<EntityRecord*>(static_cast<const EntityManager*>(this)->findRecord(e));
 }
 
 Entity EntityManager::createEntity(Entity parent) {
-    Entity id = m_nextId++;
-    m_metadata[id] = {};       // default meta
-    m_entities[id] = {};       // component map for this entity
+    uint32_t idx;
+    if (!m_freeIndices.empty()) {
+        idx = m_freeIndices.front();
+        m_freeIndices.pop_front();
+    } else {
+        if (m_records.size() > ENTITY_MAX_INDEX) {
+            std::cerr << "[EntityManager] Entity limit reached (" << ENTITY_MAX_INDEX << ").\n";
+            return INVALID_ENTITY;
+        }
+        idx = static_cast<uint32_t>(m_records.size());
+        m_records.emplace_back();
+        m_metadata.emplace_back();
+        m_hierarchy.emplace_back();
+    }
+
+    EntityRecord& rec = m_records[idx];
+    const Entity id = makeEntity(idx, rec.generation);
+    rec.alive = true;
+    rec.archetype = 0;
+    rec.row = static_cast<uint32_t>(m_archetypes[0].append(id));
+    m_metadata[idx] = {};       // default meta
+    do {
+        m_metadata[idx].guid = newGuid();
+    } while (!m_guidIndex.insert(m_metadata[idx].guid, idx));
+    m_hierarchy[idx] = {};
+    ++m_aliveCount;
+    recordChange(id, ComponentType::Unknown);
 
     if (parent != INVALID_ENTITY) {
-        if (m_metadata.find(parent) == m_metadata.end()) {
+        if (!entityExists(parent)) {
             std::cerr << "[EntityManager] Parent " << parent << " does not exist.\n";
         } else {
             setEntityParent(id, parent);
@@ -31,18 +182,61 @@ Entity EntityManager::createEntity(Entity parent) {
     return id;
 }
 
+std::vector<Entity> EntityManager::createEntities(size_t count, Entity parent) {
+    std::vector<Entity> entities;
+    entities.reserve(count);
+
+    const size_t fresh = count > m_freeIndices.size() ? count - m_freeIndices.size() : 0;
+    m_records.reserve(m_records.size() + fresh);
+    m_metadata.reserve(m_metadata.size() + fresh);
+    m_hierarchy.reserve(m_hierarchy.size() + fresh);
+    m_archetypes[0].reserve(m_archetypes[0].size() + count);
+
+    for (size_t i = 0; i < count; ++i) {
+        Entity e = createEntity(parent);
+        if (e == INVALID_ENTITY) break;     // limit reached, already reported
+        entities.push_back(e);
+    }
+    return entities;
+}
+
 void EntityManager::destroyEntity(Entity entity) {
-    m_entities.erase(entity);
+    EntityRecord* rec = findRecord(entity);
+    if (!rec) return;
+
+    // Children are owned by their parent (serializeEntity writes them inline).
+    // Only the subtree root needs unlinking; everything below goes with it.
+    std::vector<Entity> subtree;
+    forEachInSubtree(entity, [&](Entity e, int) { subtree.push_back(e); });
+    detachFromParent(entity);
+
+    // Deepest first, so children are released before their parents
+    for (auto it = subtree.rbegin(); it != subtree.rend(); ++it) {
+        const Entity e = *it;
+        const uint32_t idx = entityIndex(e);
+        EntityRecord& r = m_records[idx];
+        detachRow(r);
+        r.alive = false;
+        r.generation = (r.generation + 1) & ENTITY_GENERATION_MASK;
+        m_guidIndex.erase(m_metadata[idx].guid);
+        m_metadata[idx] = {};
+        m_hierarchy[idx] = {};
+        m_freeIndices.push_back(idx);
+        --m_aliveCount;
+        recordChange(e, ComponentType::Unknown);
+
+        if (m_selectedEntity == e) m_selectedEntity = INVALID_ENTITY;
+    }
 }
 
 bool EntityManager::entityExists(Entity e) const {
-    return m_entities.find(e) != m_entities.end();
+    return findRecord(e) != nullptr;
 }
 
 bool EntityManager::hasComponent(Entity e, ComponentType t) const {
-    auto it = m_entities.find(e);
-    if (it == m_entities.end()) return false;
-    return it->second.find(t) != it->second.end();
+    const EntityRecord* rec = findRecord(e);
+    if (!rec) return false;
+    return m_archetypes[rec->archetype].has(t);
 }
 
 EntityManager::AddComponentResult
@@ -51,8 +245,8 @@ EntityManager::addComponent(Entity e, std::shared_ptr<ComponentBase> c) {
         std::cerr << "[EntityManager] Refusing to add to INVALID_ENTITY.\n";
         return AddComponentResult::InvalidEntityId;
     }
-    auto it = m_entities.find(e);
-    if (it == m_entities.end()) {
+    EntityRecord* found = findRecord(e);
+    if (!found) {
         std::cerr << "[EntityManager] Entity " << e << " not found. Did you call createEntity()?\n";
         return AddComponentResult::EntityNotFound;
     }
@@ -62,38 +256,107 @@ EntityManager::addComponent(Entity e, std::shared_ptr<ComponentBase> c) {
     }
 
     const ComponentType t = c->getType();
-    if (it->second.find(t) != it->second.end()) {
+    EntityRecord& rec = *found;
+    if (m_archetypes[rec.archetype].has(t)) {
         std::cerr << "[EntityManager] Entity " << e
                   << " already has component type " << static_cast<int>(t) << ". Skipping.\n";
         return AddComponentResult::AlreadyExists;
     }
 
-    it->second[t] = std::move(c);
+    adoptComponent(*c);
+    moveEntity(e, rec, archetypeWith(rec.archetype, t));
+    (*m_archetypes[rec.archetype].column(t))[rec.row] = std::move(c);
+    recordChange(e, t);
     return AddComponentResult::Ok;
 }
 
+EntityManager::AddComponentResult
+EntityManager::addComponents(Entity e, std::vector<std::shared_ptr<ComponentBase>> comps) {
+    if (e == INVALID_ENTITY) {
+        std::cerr << "[EntityManager] Refusing to add to INVALID_ENTITY.\n";
+        return AddComponentResult::InvalidEntityId;
+    }
+    EntityRecord* found = findRecord(e);
+    if (!found) {
+        std::cerr << "[EntityManager] Entity " << e << " not found. Did you call createEntity()?\n";
+        return AddComponentResult::EntityNotFound;
+    }
+
+    EntityRecord& rec = *found;
+    AddComponentResult result = AddComponentResult::Ok;
+    ComponentMask mask = m_archetypes[rec.archetype].mask();
+    for (auto& c : comps) {
+        if (!c) {
+            std::cerr << "[EntityManager] Null component.\n";
+            result = AddComponentResult::NullComponent;
+            continue;
+        }
+        const size_t t = static_cast<size_t>(c->getType());
+        if (mask.test(t)) {
+            std::cerr << "[EntityManager] Entity " << e
+                      << " already has component type " << t << ". Skipping.\n";
+            result = AddComponentResult::AlreadyExists;
+            c.reset();
+            continue;
+        }
+        mask.set(t);
+    }
+    if (mask == m_archetypes[rec.archetype].mask()) return result;
+
+    moveEntity(e, rec, findOrCreateArchetype(mask));
+    Archetype& arch = m_archetypes[rec.archetype];
+    for (auto& c : comps) {
+        if (!c) continue;
+        const ComponentType t = c->getType();
+        adoptComponent(*c);
+        (*arch.column(t))[rec.row] = std::move(c);
+        recordChange(e, t);
+    }
+    return result;
+}
+
 bool EntityManager::removeComponent(Entity e, ComponentType t) {
-    auto it = m_entities.find(e);
-    if (it == m_entities.end()) return false;
-    return it->second.erase(t) > 0;
+    EntityRecord* found = findRecord(e);
+    if (!found) return false;
+
+    EntityRecord& rec = *found;
+    if (!m_archetypes[rec.archetype].has(t)) return false;
+
+    moveEntity(e, rec, archetypeWithout(rec.archetype, t));
+    recordChange(e, t);
+    return true;
 }
 
 
 std::shared_ptr<ComponentBase> EntityManager::getComponent(Entity entity, ComponentType type) {
-    auto it = m_entities.find(entity);
-    if (it != m_entities.end()) {
-        auto compIt = it->second.find(type);
-        if (compIt != it->second.end()) return compIt->second;
-    }
-    return nullptr;
+    const EntityRecord* rec = findRecord(entity);
+    if (!rec) return nullptr;
+
+    Archetype::Column* col = m_archetypes[rec->archetype].column(type);
+    if (!col) return nullptr;
+    makeWritable((*col)[rec->row], type);
+    return (*col)[rec->row];
+}
+
+std::shared_ptr<const ComponentBase> EntityManager::getComponent(Entity entity, ComponentType type) const {
+    const EntityRecord* rec = findRecord(entity);
+    if (!rec) return nullptr;
+
+    const Archetype::Column* col = m_archetypes[rec->archetype].column(type);
+    return col ? (*col)[rec->row] : nullptr;
 }
 
 std::vector<std::shared_ptr<ComponentBase>> EntityManager::getAllComponents(Entity entity) {
     std::vector<std::shared_ptr<ComponentBase>> result;
-    auto it = m_entities.find(entity);
-    if (it != m_entities.end()) {
-        for (const auto& [type, comp] : it->second) {
-            result.push_back(comp);
+    const EntityRecord* rec = findRecord(entity);
+    if (!rec) return result;
+
+    Archetype& arch = m_archetypes[rec->archetype];
+    for (size_t t = 0; t < COMPONENT_TYPE_COUNT; ++t) {
+        const auto type = static_cast<ComponentType>(t);
+        if (auto* col = arch.column(type)) {
+            makeWritable((*col)[rec->row], type);
+            result.push_back((*col)[rec->row]);
         }
     }
     return result;
@@ -102,59 +365,90 @@ std::vector<std::shared_ptr<ComponentBase>> EntityManager::getAllComponents(Enti
 
 std::vector<Entity> EntityManager::getAllEntities() const {
     std::vector<Entity> entities;
-    for (const auto& [id, _] : m_entities) {
-        entities.push_back(id);
+    entities.reserve(m_aliveCount);
+    for (const auto& arch : m_archetypes) {
+        entities.insert(entities.end(), arch.entities().begin(), arch.entities().end());
     }
     return entities;
 }
 
 std::vector<Entity> EntityManager::getEntitiesWith(ComponentType t) const {
     std::vector<Entity> out;
-    out.reserve(m_entities.size());
-    for (const auto& kv : m_entities) {
-        const Entity e = kv.first;
-        const auto& cmap = kv.second;
-        if (cmap.find(t) != cmap.end()) out.push_back(e);
+    ComponentMask mask;
+    mask.set(static_cast<size_t>(t));
+
+    auto it = m_queryCache.find(mask);
+    if (it != m_queryCache.end()) {
+        for (uint32_t idx : it->second) {
+            const auto& ents = m_archetypes[idx].entities();
+            out.insert(out.end(), ents.begin(), ents.end());
+        }
+        return out;
+    }
+
+    for (const auto& arch : m_archetypes) {
+        if (!arch.has(t) || arch.empty()) continue;
+        out.insert(out.end(), arch.entities().begin(), arch.entities().end());
     }
     return out;
 }
 
 nlohmann::json EntityManager::serializeEntity(Entity e) const {
     nlohmann::json j;
-    if (m_entities.find(e) == m_entities.end()) {
-        std::cerr << "[EntityManager] serializeEntity: entity " << e << " missing from m_entities\n";
+    const EntityRecord* rec = findRecord(e);
+    if (!rec) {
+        std::cerr << "[EntityManager] serializeEntity: entity " << e << " has no storage record\n";
         return j; // or throw, or assert
     }
 
     // Save metadata
     const auto* meta = getMeta(e);
+    const Prefab* prefab = meta ? meta->prefab.get() : nullptr;
     if (meta) {
         j["_meta"] = {
             {"name", meta->name},
             {"type", static_cast<int>(meta->type)},
-            {"parent", meta->parent},
+            {"parent", EntityRefs::save(meta->parent)},
         };
+        if (prefab) j["_meta"]["prefab"] = PrefabManager::get().idForPath(prefab->path);
+        if (meta->guid) j["_meta"]["guid"] = meta->guid;
     }
 
-    // Save components using ComponentTypeRegistry
-    for (const auto& [type, comp] : m_entities.at(e)) {
+    // Save components using ComponentTypeRegistry (stable ComponentType order).
+    // Prefab instances store only the fields that differ from the prefab.
+    const Archetype& arch = m_archetypes[rec->archetype];
+    for (size_t t = 0; t < COMPONENT_TYPE_COUNT; ++t) {
+        const auto type = static_cast<ComponentType>(t);
+        const auto* col = arch.column(type);
+        const int base = prefab ? prefab->find(type) : -1;
+        if (!col) {
+            if (base >= 0) j["removed"].push_back(ComponentTypeRegistry::getInfo(type)->key);
+            continue;
+        }
+        const auto& comp = (*col)[rec->row];
+
         const auto* reg = ComponentTypeRegistry::getInfo(type);
         if (!reg) {
             std::cerr << "[Serialization] Unknown registered component type: " << static_cast<int>(type) << "\n";
             continue;
         }
 
+        if (base >= 0) {
+            if (comp == prefab->components[base]) continue;    // still shared: nothing overridden
+            nlohmann::json diff = reg->diff(*comp, *prefab->components[base]);
+            if (!diff.empty()) j["overrides"][reg->key] = std::move(diff);
+            continue;
+        }
+
         nlohmann::json compJson = comp->toJson();
         compJson["type"] = reg->key;  // Add type string for deserialization
         j["components"].push_back(compJson);
     }
 
     // Save children recursively
-    if (meta && !meta->children.empty()) {
-        for (Entity child : meta->children) {
-            j["children"].push_back(serializeEntity(child));
-        }
-    }
+    forEachChild(e, [&](Entity child) {
+        j["children"].push_back(serializeEntity(child));
+    });
 
     return j;
 }
@@ -162,61 +456,263 @@ nlohmann::json EntityManager::serializeEntity(Entity e) const {
 
 
 Entity EntityManager::deserializeEntity(const nlohmann::json& j) {
-    Entity e = createEntity();
+    EntityBatch batch;
+    stageEntity(j, batch);
+    const std::vector<Entity> roots = createBatch(std::move(batch));
+    return roots.empty() ? INVALID_ENTITY : roots.front();
+}
 
-    // Load metadata
-    if (j.contains("_meta")) {
-        const auto& metaJ = j["_meta"];
-        setEntityMeta(
-            e,
-            metaJ.value("name", "Unnamed"),
-            static_cast<EntityType>(metaJ.value("type", 0))
-        );
+Entity EntityManager::deserializeEntity(std::istream& in, const std::string& sourceName) {
+    EntityBatch batch;
+    if (!EntityStreamReader(batch).read(in, sourceName)) return INVALID_ENTITY;
+    const std::vector<Entity> roots = createBatch(std::move(batch));
+    return roots.empty() ? INVALID_ENTITY : roots.front();
+}
 
-        Entity parent = metaJ.value("parent", INVALID_ENTITY);
-        if (parent != INVALID_ENTITY) setEntityParent(e, parent);
+void EntityManager::stageEntity(const nlohmann::json& j, EntityBatch& out, uint32_t parent) {
+    const uint32_t index = static_cast<uint32_t>(out.entities.size());
+    StagedEntity& staged = out.entities.emplace_back();
+    staged.parent = parent;
+    for (const char* key : { "_meta", "overrides", "removed" }) {
+        if (j.contains(key)) staged.shell[key] = j[key];
     }
-
-    // Load components
     if (j.contains("components")) {
+        EntityRefs::Staging refs(staged.refs);
+        staged.components.reserve(j["components"].size());
         for (const auto& compJ : j["components"]) {
-            if (!compJ.contains("type")) {
-                std::cerr << "[Deserialization] Skipping component with no type field\n";
-                continue;
-            }
+            if (auto comp = loadComponent(compJ)) staged.components.push_back(std::move(comp));
+        }
+    }
+
+    // `staged` is not used past this point: the children may reallocate the batch
+    if (j.contains("children")) {
+        for (const auto& childJ : j["children"]) stageEntity(childJ, out, index);
+    }
+}
+
+std::shared_ptr<ComponentBase> EntityManager::loadComponent(const nlohmann::json& compJ) {
+    if (!compJ.contains("type")) {
+        std::cerr << "[Deserialization] Skipping component with no type field\n";
+        return nullptr;
+    }
 
-            std::string typeStr = compJ["type"].get<std::string>();
+    std::string typeStr = compJ["type"].get<std::string>();
 
-            ComponentType type;
-            try {
-                type = ComponentTypeRegistry::getTypeFromString(typeStr);
-            } catch (const std::exception& ex) {
-                std::cerr << "[Deserialization] " << ex.what() << "\n";
-                continue;
-            }
+    ComponentType type;
+    try {
+        type = ComponentTypeRegistry::getTypeFromString(typeStr);
+    } catch (const std::exception& ex) {
+        std::cerr << "[Deserialization] " << ex.what() << "\n";
+        return nullptr;
+    }
+
+    const auto* reg = ComponentTypeRegistry::getInfo(type);
+    if (!reg || !reg->loader) {
+        std::cerr << "[Deserialization] No loader registered for type: " << typeStr << "\n";
+        return nullptr;
+    }
 
-            const auto* reg = ComponentTypeRegistry::getInfo(type);
-            if (!reg || !reg->loader) {
-                std::cerr << "[Deserialization] No loader registered for type: " << typeStr << "\n";
-                continue;
+    return reg->loader(compJ);
+}
+
+namespace {
+    // Files written before GUID references carry the saved id instead
+    Entity savedId(const nlohmann::json& shell) {
+        auto meta = shell.find("_meta");
+        if (meta == shell.end()) return INVALID_ENTITY;
+        return meta->value("id", INVALID_ENTITY);
+    }
+
+    uint64_t savedGuid(const nlohmann::json& shell) {
+        auto meta = shell.find("_meta");
+        if (meta == shell.end()) return 0;
+        return meta->value("guid", uint64_t(0));
+    }
+}
+
+std::vector<Entity> EntityManager::createBatch(EntityBatch batch) {
+    std::vector<StagedEntity>& staged = batch.entities;
+    const size_t count = staged.size();
+
+    // A GUID (or saved id) seen before means the same entity was saved twice
+    // (BuildSystem writes every entity and its children to their own files): keep the first copy
+    std::vector<uint8_t> duplicate(count, 0);
+    {
+        std::unordered_set<uint64_t> seenGuids;
+        std::unordered_set<Entity> seenIds;
+        for (size_t i = 0; i < count; ++i) {
+            const uint64_t guid = savedGuid(staged[i].shell);
+            const Entity id = savedId(staged[i].shell);
+            if (guid != 0 ? !seenGuids.insert(guid).second : id != INVALID_ENTITY && !seenIds.insert(id).second) {
+                duplicate[i] = 1;
             }
+        }
+    }
 
-            std::shared_ptr<ComponentBase> comp = reg->loader(compJ);
-            addComponent(e, comp);  // assuming this adds the component to entity `e`
+    // Skipped subtrees: children may be staged before their parent, so walk up and memoize
+    enum : uint8_t { Unknown, Keep, Skip };
+    std::vector<uint8_t> state(count, Unknown);
+    std::vector<uint32_t> chain;
+    for (uint32_t i = 0; i < count; ++i) {
+        uint32_t at = i;
+        while (state[at] == Unknown && !duplicate[at] && staged[at].parent != EntityBatch::NO_PARENT) {
+            chain.push_back(at);
+            at = staged[at].parent;
         }
+        if (state[at] == Unknown) state[at] = duplicate[at] ? Skip : Keep;
+        for (uint32_t c : chain) state[c] = state[at];
+        chain.clear();
     }
 
-    // Load children recursively
-    if (j.contains("children")) {
-        for (const auto& childJ : j["children"]) {
-            Entity child = deserializeEntity(childJ);
-            setEntityParent(child, e);
+    std::vector<uint32_t> kept;
+    kept.reserve(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        if (state[i] == Keep) kept.push_back(i);
+    }
+    if (kept.size() < count) {
+        std::cout << "[EntityManager] Skipped " << (count - kept.size()) << " duplicate entities\n";
+    }
+
+    // One allocation pass, then the maps everything below resolves references with.
+    // An entity whose GUID is already taken (the same file loaded twice) keeps a
+    // fresh one, but references within the batch still find it.
+    const std::vector<Entity> created = createEntities(kept.size());
+    std::vector<Entity> ids(count, INVALID_ENTITY);
+    EntityRemap remap(this);
+    for (size_t k = 0; k < created.size(); ++k) {
+        const StagedEntity& s = staged[kept[k]];
+        ids[kept[k]] = created[k];
+        if (const uint64_t guid = savedGuid(s.shell)) {
+            setGuid(created[k], guid);
+            remap.addGuid(guid, created[k]);
         }
+        const Entity saved = savedId(s.shell);
+        if (saved != INVALID_ENTITY) remap.add(saved, created[k]);
     }
 
-    return e;
+    for (uint32_t i : kept) {
+        if (ids[i] == INVALID_ENTITY) continue;     // entity limit, already reported
+        remap.setRefs(&staged[i].refs);
+        for (const auto& comp : staged[i].components) comp->remapEntities(remap);
+        loadStaged(ids[i], staged[i].shell, std::move(staged[i].components), remap);
+    }
+    remap.setRefs(nullptr);
+
+    // Parents in batch order, which keeps siblings in the order they were saved
+    std::vector<Entity> roots;
+    for (uint32_t i : kept) {
+        const Entity e = ids[i];
+        if (e == INVALID_ENTITY) continue;
+        if (staged[i].parent != EntityBatch::NO_PARENT) {
+            if (ids[staged[i].parent] != INVALID_ENTITY) setEntityParent(e, ids[staged[i].parent]);
+            continue;
+        }
+        roots.push_back(e);
+
+        // A top-level entity saved on its own goes back under its parent if that
+        // was loaded with it or is already there (a partial load)
+        const auto meta = staged[i].shell.find("_meta");
+        const uint64_t saved = meta != staged[i].shell.end() ? meta->value("parent", uint64_t(0)) : 0;
+        Entity parent = INVALID_ENTITY;
+        if (saved >= EntityRefs::FIRST_GUID) {
+            parent = remap.resolveGuid(saved);
+        } else if (remap.contains(static_cast<Entity>(saved))) {
+            parent = remap(static_cast<Entity>(saved));
+        }
+        if (parent != INVALID_ENTITY && parent != e) setEntityParent(e, parent);
+    }
+    return roots;
+}
+
+void EntityManager::loadStaged(Entity e, const nlohmann::json& shell, std::vector<std::shared_ptr<ComponentBase>> components,
+                               EntityRemap& remap) {
+    std::vector<std::shared_ptr<ComponentBase>> comps;
+
+    // Load metadata
+    if (shell.contains("_meta")) {
+        const auto& metaJ = shell["_meta"];
+        setEntityMeta(
+            e,
+            metaJ.value("name", "Unnamed"),
+            static_cast<EntityType>(metaJ.value("type", 0))
+        );
+
+        // Prefab instance: share every component without overrides, rebuild the rest
+        if (metaJ.contains("prefab")) {
+            const std::string id = metaJ["prefab"].get<std::string>();
+            if (auto prefab = PrefabManager::get().load(id)) {
+                const nlohmann::json* overrides = shell.contains("overrides") ? &shell["overrides"] : nullptr;
+                const nlohmann::json* removed = shell.contains("removed") ? &shell["removed"] : nullptr;
+                for (size_t i = 0; i < prefab->components.size(); ++i) {
+                    const auto* reg = ComponentTypeRegistry::getInfo(prefab->components[i]->getType());
+                    if (removed && std::find(removed->begin(), removed->end(), reg->key) != removed->end()) continue;
+                    if (overrides && overrides->contains(reg->key)) {
+                        std::vector<uint64_t> refs;
+                        {
+                            EntityRefs::Staging staging(refs);
+                            comps.push_back(reg->patch(*prefab->components[i], (*overrides)[reg->key]));
+                        }
+                        remap.setRefs(&refs);
+                        comps.back()->remapEntities(remap);     // only this entity's copy
+                        remap.setRefs(nullptr);
+                    } else {
+                        comps.push_back(prefab->components[i]);
+                    }
+                }
+                m_metadata[entityIndex(e)].prefab = std::move(prefab);
+            } else {
+                std::cerr << "[Deserialization] Missing prefab " << id << "; loading overrides and extra components only\n";
+            }
+        }
+    }
+
+    // Prefab components first, then the entity's own
+    if (comps.empty()) {
+        comps = std::move(components);
+    } else {
+        comps.reserve(comps.size() + components.size());
+        for (auto& comp : components) comps.push_back(std::move(comp));
+    }
+    if (!comps.empty()) addComponents(e, std::move(comps));    // one archetype move for the whole set
+}
+
+
+namespace {
+    // Turns change logging off for its lifetime
+    struct Unlogged {
+        bool& flag;
+        explicit Unlogged(bool& f) : flag(f) { flag = false; }
+        ~Unlogged() { flag = true; }
+    };
+}
+
+void EntityManager::loadInto(EntityBatch batch, const std::vector<Entity>& targets) {
+    Unlogged unlogged(m_logChanges);
+    EntityRemap remap(this);
+    const size_t count = std::min(batch.entities.size(), targets.size());
+    for (size_t i = 0; i < count; ++i) {
+        const EntityMeta* meta = getMeta(targets[i]);
+        if (!meta) continue;
+        StagedEntity& staged = batch.entities[i];
+        nlohmann::json& metaJ = staged.shell["_meta"];
+        metaJ["name"] = meta->name;
+        metaJ["type"] = static_cast<int>(meta->type);
+
+        remap.setRefs(&staged.refs);
+        for (const auto& comp : staged.components) comp->remapEntities(remap);
+        loadStaged(targets[i], staged.shell, std::move(staged.components), remap);
+    }
+    remap.setRefs(nullptr);
 }
 
+void EntityManager::unload(Entity e) {
+    EntityRecord* rec = findRecord(e);
+    if (!rec) return;
+    Unlogged unlogged(m_logChanges);
+    if (rec->archetype != 0) moveEntity(e, *rec, 0);
+    m_metadata[entityIndex(e)].prefab.reset();
+    recordChange(e, ComponentType::Unknown);
+}
 
 void EntityManager::loadEntitiesFromFolder(const std::string& folderPath) {
     namespace fs = std::filesystem;
@@ -227,41 +723,325 @@ void EntityManager::loadEntitiesFromFolder(const std::string& folderPath) {
         return;
     }
 
+    // Sorted, so which copy of a duplicate wins does not depend on the file system
+    std::vector<fs::path> files;
     for (const auto& entry : fs::directory_iterator(path)) {
-        if (entry.path().extension() == ".entity") {
-            std::ifstream in(entry.path());
-            if (in.is_open()) {
-                nlohmann::json j;
-                in >> j;
-                deserializeEntity(j);
-                std::cout << "[EntityManager] Loaded entity: " << entry.path().filename() << "\n";
-            } else {
-                std::cerr << "[EntityManager] Failed to open file: " << entry.path() << "\n";
-            }
+        if (entry.path().extension() == ".entity") files.push_back(entry.path());
+    }
+    std::sort(files.begin(), files.end());
+
+    // Parsing and component loading touch no EntityManager: one job per file
+    std::vector<EntityBatch> staged(files.size());
+    std::vector<uint8_t> ok(files.size(), 0);
+    JobSystem::get().parallelFor(0, files.size(), 1, [&](size_t i) {
+        std::ifstream in(files[i]);
+        if (!in.is_open()) return;
+        ok[i] = EntityStreamReader(staged[i]).read(in, files[i].string()) ? 1 : 0;
+    });
+
+    EntityBatch batch;
+    size_t loaded = 0;
+    for (size_t i = 0; i < files.size(); ++i) {
+        if (!ok[i]) {
+            std::cerr << "[EntityManager] Failed to load file: " << files[i] << "\n";
+            continue;
         }
+        batch.append(std::move(staged[i]));
+        ++loaded;
     }
+    createBatch(std::move(batch));
+    std::cout << "[EntityManager] Loaded " << loaded << " entity files from " << folderPath << "\n";
 }
 
 void EntityManager::setEntityMeta(Entity e, const std::string& name, EntityType type) {
-    m_metadata[e] = EntityMeta{name, type};
+    if (EntityMeta* meta = getMeta(e)) {
+        meta->name = name;
+        meta->type = type;
+        recordChange(e, ComponentType::Unknown);
+    }
+}
+
+
+Entity EntityManager::instantiatePrefab(const std::shared_ptr<const Prefab>& prefab, Entity parent) {
+    if (!prefab) return INVALID_ENTITY;
+    Entity e = createEntity(parent);
+    setEntityMeta(e, prefab->name, prefab->type);
+    m_metadata[entityIndex(e)].prefab = prefab;
+    addComponents(e, prefab->components);      // shared; copied on first write
+    return e;
 }
 
+void EntityManager::linkPrefab(Entity e, const std::shared_ptr<const Prefab>& prefab) {
+    EntityRecord* rec = findRecord(e);
+    if (!rec || !prefab) return;
+
+    std::vector<std::shared_ptr<ComponentBase>> missing;
+    for (const auto& comp : prefab->components) {
+        const ComponentType t = comp->getType();
+        if (Archetype::Column* col = m_archetypes[rec->archetype].column(t)) {
+            adoptComponent(*comp);
+            (*col)[rec->row] = comp;
+            recordChange(e, t);
+        } else {
+            missing.push_back(comp);
+        }
+    }
+    if (!missing.empty()) addComponents(e, std::move(missing));
+    m_metadata[entityIndex(e)].prefab = prefab;
+    recordChange(e, ComponentType::Unknown);
+}
 
 void EntityManager::setEntityName(Entity e, const std::string& name) {
-    m_metadata[e].name = name;
+    if (EntityMeta* meta = getMeta(e)) {
+        meta->name = name;
+        recordChange(e, ComponentType::Unknown);
+    }
 }
 
 void EntityManager::setEntityType(Entity e, EntityType type) {
-    m_metadata[e].type = type;
+    if (EntityMeta* meta = getMeta(e)) {
+        meta->type = type;
+        recordChange(e, ComponentType::Unknown);
+    }
 }
 
 void EntityManager::setEntityParent(Entity child, Entity parent) {
-    m_metadata[child].parent = parent;
-    m_metadata[parent].children.push_back(child);
+    if (!entityExists(child)) return;
+    if (parent != INVALID_ENTITY && !entityExists(parent)) {
+        std::cerr << "[EntityManager] setEntityParent: parent " << parent << " does not exist.\n";
+        return;
+    }
+
+    if (parent == child || isAncestorOf(child, parent)) {
+        std::cerr << "[EntityManager] setEntityParent: " << parent << " is " << child << " or one of its descendants.\n";
+        return;
+    }
+
+    detachFromParent(child);
+    if (parent == INVALID_ENTITY) {
+        recordChange(child, ComponentType::Unknown);
+        return;
+    }
+
+    // Append, so children keep their insertion order
+    const uint32_t childIdx = entityIndex(child);
+    const uint32_t parentIdx = entityIndex(parent);
+    HierarchyLinks& node = m_hierarchy[childIdx];
+    HierarchyLinks& parentNode = m_hierarchy[parentIdx];
+    node.parent = parentIdx;
+    node.prevSibling = parentNode.lastChild;
+    node.nextSibling = 0;
+    if (parentNode.lastChild != 0) {
+        m_hierarchy[parentNode.lastChild].nextSibling = childIdx;
+    } else {
+        parentNode.firstChild = childIdx;
+    }
+    parentNode.lastChild = childIdx;
+    ++parentNode.childCount;
+    m_metadata[childIdx].parent = parent;
+
+    recordChange(parent, ComponentType::Unknown);
+    recordChange(child, ComponentType::Unknown);
+}
+
+void EntityManager::detachFromParent(Entity child) {
+    const uint32_t childIdx = entityIndex(child);
+    HierarchyLinks& node = m_hierarchy[childIdx];
+    if (node.parent != 0) {
+        HierarchyLinks& parentNode = m_hierarchy[node.parent];
+        if (node.prevSibling != 0) m_hierarchy[node.prevSibling].nextSibling = node.nextSibling;
+        else parentNode.firstChild = node.nextSibling;
+        if (node.nextSibling != 0) m_hierarchy[node.nextSibling].prevSibling = node.prevSibling;
+        else parentNode.lastChild = node.prevSibling;
+        --parentNode.childCount;
+        recordChange(entityAt(node.parent), ComponentType::Unknown);
+    }
+    node.parent = node.prevSibling = node.nextSibling = 0;
+    m_metadata[childIdx].parent = INVALID_ENTITY;
+}
+
+void EntityManager::reserveArchetype(const ComponentMask& mask, size_t count) {
+    Archetype& arch = m_archetypes[findOrCreateArchetype(mask)];
+    arch.reserve(arch.size() + count);
+}
+
+void EntityManager::flushDeferred() {
+    if (!m_deferred.empty()) m_deferred.playback(*this);
+}
+
+// Persistent GUIDs
+uint64_t EntityManager::newGuid() {
+    // splitmix64 over a per-process random start: distinct within a run,
+    // and runs do not repeat each other's sequence
+    static const uint64_t s_seed = (uint64_t(std::random_device{}()) << 32) ^ std::random_device{}();
+    static std::atomic<uint64_t> s_counter{ 0 };
+    for (;;) {
+        uint64_t z = s_seed + s_counter.fetch_add(1, std::memory_order_relaxed) * 0x9E3779B97F4A7C15ull;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        z ^= z >> 31;
+        if (z >> 32) return z;
+    }
+}
+
+uint64_t EntityManager::getGuid(Entity e) const {
+    const EntityRecord* rec = findRecord(e);
+    return rec ? m_metadata[entityIndex(e)].guid : 0;
+}
+
+Entity EntityManager::findByGuid(uint64_t guid) const {
+    const uint32_t idx = m_guidIndex.find(guid);
+    return idx ? makeEntity(idx, m_records[idx].generation) : INVALID_ENTITY;
+}
+
+bool EntityManager::setGuid(Entity e, uint64_t guid) {
+    if (!findRecord(e)) return false;
+    const uint32_t idx = entityIndex(e);
+    if (m_metadata[idx].guid == guid) return true;
+    if (!m_guidIndex.insert(guid, idx)) return false;
+    m_guidIndex.erase(m_metadata[idx].guid);
+    m_metadata[idx].guid = guid;
+    return true;
+}
+
+// Copy-on-write
+uint64_t EntityManager::nextCowTag() {
+    static std::atomic<uint64_t> s_next{ 1 };
+    return s_next.fetch_add(1, std::memory_order_relaxed);
+}
+
+void EntityManager::forkFrom(EntityManager& source) {
+    if (&source == this) return;
+
+    m_selectedEntity = source.m_selectedEntity;
+    m_archetypes = source.m_archetypes;         // columns copy shared_ptrs, not components
+    m_archetypeIndex = source.m_archetypeIndex;
+    m_queryCache = source.m_queryCache;
+    m_records = source.m_records;
+    m_metadata = source.m_metadata;
+    m_guidIndex = source.m_guidIndex;
+    m_hierarchy = source.m_hierarchy;
+    m_freeIndices = source.m_freeIndices;
+    m_aliveCount = source.m_aliveCount;
+    m_version = source.m_version;
+    m_changeLogStart = source.m_changeLogStart;
+    m_changeLog = source.m_changeLog;
+    m_changeLogLimit = source.m_changeLogLimit;
+    m_deferred.clear();
+
+    // Every instance now has two holders; neither side may keep writing in place
+    m_cowTag = nextCowTag();
+    source.m_cowTag = nextCowTag();
+    m_writableColumns.reset();
+    source.m_writableColumns.reset();
+}
+
+void EntityManager::ensureWritable(const ComponentMask& types) {
+    const ComponentMask pending = types & ~m_writableColumns;
+    if (pending.none()) return;
+
+    for (Archetype& arch : m_archetypes) {
+        const ComponentMask present = arch.mask() & pending;
+        if (present.none()) continue;
+        for (size_t t = 0; t < COMPONENT_TYPE_COUNT; ++t) {
+            if (!present.test(t)) continue;
+            const auto type = static_cast<ComponentType>(t);
+            for (auto& slot : *arch.column(type)) {
+                makeWritable(slot, type);
+            }
+        }
+    }
+    m_writableColumns |= pending;
+}
+
+// Clones the slot's component if another holder may still see it, then
+// claims it. A component only this manager still references is claimed
+// without copying, so dropping a fork costs the other side nothing.
+void EntityManager::makeWritable(std::shared_ptr<ComponentBase>& slot, ComponentType t) {
+    if (m_writableColumns.test(static_cast<size_t>(t)) || !slot) return;
+    if (slot->m_cowOwner.load(std::memory_order_relaxed) == m_cowTag) return;
+
+    if (slot.use_count() > 1) {
+        const auto* info = ComponentTypeRegistry::getInfo(t);
+        if (info && info->clone) {
+            slot = info->clone(*slot);
+        } else {
+            std::cerr << "[EntityManager] No clone function for component type " << static_cast<int>(t)
+                      << "; writing a shared instance in place.\n";
+        }
+    }
+    slot->m_cowOwner.store(m_cowTag, std::memory_order_relaxed);
+}
+
+// Fresh components become ours; one already stored elsewhere stays shared
+void EntityManager::adoptComponent(ComponentBase& c) {
+    uint64_t expected = 0;
+    if (!c.m_cowOwner.compare_exchange_strong(expected, m_cowTag, std::memory_order_relaxed)
+        && expected != m_cowTag) {
+        m_writableColumns.reset(static_cast<size_t>(c.getType()));
+    }
+}
+
+// Change tracking
+uint64_t EntityManager::markDirty(Entity e, ComponentType t) {
+    if (!hasComponent(e, t)) return m_version;
+    return recordChange(e, t);
+}
+
+uint64_t EntityManager::getEntityVersion(Entity e) const {
+    const EntityRecord* rec = findRecord(e);
+    return rec ? rec->version : 0;
+}
+
+uint64_t EntityManager::getComponentVersion(Entity e, ComponentType t) const {
+    const EntityRecord* rec = findRecord(e);
+    if (!rec) return 0;
+    const Archetype::VersionColumn* ver = m_archetypes[rec->archetype].versions(t);
+    return ver ? (*ver)[rec->row] : 0;
+}
+
+std::vector<Entity> EntityManager::getEntitiesChangedSince(uint64_t version) const {
+    std::vector<Entity> result;
+    std::unordered_set<Entity> seen;
+    forEachChangeSince(version, [&](const ComponentChange& c) {
+        if (seen.insert(c.entity).second) result.push_back(c.entity);
+    });
+    return result;
+}
+
+uint64_t EntityManager::recordChange(Entity e, ComponentType t) {
+    const uint64_t version = ++m_version;
+    if (EntityRecord* rec = findRecord(e)) {
+        rec->version = version;
+        if (Archetype::VersionColumn* ver = m_archetypes[rec->archetype].versions(t)) {
+            (*ver)[rec->row] = version;
+        }
+    }
+
+    if (!m_logChanges) return version;
+    m_changeLog.push_back({ version, e, t });
+    if (m_changeLog.size() > m_changeLogLimit) {
+        compactChangeLog();
+        m_changeLogLimit = std::max({ CHANGE_LOG_MIN_LIMIT, m_aliveCount * 4, m_changeLog.size() * 2 });
+    }
+    return version;
+}
+
+// Drops entries superseded by a later change to the same (entity, type).
+// Keeps ordering, so forEachChangeSince still sees every pair's latest version.
+void EntityManager::compactChangeLog() {
+    std::unordered_set<uint64_t> seen;
+    size_t keep = m_changeLog.size();
+    for (size_t i = m_changeLog.size(); i-- > 0;) {
+        const ComponentChange& c = m_changeLog[i];
+        const uint64_t key = (uint64_t(c.entity) << 8) | uint64_t(c.type);
+        if (seen.insert(key).second) m_changeLog[--keep] = c;
+    }
+    m_changeLog.erase(m_changeLog.begin(), m_changeLog.begin() + keep);
 }
 
 void EntityManager::setSelectedEntity(Entity entity) {
-    if (m_entities.find(entity) != m_entities.end()) {
+    if (entityExists(entity)) {
         m_selectedEntity = entity;
         std::cout << "[EntityManager] Selected entity: " << entity << "\n";
     } else {
@@ -274,33 +1054,44 @@ Entity EntityManager::getSelectedEntity() const {
 }
 
 bool EntityManager::hasSelectedEntity() const {
-    return m_entities.find(m_selectedEntity) != m_entities.end();
+    return entityExists(m_selectedEntity);
 }
 
 const EntityMeta* EntityManager::getMeta(Entity e) const {
-    auto it = m_metadata.find(e);
-    return it != m_metadata.end() ? &it->second : nullptr;
+    return entityExists(e) ? &m_metadata[entityIndex(e)] : nullptr;
 }
 
 EntityMeta* EntityManager::getMeta(Entity e) {
-    auto it = m_metadata.find(e);
-    return it != m_metadata.end() ? &it->second : nullptr;
+    return entityExists(e) ? &m_metadata[entityIndex(e)] : nullptr;
 }
 
 std::vector<Entity> EntityManager::getChildren(Entity parent) const {
-    auto it = m_metadata.find(parent);
-    if (it != m_metadata.end()) {
-        return it->second.children;
-    } else {
+    if (!entityExists(parent)) {
         std::cerr << "[EntityManager] getChildren: No metadata for entity " << parent << "\n";
         return {};
     }
+    std::vector<Entity> children;
+    children.reserve(m_hierarchy[entityIndex(parent)].childCount);
+    forEachChild(parent, [&](Entity child) { children.push_back(child); });
+    return children;
+}
+
+size_t EntityManager::getChildCount(Entity parent) const {
+    return entityExists(parent) ? m_hierarchy[entityIndex(parent)].childCount : 0;
+}
+
+bool EntityManager::isAncestorOf(Entity ancestor, Entity e) const {
+    if (!entityExists(ancestor) || !entityExists(e)) return false;
+    const uint32_t target = entityIndex(ancestor);
+    for (uint32_t idx = m_hierarchy[entityIndex(e)].parent; idx != 0; idx = m_hierarchy[idx].parent) {
+        if (idx == target) return true;
+    }
+    return false;
 }
 
 Entity EntityManager::getParent(Entity child) const {
-    auto it = m_metadata.find(child);
-    if (it != m_metadata.end()) {
-        return it->second.parent;
+    if (const EntityMeta* meta = getMeta(child)) {
+        return meta->parent;
     } else {
         std::cerr << "[EntityManager] getParent: No metadata found for entity " << child << "\n";
         return INVALID_ENTITY;
@@ -308,30 +1099,22 @@ Entity EntityManager::getParent(Entity child) const {
 }
 
 Entity EntityManager::getRoot(Entity child) const {
-    auto it = m_metadata.find(child);
-    if (it == m_metadata.end()) {
+    if (!getMeta(child)) {
         std::cerr << "[EntityManager] getRoot: No metadata found for entity " << child << "\n";
         return INVALID_ENTITY;
     }
 
-    Entity current = child;
-    while (true) {
-        auto meta = getMeta(current);
-        if (!meta || meta->parent == INVALID_ENTITY) {
-            return current;
-        }
-        current = meta->parent;
+    uint32_t idx = entityIndex(child);
+    while (m_hierarchy[idx].parent != 0) {
+        idx = m_hierarchy[idx].parent;
     }
+    return entityAt(idx);
 }
 
 // Debug functions
 void EntityManager::printHierarchy(Entity root, int depth = 0) const {
-    const auto* meta = getMeta(root);
-    if (!meta) return;
-
-    std::cout << std::string(depth * 2, ' ') << "- " << meta->name << " (ID: " << root << ")\n";
-    for (Entity child : meta->children) {
-        printHierarchy(child, depth + 1);
-    }
+    forEachInSubtree(root, [&](Entity e, int level) {
+        std::cout << std::string((depth + level) * 2, ' ') << "- " << m_metadata[entityIndex(e)].name << " (ID: " << e << ")\n";
+    });
 }
 
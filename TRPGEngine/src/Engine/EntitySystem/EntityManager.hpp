@@ -2,22 +2,38 @@
 
 #include <unordered_map>
 #include <vector>
+#include <deque>
+#include <array>
 #include <memory>
 #include <string>
+#include <istream>
 #include <json.hpp>
 #include "Entity.hpp"
 #include "ComponentBase.hpp"
 #include "ComponentType.hpp"
+#include "ComponentPool.hpp"
+#include "Archetype.hpp"
+#include "EntityView.hpp"
+#include "EntityCommandBuffer.hpp"
+#include "EntityBatch.hpp"
+#include "GuidIndex.hpp"
+
+struct Prefab;
+class EntityRemap;
 
 struct EntityMeta {
     std::string name;
     EntityType type = EntityType::Default;
     Entity parent = INVALID_ENTITY;
-    std::vector<Entity> children;
+    std::shared_ptr<const Prefab> prefab;   // set on prefab instances
+    uint64_t guid = 0;                      // persistent identity, saved as "_meta.guid"; set through setGuid()
 };
 
+class World;
+
 class EntityManager {
 public:
+    // Entity storage of World::current()
     static EntityManager& get();
 
     enum class AddComponentResult {
@@ -30,15 +46,20 @@ public:
 
 
     Entity createEntity(Entity parent = INVALID_ENTITY);
-    void destroyEntity(Entity entity);
-    bool entityExists(Entity e) const;
+    std::vector<Entity> createEntities(size_t count, Entity parent = INVALID_ENTITY);   // reserves once
+    void destroyEntity(Entity entity);          // also destroys children
+    bool entityExists(Entity e) const;          // O(1): slot alive + generation match
+    size_t getEntityCount() const { return m_aliveCount; }
     void clear();
 
-    bool EntityManager::hasComponent(Entity e, ComponentType t) const;
+    bool hasComponent(Entity e, ComponentType t) const;
     AddComponentResult addComponent(Entity e, std::shared_ptr<ComponentBase> c);
+    // Adds several components with a single archetype move instead of one per component
+    AddComponentResult addComponents(Entity e, std::vector<std::shared_ptr<ComponentBase>> comps);
     bool removeComponent(Entity e, ComponentType t);
 
     std::shared_ptr<ComponentBase> getComponent(Entity e, ComponentType type);
+    std::shared_ptr<const ComponentBase> getComponent(Entity e, ComponentType type) const;
     std::vector<std::shared_ptr<ComponentBase>> getAllComponents(Entity e);
     std::vector<Entity> getAllEntities() const;
 
@@ -49,19 +70,76 @@ public:
     void setEntityParent(Entity child, Entity parent);
     const EntityMeta* getMeta(Entity e) const;
     EntityMeta* getMeta(Entity e);
+    // Random and at least 2^32, so a saved reference can tell it from the
+    // plain ids older files contain. createEntity() gives every entity one;
+    // loading restores the saved one so an entity keeps it across loads.
+    static uint64_t newGuid();
+    // Persistent identity <-> id of this session. Files store GUIDs (see
+    // EntityRefs); everything at runtime keeps using the compact Entity ids.
+    uint64_t getGuid(Entity e) const;
+    Entity findByGuid(uint64_t guid) const;     // INVALID_ENTITY if no live entity has it
+    // False if `guid` is 0 or belongs to another entity; `e` then keeps its own
+    bool setGuid(Entity e, uint64_t guid);
 
-    // Hierarchy
+    // Prefab instances share the prefab's component instances until they
+    // edit one. serializeEntity() writes only the fields that differ from the
+    // prefab, and deserializeEntity() shares everything that was not overridden.
+    Entity instantiatePrefab(const std::shared_ptr<const Prefab>& prefab, Entity parent = INVALID_ENTITY);
+    // Makes `e` an instance of `prefab`, dropping its edits to the prefab's components
+    void linkPrefab(Entity e, const std::shared_ptr<const Prefab>& prefab);
+
+    // Hierarchy. Children are intrusive linked lists over dense per-slot
+    // links, so walking them touches no hash maps and allocates nothing.
     Entity getParent(Entity child) const;
     Entity getRoot(Entity child) const;
     std::vector<Entity> getChildren(Entity parent) const;
+    size_t getChildCount(Entity parent) const;
+    bool isAncestorOf(Entity ancestor, Entity e) const;
+
+    // fn(Entity child) for each direct child, in insertion order
+    template <typename Fn>
+    void forEachChild(Entity parent, Fn&& fn) const;
+
+    // fn(Entity e, int depth) for root and all its descendants, depth-first
+    // pre-order (parents before children, root at depth 0). The hierarchy
+    // must not change during the walk.
+    template <typename Fn>
+    void forEachInSubtree(Entity root, Fn&& fn) const;
     void setSelectedEntity(Entity entity);
     Entity getSelectedEntity() const;
     bool hasSelectedEntity() const;
     std::vector<Entity> getEntitiesWith(ComponentType t) const;
 
-    // IO
+    // IO. Entities are saved with their "_meta.guid" and component references
+    // as GUIDs (EntityRefs); loading maps them to the ids of this session.
     nlohmann::json serializeEntity(Entity e) const;
     Entity deserializeEntity(const nlohmann::json& j);
+    // Same as deserializeEntity(json) while parsing: see EntityStreamReader
+    Entity deserializeEntity(std::istream& in, const std::string& sourceName = "stream");
+    // One element of a "components" array; nullptr (logged) if its type is missing or unknown
+    static std::shared_ptr<ComponentBase> loadComponent(const nlohmann::json& compJ);
+    static void stageEntity(const nlohmann::json& j, EntityBatch& out, uint32_t parent = EntityBatch::NO_PARENT);
+
+    // Creates everything in `batch` at once. Ids are allocated in one go, each
+    // entity gets its saved GUID back, and the staged components resolve their
+    // references (GUIDs, or the "_meta.id" of older files) through an
+    // EntityRemap (ComponentBase::remapEntities) in one pass before they are
+    // stored. An entity whose GUID already came up earlier in the batch is a
+    // duplicate and is skipped with its subtree. Returns the top-level
+    // entities in batch order.
+    std::vector<Entity> createBatch(EntityBatch batch);
+
+    // Paging for SceneStreamer. loadInto() gives each existing targets[i] the
+    // staged components of batch entity i (prefab link and overrides
+    // included); its meta and place in the hierarchy stay as they are.
+    // unload() drops an entity's components and prefab link but keeps the
+    // entity. Versions advance, but neither is logged as a change: paging is
+    // not an edit for the journal to record.
+    void loadInto(EntityBatch batch, const std::vector<Entity>& targets);
+    void unload(Entity e);
+
+    // Stages every .entity file in the folder on the job system, then
+    // creates them in one batch, so references across files survive
     void loadEntitiesFromFolder(const std::string& path);
 
     // Handle-like API
@@ -70,20 +148,146 @@ public:
 
     template <typename T>
     T* get(Entity e);
+    template <typename T>
+    const T* get(Entity e) const;
 
     template<typename T>
     std::shared_ptr<T> getComponent(Entity entity);
+    template<typename T>
+    std::shared_ptr<const T> getComponent(Entity entity) const;
+
+    // get<T>() for code that is about to modify the component; marks it dirty
+    template <typename T>
+    T* getMutable(Entity e);
+
+    // Change tracking. Each change takes the next value of a global version
+    // counter. Entities and component slots remember the version of their
+    // last change, so consumers can store getVersion() and later ask only
+    // for what changed after it. Structural changes (add/remove/create/destroy,
+    // meta and hierarchy edits) are recorded automatically; in-place field
+    // edits must go through getMutable<T>() or markDirty().
+    struct ComponentChange {
+        uint64_t version;
+        Entity entity;
+        ComponentType type;     // Unknown for entity-level changes (create, destroy, meta, hierarchy)
+    };
+
+    uint64_t getVersion() const { return m_version; }
+    uint64_t markDirty(Entity e, ComponentType t);
+    uint64_t getEntityVersion(Entity e) const;
+    uint64_t getComponentVersion(Entity e, ComponentType t) const;
+
+    // True if the change log reaches back to `version`; false if it predates
+    // the last clear(), and the caller must then treat everything as changed
+    bool changeLogCovers(uint64_t version) const { return version >= m_changeLogStart; }
+
+    // Changes with a version above `version`, oldest first. An (entity, type)
+    // pair may repeat. Destroyed entities are reported too; check
+    // entityExists() when it matters.
+    template <typename Fn>
+    void forEachChangeSince(uint64_t version, Fn&& fn) const;
+    std::vector<Entity> getEntitiesChangedSince(uint64_t version) const;
+
+    // Queries: iterate entities having all of Ts without allocating.
+    // Matching archetypes are cached per component mask and extended when
+    // new archetypes appear, so repeated queries are a single hash lookup.
+    template <typename... Ts>
+    EntityView<Ts...> view();
+
+    const std::vector<uint32_t>& queryArchetypes(const ComponentMask& mask);
+
+    // Pre-sizes the archetype for `mask` ahead of inserting `count` entities into it
+    void reserveArchetype(const ComponentMask& mask, size_t count);
+
+    // Copy-on-write snapshots. forkFrom() turns this into a copy of `source`
+    // by copying the entity index arrays only: the component instances stay
+    // shared until either side writes. Non-const accessors (get<T>,
+    // getMutable<T>, getComponent, getAllComponents, view<Ts...>) give each
+    // side its own copy of a shared component first; const overloads and
+    // hasComponent never copy. Neither manager may be in use on another
+    // thread during the fork.
+    void forkFrom(EntityManager& source);
+
+    // Makes every stored component of `types` writable in place, for code
+    // that walks getArchetypes() columns directly
+    void ensureWritable(const ComponentMask& types);
+
+    // Frame command buffer for structural changes made while iterating (UI panels,
+    // systems). Applied by flushDeferred() at the end of the frame.
+    EntityCommandBuffer& deferred() { return m_deferred; }
+    void flushDeferred();
 
     // Debug functions
     void printHierarchy(Entity root, int depth) const;
 
+    // Archetype storage (read-only access for systems that iterate columns)
+    const std::vector<Archetype>& getArchetypes() const { return m_archetypes; }
+
+    // Per-type component storage; prefer makeComponent<T>() over using this directly
+    ComponentPool& getPool(ComponentType type) { return componentPoolFor(type); }
+
 private:
-    EntityManager() = default;
+    friend class World;
+    EntityManager();
+
+    // Dense per-index slot: generation for handle validation, plus where the
+    // entity's components live (archetype index + row in its columns)
+    struct EntityRecord {
+        uint32_t generation = 0;
+        bool alive = false;
+        uint32_t archetype = 0;
+        uint32_t row = 0;
+        uint64_t version = 0;       // last change to this entity or any of its components
+    };
+
+    // Hierarchy links as slot indices (0 = none), parallel to m_records
+    struct HierarchyLinks {
+        uint32_t parent = 0;
+        uint32_t firstChild = 0;
+        uint32_t lastChild = 0;
+        uint32_t prevSibling = 0;
+        uint32_t nextSibling = 0;
+        uint32_t childCount = 0;
+    };
+
+    // Meta, prefab link, overrides and removals from a staged shell, then the components
+    void loadStaged(Entity e, const nlohmann::json& shell, std::vector<std::shared_ptr<ComponentBase>> components,
+                    EntityRemap& remap);
+    void resetArchetypes();
+    uint32_t findOrCreateArchetype(const ComponentMask& mask);
+    uint32_t archetypeWith(uint32_t from, ComponentType t);
+    uint32_t archetypeWithout(uint32_t from, ComponentType t);
+    void moveEntity(Entity e, EntityRecord& record, uint32_t dst);
+    void detachRow(const EntityRecord& record);
+    const EntityRecord* findRecord(Entity e) const;
+    EntityRecord* findRecord(Entity e);
+    void detachFromParent(Entity child);
+    Entity entityAt(uint32_t idx) const { return makeEntity(idx, m_records[idx].generation); }
+    uint64_t recordChange(Entity e, ComponentType t);
+    void compactChangeLog();
+    void makeWritable(std::shared_ptr<ComponentBase>& slot, ComponentType t);
+    void adoptComponent(ComponentBase& c);
+    static uint64_t nextCowTag();
 
-    Entity m_nextId = 1;
     Entity m_selectedEntity = INVALID_ENTITY;
-    std::unordered_map<Entity, std::unordered_map<ComponentType, std::shared_ptr<ComponentBase>>> m_entities;
-    std::unordered_map<Entity, EntityMeta> m_metadata;
+    std::vector<Archetype> m_archetypes;                       // [0] is the empty archetype
+    EntityCommandBuffer m_deferred;
+    std::unordered_map<ComponentMask, uint32_t> m_archetypeIndex;
+    std::unordered_map<ComponentMask, std::vector<uint32_t>> m_queryCache;   // mask -> matching archetypes
+    std::vector<EntityRecord> m_records;        // indexed by entityIndex(); [0] reserved for INVALID_ENTITY
+    std::vector<EntityMeta> m_metadata;         // parallel to m_records
+    GuidIndex m_guidIndex;                      // EntityMeta::guid -> slot of every live entity
+    std::vector<HierarchyLinks> m_hierarchy;    // parallel to m_records
+    std::deque<uint32_t> m_freeIndices;         // FIFO so a slot's generation wraps as late as possible
+    size_t m_aliveCount = 0;
+    uint64_t m_version = 0;
+    uint64_t m_changeLogStart = 0;              // m_changeLog covers every change after this version
+    std::vector<ComponentChange> m_changeLog;   // ascending versions; compacted to the latest per (entity, type)
+    size_t m_changeLogLimit = CHANGE_LOG_MIN_LIMIT;
+    bool m_logChanges = true;                   // off while loadInto()/unload() run
+    static constexpr size_t CHANGE_LOG_MIN_LIMIT = 4096;
+    uint64_t m_cowTag = nextCowTag();           // changes on every fork, on both sides
+    ComponentMask m_writableColumns;            // types whose stored components all carry m_cowTag
 
     // Disable copying
     EntityManager(const EntityManager&) = delete;
@@ -2,28 +2,108 @@
 
 #include "EntityManager.hpp"
 
+#include <algorithm>
+
 template<typename T>
 std::shared_ptr<T> EntityManager::getComponent(Entity entity) {
-    ComponentType type = T::getStaticType();
-    auto it = m_entities.find(entity);
-    if (it != m_entities.end()) {
-        auto compIt = it->second.find(type);
-        if (compIt != it->second.end()) {
-            return std::dynamic_pointer_cast<T>(compIt->second);
-        }
-    }
-    return nullptr;
+    const EntityRecord* rec = findRecord(entity);
+    if (!rec) return nullptr;
+
+    Archetype::Column* col = m_archetypes[rec->archetype].column(componentTypeOf<T>());
+    if (!col) return nullptr;
+    makeWritable((*col)[rec->row], componentTypeOf<T>());
+    return std::static_pointer_cast<T>((*col)[rec->row]);   // column type guarantees T
+}
+
+template<typename T>
+std::shared_ptr<const T> EntityManager::getComponent(Entity entity) const {
+    const EntityRecord* rec = findRecord(entity);
+    if (!rec) return nullptr;
+
+    const Archetype::Column* col = m_archetypes[rec->archetype].column(componentTypeOf<T>());
+    if (!col) return nullptr;
+    return std::static_pointer_cast<const T>((*col)[rec->row]);
 }
 
 template <typename T, typename... Args>
 T& EntityManager::add(Entity e, Args&&... args) {
-    auto comp = std::make_shared<T>(std::forward<Args>(args)...);
+    auto comp = makeComponent<T>(std::forward<Args>(args)...);
     addComponent(e, comp);
     return *comp;
 }
 
 template <typename T>
 T* EntityManager::get(Entity e) {
-    auto comp = getComponent<T>(e);
-    return comp ? comp.get() : nullptr;
+    const EntityRecord* rec = findRecord(e);
+    if (!rec) return nullptr;
+
+    Archetype::Column* col = m_archetypes[rec->archetype].column(componentTypeOf<T>());
+    if (!col) return nullptr;
+    makeWritable((*col)[rec->row], componentTypeOf<T>());
+    return static_cast<T*>((*col)[rec->row].get());
+}
+
+template <typename T>
+const T* EntityManager::get(Entity e) const {
+    const EntityRecord* rec = findRecord(e);
+    if (!rec) return nullptr;
+
+    const Archetype::Column* col = m_archetypes[rec->archetype].column(componentTypeOf<T>());
+    return col ? static_cast<const T*>((*col)[rec->row].get()) : nullptr;
+}
+
+template <typename... Ts>
+EntityView<Ts...> EntityManager::view() {
+    const ComponentMask mask = makeComponentMask<Ts...>();
+    ensureWritable(mask);
+    return EntityView<Ts...>(m_archetypes, queryArchetypes(mask));
+}
+
+template <typename T>
+T* EntityManager::getMutable(Entity e) {
+    T* comp = get<T>(e);
+    if (comp) markDirty(e, componentTypeOf<T>());
+    return comp;
+}
+
+template <typename Fn>
+void EntityManager::forEachChangeSince(uint64_t version, Fn&& fn) const {
+    auto first = std::upper_bound(m_changeLog.begin(), m_changeLog.end(), version,
+        [](uint64_t v, const ComponentChange& c) { return v < c.version; });
+    for (auto it = first; it != m_changeLog.end(); ++it) {
+        fn(*it);
+    }
+}
+
+template <typename Fn>
+void EntityManager::forEachChild(Entity parent, Fn&& fn) const {
+    if (!entityExists(parent)) return;
+    for (uint32_t idx = m_hierarchy[entityIndex(parent)].firstChild; idx != 0; idx = m_hierarchy[idx].nextSibling) {
+        fn(entityAt(idx));
+    }
+}
+
+template <typename Fn>
+void EntityManager::forEachInSubtree(Entity root, Fn&& fn) const {
+    if (!entityExists(root)) return;
+
+    const uint32_t rootIdx = entityIndex(root);
+    uint32_t idx = rootIdx;
+    int depth = 0;
+    while (true) {
+        fn(entityAt(idx), depth);
+
+        if (m_hierarchy[idx].firstChild != 0) {
+            idx = m_hierarchy[idx].firstChild;
+            ++depth;
+            continue;
+        }
+        // Climb until a node has a next sibling, stopping at the root
+        while (idx != rootIdx && m_hierarchy[idx].nextSibling == 0) {
+            idx = m_hierarchy[idx].parent;
+            --depth;
+        }
+        if (idx == rootIdx) return;
+        idx = m_hierarchy[idx].nextSibling;
+    }
 }
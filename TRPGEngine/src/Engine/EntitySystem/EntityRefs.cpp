@@ -0,0 +1,99 @@
+#include "EntityRefs.hpp"
+#include "EntityManager.hpp"
+
+#include <charconv>
+
+namespace EntityRefs {
+
+namespace {
+    thread_local std::vector<uint64_t>* t_staging = nullptr;
+
+    constexpr std::string_view EVENT_TAG = "@Event:";
+
+    // The number after "@Event:"; false for scene names and malformed tags
+    bool parseEventTag(std::string_view target, uint64_t& value) {
+        if (target.substr(0, EVENT_TAG.size()) != EVENT_TAG) return false;
+        target.remove_prefix(EVENT_TAG.size());
+        auto [end, ec] = std::from_chars(target.data(), target.data() + target.size(), value);
+        return ec == std::errc() && end == target.data() + target.size();
+    }
+
+    Entity loadGuid(uint64_t guid) {
+        if (!t_staging) return EntityManager::get().findByGuid(guid);
+        t_staging->push_back(guid);
+        return placeholder(t_staging->size() - 1);
+    }
+
+    // Inside a Staging scope ids are placeholders (or ids from an older
+    // file), so a staged component writes back what it was read from
+    uint64_t saveGuid(Entity e) {
+        if (!t_staging) return EntityManager::get().getGuid(e);
+        const size_t slot = placeholderSlot(e);
+        return slot < t_staging->size() ? (*t_staging)[slot] : e;
+    }
+}
+
+Staging::Staging(std::vector<uint64_t>& refs) : m_previous(t_staging) {
+    t_staging = &refs;
+}
+
+Staging::~Staging() {
+    t_staging = m_previous;
+}
+
+uint64_t saveId(Entity e) {
+    if (e == INVALID_ENTITY) return 0;
+    return saveGuid(e);
+}
+
+Entity loadId(uint64_t saved) {
+    if (saved < FIRST_GUID) return static_cast<Entity>(saved);     // id from an older file
+    return loadGuid(saved);
+}
+
+nlohmann::json save(Entity e) {
+    return saveId(e);
+}
+
+nlohmann::json saveList(const std::vector<Entity>& list) {
+    nlohmann::json out = nlohmann::json::array();
+    for (Entity e : list) out.push_back(save(e));
+    return out;
+}
+
+Entity load(const nlohmann::json& value) {
+    if (!value.is_number_unsigned()) return INVALID_ENTITY;    // null, negative or not a number
+    return loadId(value.get<uint64_t>());
+}
+
+std::vector<Entity> loadList(const nlohmann::json& value) {
+    std::vector<Entity> out;
+    if (!value.is_array()) return out;
+    out.reserve(value.size());
+    for (const auto& v : value) out.push_back(load(v));
+    return out;
+}
+
+Entity load(const nlohmann::json& object, const char* key) {
+    auto it = object.find(key);
+    return it != object.end() ? load(*it) : INVALID_ENTITY;
+}
+
+std::vector<Entity> loadList(const nlohmann::json& object, const char* key) {
+    auto it = object.find(key);
+    return it != object.end() ? loadList(*it) : std::vector<Entity>{};
+}
+
+std::string saveTarget(std::string_view target) {
+    uint64_t id = 0;
+    if (!parseEventTag(target, id) || id >= FIRST_GUID) return std::string(target);
+    return std::string(EVENT_TAG) + std::to_string(saveGuid(static_cast<Entity>(id)));
+}
+
+std::string loadTarget(std::string_view target) {
+    uint64_t guid = 0;
+    if (!parseEventTag(target, guid) || guid < FIRST_GUID) return std::string(target);
+    return std::string(EVENT_TAG) + std::to_string(loadGuid(guid));
+}
+
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <json.hpp>
+
+#include "Entity.hpp"
+
+/**
+ * Entity references in saved component JSON. Ids change on every load, so
+ * a reference is written as its target's persistent GUID
+ * (EntityManager::getGuid) and turned back into an id when loaded: right
+ * away through the current EntityManager, or, while a Staging scope is
+ * open, by EntityManager::createBatch() once the batch has ids (the target
+ * may be in the same batch and not exist yet).
+ *
+ * GUIDs are at least 2^32 and plain ids never are, so files written before
+ * GUIDs still load; their ids go through the saved "_meta.id" map or stay
+ * as they are.
+ */
+namespace EntityRefs {
+
+constexpr uint64_t FIRST_GUID = uint64_t(1) << 32;
+
+nlohmann::json save(Entity e);                          // GUID, 0 for none or a dead entity
+nlohmann::json saveList(const std::vector<Entity>& list);
+Entity load(const nlohmann::json& value);
+std::vector<Entity> loadList(const nlohmann::json& value);
+// The same as bare numbers, for binary records (ComponentFields)
+uint64_t saveId(Entity e);
+Entity loadId(uint64_t saved);
+// Member `key` of `object`; none (empty) if it is missing
+Entity load(const nlohmann::json& object, const char* key);
+std::vector<Entity> loadList(const nlohmann::json& object, const char* key);
+
+// "@Event:<id>" link targets; scene names pass through unchanged
+std::string saveTarget(std::string_view target);
+std::string loadTarget(std::string_view target);
+
+/**
+ * While alive, load() on this thread does not resolve GUIDs. It records
+ * them in `refs` and returns a placeholder id instead, which
+ * EntityRemap resolves (see EntityRemap::setRefs), and save() turns those
+ * placeholders back into their GUIDs. Scopes nest.
+ */
+class Staging {
+public:
+    explicit Staging(std::vector<uint64_t>& refs);
+    ~Staging();
+    Staging(const Staging&) = delete;
+    Staging& operator=(const Staging&) = delete;
+
+private:
+    std::vector<uint64_t>* m_previous;
+};
+
+// Placeholders count down from the top of the id range; `slot` indexes the Staging refs
+constexpr Entity placeholder(size_t slot) { return ~Entity(0) - static_cast<Entity>(slot); }
+constexpr size_t placeholderSlot(Entity e) { return ~e; }
+
+}
@@ -0,0 +1,8 @@
+#include "EntityRemap.hpp"
+#include "EntityManager.hpp"
+
+Entity EntityRemap::resolveGuid(uint64_t guid) const {
+    auto it = m_guids.find(guid);
+    if (it != m_guids.end()) return it->second;
+    return m_existing ? m_existing->findByGuid(guid) : INVALID_ENTITY;
+}
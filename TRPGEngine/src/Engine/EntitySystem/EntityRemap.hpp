@@ -0,0 +1,73 @@
+#pragma once
+
+#include <charconv>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "Entity.hpp"
+#include "EntityRefs.hpp"
+#include "Core/Atom.hpp"
+
+class EntityManager;
+
+/**
+ * How the references of one load resolve, built by EntityManager::createBatch().
+ * Components rewrite their entity references through it in
+ * ComponentBase::remapEntities():
+ *  - GUID placeholders (EntityRefs::Staging) become the entity with that GUID,
+ *    in the batch first, then among the entities that already existed;
+ *  - ids from files written before GUIDs go through the saved "_meta.id" map.
+ * Ids it does not know are left alone: they name entities outside the load.
+ */
+class EntityRemap {
+public:
+    // `existing` resolves GUIDs that are not part of the batch; may be null
+    explicit EntityRemap(const EntityManager* existing = nullptr) : m_existing(existing) {}
+
+    // False if `saved` is already mapped
+    bool add(Entity saved, Entity current) { return m_ids.emplace(saved, current).second; }
+    bool contains(Entity saved) const { return m_ids.count(saved) != 0; }
+    bool empty() const { return m_ids.empty(); }
+    size_t size() const { return m_ids.size(); }
+
+    void addGuid(uint64_t guid, Entity current) { m_guids.emplace(guid, current); }
+    // INVALID_ENTITY if nothing has it: the reference was dangling when saved
+    Entity resolveGuid(uint64_t guid) const;
+
+    // GUIDs recorded while the components about to be remapped were loaded
+    void setRefs(const std::vector<uint64_t>* refs) { m_refs = refs; }
+
+    Entity operator()(Entity saved) const {
+        if (m_refs && EntityRefs::placeholderSlot(saved) < m_refs->size()) {
+            return resolveGuid((*m_refs)[EntityRefs::placeholderSlot(saved)]);
+        }
+        auto it = m_ids.find(saved);
+        return it != m_ids.end() ? it->second : saved;
+    }
+
+    void apply(Entity& e) const { e = (*this)(e); }
+    void apply(std::vector<Entity>& list) const {
+        for (Entity& e : list) e = (*this)(e);
+    }
+
+    // "@Event:<id>" link targets (see parseEventTarget); flow node names stay as they are.
+    // A GUID target was staged as "@Event:<placeholder>" by EntityRefs::loadTarget.
+    void applyTarget(Atom& target) const {
+        constexpr std::string_view tag = "@Event:";
+        const std::string& text = target.str();
+        if (text.compare(0, tag.size(), tag) != 0) return;
+        Entity id = INVALID_ENTITY;
+        auto [end, ec] = std::from_chars(text.data() + tag.size(), text.data() + text.size(), id);
+        if (ec != std::errc() || end != text.data() + text.size()) return;
+        const Entity mapped = (*this)(id);
+        if (mapped != id) target = std::string(tag) + std::to_string(mapped);
+    }
+
+private:
+    const EntityManager* m_existing;
+    std::unordered_map<Entity, Entity> m_ids;           // legacy saved id -> id
+    std::unordered_map<uint64_t, Entity> m_guids;       // GUIDs loaded in this batch
+    const std::vector<uint64_t>* m_refs = nullptr;
+};
@@ -0,0 +1,199 @@
+#include "EntityStreamReader.hpp"
+#include "EntityManager.hpp"
+#include "EntityRefs.hpp"
+
+#include <iostream>
+#include <utility>
+
+bool EntityStreamReader::read(std::istream& in, const std::string& sourceName) {
+    m_source = sourceName;
+    m_scopes.clear();
+    m_frames.clear();
+    m_rootRead = false;
+    m_error.clear();
+    m_capturing = false;
+    m_captureStack.clear();
+
+    const size_t start = m_out.size();
+    bool ok = false;
+    try {
+        ok = nlohmann::json::sax_parse(in, this);
+    } catch (const std::exception& ex) {
+        m_error = ex.what();
+    }
+
+    if (!ok || !m_rootRead) {
+        if (m_error.empty()) m_error = "no entity object found";
+        std::cerr << "[EntityStreamReader] " << m_source << ": " << m_error << "\n";
+        m_out.entities.resize(start);
+        return false;
+    }
+    return true;
+}
+
+template <typename Value>
+bool EntityStreamReader::value(Value&& v) {
+    if (!m_capturing && !beginCapture()) return false;
+
+    if (m_captureStack.empty()) {
+        m_capture = nlohmann::json(std::forward<Value>(v));
+        endCapture();
+    } else if (m_captureStack.back()->is_array()) {
+        m_captureStack.back()->emplace_back(std::forward<Value>(v));
+    } else {
+        *m_captureSlot = nlohmann::json(std::forward<Value>(v));
+    }
+    return true;
+}
+
+bool EntityStreamReader::null() { return value(nullptr); }
+bool EntityStreamReader::boolean(bool val) { return value(val); }
+bool EntityStreamReader::number_integer(number_integer_t val) { return value(val); }
+bool EntityStreamReader::number_unsigned(number_unsigned_t val) { return value(val); }
+bool EntityStreamReader::number_float(number_float_t val, const string_t&) { return value(val); }
+bool EntityStreamReader::string(string_t& val) { return value(std::move(val)); }
+
+bool EntityStreamReader::binary(binary_t&) {
+    return fail("binary values are not part of the entity format");
+}
+
+bool EntityStreamReader::start_object(std::size_t) {
+    if (!m_capturing) {
+        if (m_scopes.empty() || m_scopes.back() == Scope::Children) {
+            m_frames.emplace_back();
+            m_scopes.push_back(Scope::Entity);
+            return true;
+        }
+        if (!beginCapture()) return false;
+    }
+
+    nlohmann::json* obj = nullptr;
+    if (m_captureStack.empty()) {
+        m_capture = nlohmann::json::object();
+        obj = &m_capture;
+    } else if (m_captureStack.back()->is_array()) {
+        m_captureStack.back()->emplace_back(nlohmann::json::object());
+        obj = &m_captureStack.back()->back();
+    } else {
+        *m_captureSlot = nlohmann::json::object();
+        obj = m_captureSlot;
+    }
+    m_captureStack.push_back(obj);
+    return true;
+}
+
+bool EntityStreamReader::key(string_t& val) {
+    if (m_capturing) {
+        m_captureSlot = &(*m_captureStack.back())[val];
+    } else {
+        m_key = std::move(val);
+    }
+    return true;
+}
+
+bool EntityStreamReader::end_object() {
+    if (m_capturing) {
+        m_captureStack.pop_back();
+        if (m_captureStack.empty()) endCapture();
+        return true;
+    }
+    endEntity();
+    return true;
+}
+
+bool EntityStreamReader::start_array(std::size_t) {
+    if (!m_capturing) {
+        if (m_scopes.empty()) return fail("top level is not an entity object");
+        if (m_scopes.back() == Scope::Entity && m_key == "components") {
+            m_scopes.push_back(Scope::Components);
+            return true;
+        }
+        if (m_scopes.back() == Scope::Entity && m_key == "children") {
+            m_scopes.push_back(Scope::Children);
+            return true;
+        }
+        if (!beginCapture()) return false;
+    }
+
+    nlohmann::json* arr = nullptr;
+    if (m_captureStack.empty()) {
+        m_capture = nlohmann::json::array();
+        arr = &m_capture;
+    } else if (m_captureStack.back()->is_array()) {
+        m_captureStack.back()->emplace_back(nlohmann::json::array());
+        arr = &m_captureStack.back()->back();
+    } else {
+        *m_captureSlot = nlohmann::json::array();
+        arr = m_captureSlot;
+    }
+    m_captureStack.push_back(arr);
+    return true;
+}
+
+bool EntityStreamReader::end_array() {
+    if (m_capturing) {
+        m_captureStack.pop_back();
+        if (m_captureStack.empty()) endCapture();
+        return true;
+    }
+    m_scopes.pop_back();    // leaves a components or children array
+    return true;
+}
+
+bool EntityStreamReader::parse_error(std::size_t, const std::string&, const nlohmann::detail::exception& ex) {
+    m_error = ex.what();
+    return false;
+}
+
+bool EntityStreamReader::beginCapture() {
+    if (m_scopes.empty()) return fail("top level is not an entity object");
+    m_capturing = true;
+    m_capture = nullptr;
+    m_captureSlot = nullptr;
+    return true;
+}
+
+void EntityStreamReader::endCapture() {
+    m_capturing = false;
+    nlohmann::json captured = std::move(m_capture);
+    m_capture = nullptr;
+
+    switch (m_scopes.back()) {
+    case Scope::Entity:
+        m_frames.back().shell[m_key] = std::move(captured);
+        break;
+    case Scope::Components: {
+        Frame& frame = m_frames.back();
+        EntityRefs::Staging refs(frame.refs);
+        if (auto comp = EntityManager::loadComponent(captured)) frame.components.push_back(std::move(comp));
+        break;
+    }
+    case Scope::Children:
+        std::cerr << "[EntityStreamReader] " << m_source << ": skipping a child that is not an object\n";
+        break;
+    }
+}
+
+void EntityStreamReader::endEntity() {
+    Frame frame = std::move(m_frames.back());
+    m_frames.pop_back();
+    m_scopes.pop_back();
+
+    const uint32_t index = static_cast<uint32_t>(m_out.size());
+    StagedEntity& staged = m_out.entities.emplace_back();
+    staged.shell = std::move(frame.shell);
+    staged.components = std::move(frame.components);
+    staged.refs = std::move(frame.refs);
+    for (uint32_t child : frame.children) m_out.entities[child].parent = index;
+
+    if (m_frames.empty()) {
+        m_rootRead = true;
+    } else {
+        m_frames.back().children.push_back(index);
+    }
+}
+
+bool EntityStreamReader::fail(const std::string& what) {
+    m_error = what;
+    return false;
+}
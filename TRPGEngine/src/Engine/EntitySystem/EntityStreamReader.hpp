@@ -0,0 +1,78 @@
+#pragma once
+
+#include <istream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <json.hpp>
+
+#include "EntityBatch.hpp"
+
+class ComponentBase;
+
+/**
+ * SAX reader for the `_meta` / `components` / `children` JSON that
+ * EntityManager::serializeEntity() writes. Entities are staged into an
+ * EntityBatch as their objects close, and each component is handed to its
+ * loader as soon as its object ends, so the only JSON ever built is one
+ * component or one `_meta` block at a time; memory does not grow with the
+ * file. Nothing touches an EntityManager, so files can be read on job
+ * threads.
+ *
+ * Children close before their parent, so they are staged first; their
+ * parent index is filled in once the parent is staged.
+ */
+class EntityStreamReader final : public nlohmann::json_sax<nlohmann::json> {
+public:
+    explicit EntityStreamReader(EntityBatch& out) : m_out(out) {}
+
+    // Appends the entity tree in `in` to the batch. False (logged) if it is
+    // not valid JSON or not an entity, in which case the batch is left as it was.
+    bool read(std::istream& in, const std::string& sourceName = "stream");
+
+    bool null() override;
+    bool boolean(bool val) override;
+    bool number_integer(number_integer_t val) override;
+    bool number_unsigned(number_unsigned_t val) override;
+    bool number_float(number_float_t val, const string_t& s) override;
+    bool string(string_t& val) override;
+    bool binary(binary_t& val) override;
+    bool start_object(std::size_t elements) override;
+    bool key(string_t& val) override;
+    bool end_object() override;
+    bool start_array(std::size_t elements) override;
+    bool end_array() override;
+    bool parse_error(std::size_t position, const std::string& lastToken,
+                     const nlohmann::detail::exception& ex) override;
+
+private:
+    enum class Scope { Entity, Components, Children };
+
+    struct Frame {
+        nlohmann::json shell = nlohmann::json::object();   // everything but components and children
+        std::vector<std::shared_ptr<ComponentBase>> components;
+        std::vector<uint64_t> refs;        // see EntityRefs::Staging
+        std::vector<uint32_t> children;    // batch indices, in file order
+    };
+
+    EntityBatch& m_out;
+    std::string m_source;
+    std::vector<Scope> m_scopes;
+    std::vector<Frame> m_frames;
+    std::string m_key;                  // last key read at entity level
+    bool m_rootRead = false;
+    std::string m_error;
+
+    // One value (a component, `_meta`, ...) being collected into a small DOM
+    bool m_capturing = false;
+    nlohmann::json m_capture;
+    std::vector<nlohmann::json*> m_captureStack;
+    nlohmann::json* m_captureSlot = nullptr;
+
+    template <typename Value>
+    bool value(Value&& v);
+    bool beginCapture();
+    void endCapture();
+    void endEntity();
+    bool fail(const std::string& what);
+};
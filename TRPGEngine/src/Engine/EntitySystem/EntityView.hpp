@@ -0,0 +1,117 @@
+#pragma once
+
+#include <cstdint>
+#include <tuple>
+#include <vector>
+
+#include "Entity.hpp"
+#include "Archetype.hpp"
+#include "ComponentBase.hpp"
+
+template <typename... Ts>
+ComponentMask makeComponentMask() {
+    ComponentMask mask;
+    (mask.set(componentIndex<Ts>), ...);
+    return mask;
+}
+
+/**
+ * Non-allocating iteration over every entity that has all of Ts.
+ * Obtained from EntityManager::view<Ts...>(); walks the cached list of
+ * matching archetypes and hands out typed references straight from the
+ * archetype columns.
+ *
+ * Adding/removing components or entities while iterating moves rows
+ * between archetypes, so structural changes must wait until the loop ends.
+ *
+ *     for (auto [e, flow] : em.view<FlowNodeComponent>()) { ... }
+ *     em.view<Transform2DComponent, DialogueComponent>().each(
+ *         [](Entity e, Transform2DComponent& t, DialogueComponent& d) { ... });
+ */
+template <typename... Ts>
+class EntityView {
+public:
+    static_assert(sizeof...(Ts) > 0, "EntityView needs at least one component type");
+
+    using value_type = std::tuple<Entity, Ts&...>;
+
+    EntityView(std::vector<Archetype>& archetypes, const std::vector<uint32_t>& matches)
+        : m_archetypes(&archetypes), m_matches(&matches) {}
+
+    class iterator {
+    public:
+        iterator(std::vector<Archetype>* archetypes, const std::vector<uint32_t>* matches, size_t match)
+            : m_archetypes(archetypes), m_matches(matches), m_match(match) {
+            skipEmpty();
+        }
+
+        value_type operator*() const {
+            Archetype& arch = (*m_archetypes)[(*m_matches)[m_match]];
+            return value_type(arch.entities()[m_row], fetch<Ts>(arch)...);
+        }
+
+        iterator& operator++() {
+            if (++m_row >= (*m_archetypes)[(*m_matches)[m_match]].size()) {
+                ++m_match;
+                m_row = 0;
+                skipEmpty();
+            }
+            return *this;
+        }
+
+        bool operator==(const iterator& o) const { return m_match == o.m_match && m_row == o.m_row; }
+        bool operator!=(const iterator& o) const { return !(*this == o); }
+
+    private:
+        template <typename T>
+        T& fetch(Archetype& arch) const {
+            return static_cast<T&>(*(*arch.column(componentTypeOf<T>()))[m_row]);
+        }
+
+        void skipEmpty() {
+            while (m_match < m_matches->size() && (*m_archetypes)[(*m_matches)[m_match]].empty())
+                ++m_match;
+        }
+
+        std::vector<Archetype>* m_archetypes;
+        const std::vector<uint32_t>* m_matches;
+        size_t m_match = 0;
+        size_t m_row = 0;
+    };
+
+    iterator begin() const { return iterator(m_archetypes, m_matches, 0); }
+    iterator end() const { return iterator(m_archetypes, m_matches, m_matches->size()); }
+
+    // Calls fn(Entity, Ts&...) for each match; column lookups happen once per archetype.
+    template <typename Fn>
+    void each(Fn&& fn) const {
+        for (uint32_t idx : *m_matches) {
+            Archetype& arch = (*m_archetypes)[idx];
+            const size_t count = arch.size();
+            if (count == 0) continue;
+
+            std::tuple<ColumnPtr<Ts>...> cols{ arch.column(componentTypeOf<Ts>())... };
+            const auto& entities = arch.entities();
+            for (size_t row = 0; row < count; ++row) {
+                std::apply([&](auto*... c) {
+                    fn(entities[row], static_cast<Ts&>(*(*c)[row])...);
+                }, cols);
+            }
+        }
+    }
+
+    size_t size() const {
+        size_t n = 0;
+        for (uint32_t idx : *m_matches) n += (*m_archetypes)[idx].size();
+        return n;
+    }
+
+    bool empty() const { return begin() == end(); }
+
+private:
+    template <typename>
+    using ColumnPtr = Archetype::Column*;
+
+    std::vector<Archetype>* m_archetypes;
+    const std::vector<uint32_t>* m_matches;
+};
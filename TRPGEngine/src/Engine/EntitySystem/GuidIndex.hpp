@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * GUID -> entity slot index behind EntityManager::findByGuid(). Open
+ * addressing with linear probing in one flat array, so a World::fork()
+ * copies it like the other per-entity arrays instead of rebuilding a node
+ * per entity, and a lookup is usually a single cache line. GUID 0 marks an
+ * empty slot; EntityManager never hands it out.
+ */
+class GuidIndex {
+public:
+    size_t size() const { return m_count; }
+
+    void clear() {
+        m_slots.clear();
+        m_count = 0;
+    }
+
+    // Slot index mapped to `guid`, 0 if none (slot 0 backs INVALID_ENTITY)
+    uint32_t find(uint64_t guid) const {
+        if (guid == 0 || m_slots.empty()) return 0;
+        const size_t mask = m_slots.size() - 1;
+        for (size_t i = home(guid); ; i = (i + 1) & mask) {
+            if (m_slots[i].guid == guid) return m_slots[i].index;
+            if (m_slots[i].guid == 0) return 0;
+        }
+    }
+
+    // False if `guid` is 0 or already mapped
+    bool insert(uint64_t guid, uint32_t index) {
+        if (guid == 0) return false;
+        if ((m_count + 1) * 4 > m_slots.size() * 3) grow();
+        const size_t mask = m_slots.size() - 1;
+        size_t i = home(guid);
+        for (; m_slots[i].guid != 0; i = (i + 1) & mask) {
+            if (m_slots[i].guid == guid) return false;
+        }
+        m_slots[i] = { guid, index };
+        ++m_count;
+        return true;
+    }
+
+    void erase(uint64_t guid) {
+        if (guid == 0 || m_slots.empty()) return;
+        const size_t mask = m_slots.size() - 1;
+        size_t hole = home(guid);
+        for (; m_slots[hole].guid != guid; hole = (hole + 1) & mask) {
+            if (m_slots[hole].guid == 0) return;
+        }
+
+        // Backward shift: pull later entries of the probe run into the hole
+        // unless that would move one in front of its home slot
+        for (size_t i = (hole + 1) & mask; m_slots[i].guid != 0; i = (i + 1) & mask) {
+            const size_t h = home(m_slots[i].guid);
+            const bool reachable = hole <= i ? (h <= hole || h > i) : (h <= hole && h > i);
+            if (reachable) {
+                m_slots[hole] = m_slots[i];
+                hole = i;
+            }
+        }
+        m_slots[hole] = {};
+        --m_count;
+    }
+
+private:
+    struct Slot {
+        uint64_t guid = 0;
+        uint32_t index = 0;
+    };
+
+    size_t home(uint64_t guid) const {
+        // Saved GUIDs are random, but mix anyway: hand-written files need not be
+        return static_cast<size_t>((guid * 0x9E3779B97F4A7C15ull) >> 32) & (m_slots.size() - 1);
+    }
+
+    void grow() {
+        std::vector<Slot> old(m_slots.empty() ? 64 : m_slots.size() * 2);
+        old.swap(m_slots);
+        m_count = 0;
+        for (const Slot& slot : old) {
+            if (slot.guid != 0) insert(slot.guid, slot.index);
+        }
+    }
+
+    std::vector<Slot> m_slots;      // power-of-two size, at most 3/4 full
+    size_t m_count = 0;
+};
@@ -0,0 +1,183 @@
+#include "PrefabManager.hpp"
+#include "EntityManager.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+int Prefab::find(ComponentType type) const {
+    for (size_t i = 0; i < components.size(); ++i) {
+        if (components[i]->getType() == type) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+PrefabManager& PrefabManager::get() {
+    static PrefabManager instance;
+    return instance;
+}
+
+namespace {
+    namespace fs = std::filesystem;
+
+    fs::path absoluteDir(const std::string& dir) {
+        std::error_code ec;
+        fs::path p = fs::absolute(fs::path(dir.empty() ? "." : dir), ec).lexically_normal();
+        if (!p.has_filename()) p = p.parent_path();     // drop the trailing separator "x/." leaves
+        return p;
+    }
+
+    fs::path absoluteFile(const std::string& path) {
+        std::error_code ec;
+        return fs::absolute(fs::path(path), ec).lexically_normal();
+    }
+
+    fs::path resolve(const std::string& id, const fs::path& dir) {
+        fs::path p(id);
+        if (p.is_relative()) p = dir / p;
+        return p.lexically_normal();
+    }
+
+    std::string relativeTo(const fs::path& file, const fs::path& dir) {
+        fs::path rel = file.lexically_relative(dir);
+        return (rel.empty() ? file : rel).generic_string();    // other drive: stays absolute
+    }
+}
+
+void PrefabManager::setProjectDir(const std::string& dir) {
+    fs::path abs = absoluteDir(dir);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_projectDir = std::move(abs);
+}
+
+std::string PrefabManager::idForPath(const std::string& path) const {
+    const fs::path file = absoluteFile(path);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return relativeTo(file, m_projectDir);
+}
+
+std::string PrefabManager::pathForId(const std::string& id) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return resolve(id, m_projectDir).generic_string();
+}
+
+void PrefabManager::rebaseIds(nlohmann::json& j, const std::string& dir) const {
+    const fs::path to = absoluteDir(dir);
+    fs::path from;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        from = m_projectDir;
+    }
+    if (to == from) return;
+
+    auto rebase = [&](auto& self, nlohmann::json& node) -> void {
+        auto meta = node.find("_meta");
+        if (meta != node.end() && meta->contains("prefab")) {
+            auto& id = (*meta)["prefab"];
+            id = relativeTo(resolve(id.get<std::string>(), from), to);
+        }
+        if (auto children = node.find("children"); children != node.end()) {
+            for (auto& child : *children) self(self, child);
+        }
+    };
+    rebase(rebase, j);
+}
+
+std::shared_ptr<const Prefab> PrefabManager::load(const std::string& id) {
+    const std::string path = pathForId(id);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_prefabs.find(path);
+        if (it != m_prefabs.end()) return it->second;
+    }
+
+    std::ifstream in(path);
+    if (!in.is_open()) {
+        std::cerr << "[PrefabManager] Failed to open prefab: " << path << "\n";
+        return nullptr;
+    }
+    nlohmann::json j;
+    try {
+        in >> j;
+    } catch (const std::exception& ex) {
+        std::cerr << "[PrefabManager] Failed to parse " << path << ": " << ex.what() << "\n";
+        return nullptr;
+    }
+    return fromJson(path, j);
+}
+
+std::shared_ptr<const Prefab> PrefabManager::fromJson(const std::string& path, const nlohmann::json& j) {
+    auto prefab = std::make_shared<Prefab>();
+    prefab->path = path;
+    if (j.contains("_meta")) {
+        prefab->name = j["_meta"].value("name", "");
+        prefab->type = static_cast<EntityType>(j["_meta"].value("type", 0));
+    }
+
+    if (j.contains("components")) {
+        for (const auto& compJ : j["components"]) {
+            if (!compJ.contains("type")) continue;
+            ComponentType type;
+            try {
+                type = ComponentTypeRegistry::getTypeFromString(compJ["type"].get<std::string>());
+            } catch (const std::exception& ex) {
+                std::cerr << "[PrefabManager] " << path << ": " << ex.what() << "\n";
+                continue;
+            }
+            const auto* reg = ComponentTypeRegistry::getInfo(type);
+            if (!reg || !reg->loader || prefab->find(type) >= 0) continue;
+
+            std::shared_ptr<ComponentBase> comp = reg->loader(compJ);
+            if (!comp) continue;
+            comp->m_cowOwner.store(ComponentBase::COW_FROZEN, std::memory_order_relaxed);
+            prefab->components.push_back(std::move(comp));
+        }
+    }
+
+    std::sort(prefab->components.begin(), prefab->components.end(), [](const auto& a, const auto& b) {
+        return a->getType() < b->getType();
+    });
+
+    std::shared_ptr<const Prefab> result = std::move(prefab);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_prefabs[path] = result;
+    return result;
+}
+
+std::shared_ptr<const Prefab> PrefabManager::saveEntityAsPrefab(Entity e, const std::string& path) {
+    const EntityManager& em = EntityManager::get();     // const: reading must not un-share anything
+    const EntityMeta* meta = em.getMeta(e);
+    if (!meta) return nullptr;
+
+    nlohmann::json j;
+    j["_meta"] = {
+        {"name", meta->name},
+        {"type", static_cast<int>(meta->type)},
+    };
+    j["components"] = nlohmann::json::array();
+    for (ComponentType type : ComponentTypeRegistry::getRegisteredTypes()) {
+        auto comp = em.getComponent(e, type);
+        if (!comp) continue;
+        nlohmann::json compJson = comp->toJson();
+        compJson["type"] = ComponentTypeRegistry::getInfo(type)->key;
+        j["components"].push_back(compJson);
+    }
+
+    const std::string file = absoluteFile(path).generic_string();
+    std::ofstream out(file);
+    if (!out.is_open()) {
+        std::cerr << "[PrefabManager] Failed to write prefab: " << file << "\n";
+        return nullptr;
+    }
+    out << j.dump(4);
+    out.close();
+
+    std::cout << "[PrefabManager] Saved prefab " << file << "\n";
+    return fromJson(file, j);
+}
+
+void PrefabManager::clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_prefabs.clear();
+}
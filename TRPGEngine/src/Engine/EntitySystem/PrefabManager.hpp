@@ -0,0 +1,63 @@
+#pragma once
+
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <json.hpp>
+
+#include "Entity.hpp"
+#include "ComponentBase.hpp"
+
+/**
+ * A loaded .prefab asset. Its components are shared by every instance and
+ * never written: an instance that edits one gets its own copy first (see
+ * EntityManager::forkFrom for the copy-on-write rules).
+ */
+struct Prefab {
+    std::string path;               // absolute file path; instances' _meta stores its id (PrefabManager::idForPath)
+    std::string name;
+    EntityType type = EntityType::Default;
+    std::vector<std::shared_ptr<ComponentBase>> components;    // ComponentType order
+
+    // Index into components, or -1
+    int find(ComponentType type) const;
+};
+
+/**
+ * Process-wide cache of prefab assets, shared by every World. A .prefab file
+ * has the same layout as an .entity file (_meta + components); children are
+ * not part of a prefab.
+ */
+class PrefabManager {
+public:
+    static PrefabManager& get();
+
+    // Cached; nullptr if the file is missing or unreadable
+    std::shared_ptr<const Prefab> load(const std::string& id);
+    std::shared_ptr<const Prefab> fromJson(const std::string& path, const nlohmann::json& j);
+
+    // Writes `e`'s metadata and components as a prefab and reloads the cache entry
+    std::shared_ptr<const Prefab> saveEntityAsPrefab(Entity e, const std::string& path);
+
+    // Drops cached prefabs; instances keep the ones they use alive
+    void clear();
+
+    // Prefab ids are paths relative to the project folder, so a project can be
+    // moved or opened from any working directory
+    void setProjectDir(const std::string& dir);
+    std::string idForPath(const std::string& path) const;
+    std::string pathForId(const std::string& id) const;
+
+    // Rewrites the prefab ids in a serialized entity tree for a file saved in `dir`
+    void rebaseIds(nlohmann::json& j, const std::string& dir) const;
+
+private:
+    PrefabManager() = default;
+
+    mutable std::mutex m_mutex;     // worlds can load on different threads
+    std::filesystem::path m_projectDir;     // absolute
+    std::unordered_map<std::string, std::shared_ptr<const Prefab>> m_prefabs;
+};
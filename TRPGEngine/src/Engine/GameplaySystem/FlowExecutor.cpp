@@ -4,15 +4,26 @@
 #include "Engine/EntitySystem/Components/UIButtonComponent.hpp"
 #include "Engine/EntitySystem/Components/FlowNodeComponent.hpp"
 #include "Engine/RenderSystem/SceneManager.hpp"
+#include "Engine/World.hpp"
 // + include Choice/Dice to detect interactive events
 #include "Engine/EntitySystem/Components/ChoiceComponent.hpp"
 #include "Engine/EntitySystem/Components/DiceRollComponent.hpp"
 #include "Engine/EntitySystem/Components/ProjectMetaComponent.hpp"
 #include "Project/ProjectManager.hpp"
+#include <charconv>
+
+Entity parseEventTarget(std::string_view target) {
+    constexpr std::string_view tag = "@Event:";
+    if (target.substr(0, tag.size()) != tag) return INVALID_ENTITY;
+    target.remove_prefix(tag.size());
+    Entity id = INVALID_ENTITY;
+    auto [end, ec] = std::from_chars(target.data(), target.data() + target.size(), id);
+    if (ec != std::errc() || end != target.data() + target.size()) return INVALID_ENTITY;
+    return id;
+}
 
 FlowExecutor& FlowExecutor::get() {
-    static FlowExecutor inst;
-    return inst;
+    return World::current().flow();
 }
 
 void FlowExecutor::reset() {
@@ -81,25 +92,21 @@ bool FlowExecutor::handleDialogue(Entity entity) {
         // If target set, first try in-scene @Event: jump, else scene by name
         if (!comp->targetFlowNode.empty()) {
             // In-scene jump: @Event:ID
-            const std::string tag = "@Event:";
-            if (comp->targetFlowNode.rfind(tag, 0) == 0) {
-                try {
-                    Entity jumpTo = (Entity)std::stoull(comp->targetFlowNode.substr(tag.size()));
-                    // find index in current node's eventSequence
-                    auto node = em.getComponent<FlowNodeComponent>(m_activeFlowNode);
-                    if (node) {
-                        for (int i = 0; i < (int)node->eventSequence.size(); ++i) {
-                            if (node->eventSequence[i] == jumpTo) {
-                                // Jump to that event index (no advance increment)
-                                m_currentEventIndex = i;
-                                m_lastEvent = INVALID_ENTITY; // force re-eval next tick
-                                return false;
-                            }
+            if (comp->targetFlowNode.startsWith("@Event:")) {
+                Entity jumpTo = parseEventTarget(comp->targetFlowNode.str());
+                // find index in current node's eventSequence
+                auto node = em.getComponent<FlowNodeComponent>(m_activeFlowNode);
+                if (node && jumpTo != INVALID_ENTITY) {
+                    for (int i = 0; i < (int)node->eventSequence.size(); ++i) {
+                        if (node->eventSequence[i] == jumpTo) {
+                            // Jump to that event index (no advance increment)
+                            m_currentEventIndex = i;
+                            m_lastEvent = INVALID_ENTITY; // force re-eval next tick
+                            return false;
                         }
                     }
-                } catch (...) {
-                    // fall back to default advance
                 }
+                // fall back to default advance
             } else {
                 // Scene by name
                 Entity next = findFlowNodeByName(comp->targetFlowNode);
@@ -129,22 +136,19 @@ bool FlowExecutor::handleUIButton(Entity entity) {
 
         // First try in-scene event jump via @Event:ID
         if (!comp->targetFlowNode.empty()) {
-            const std::string tag = "@Event:";
-            if (comp->targetFlowNode.rfind(tag, 0) == 0) {
-                try {
-                    Entity jumpTo = (Entity)std::stoull(comp->targetFlowNode.substr(tag.size()));
-                    if (auto node = em.getComponent<FlowNodeComponent>(m_activeFlowNode)) {
-                        for (int i = 0; i < (int)node->eventSequence.size(); ++i) {
-                            if (node->eventSequence[i] == jumpTo) {
-                                m_currentEventIndex = i;
-                                m_lastEvent = INVALID_ENTITY; // force re-eval next tick
-                                return false;
-                            }
+            if (comp->targetFlowNode.startsWith("@Event:")) {
+                Entity jumpTo = parseEventTarget(comp->targetFlowNode.str());
+                auto node = em.getComponent<FlowNodeComponent>(m_activeFlowNode);
+                if (node && jumpTo != INVALID_ENTITY) {
+                    for (int i = 0; i < (int)node->eventSequence.size(); ++i) {
+                        if (node->eventSequence[i] == jumpTo) {
+                            m_currentEventIndex = i;
+                            m_lastEvent = INVALID_ENTITY; // force re-eval next tick
+                            return false;
                         }
                     }
-                } catch (...) {
-                    // fall through to scene-name/default
                 }
+                // fall through to default
             } else {
                 // Scene by name
                 Entity next = findFlowNodeByName(comp->targetFlowNode);
@@ -203,11 +207,10 @@ void FlowExecutor::advanceEvent() {
     }
 }
 
-Entity FlowExecutor::findFlowNodeByName(const std::string& name) {
-    auto& em = EntityManager::get();
-    for (Entity e : em.getAllEntities()) {
-        auto node = em.getComponent<FlowNodeComponent>(e);
-        if (node && node->name == name)
+Entity FlowExecutor::findFlowNodeByName(Atom name) {
+    if (name.empty()) return INVALID_ENTITY;
+    for (auto [e, node] : EntityManager::get().view<FlowNodeComponent>()) {
+        if (node.name == name)
             return e;
     }
     return INVALID_ENTITY;
@@ -228,4 +231,15 @@ Entity FlowExecutor::currentEventEntity() const {
 
 bool FlowExecutor::eventCompleted() const {
     return m_eventCompleted;
-}
\ No newline at end of file
+}
+
+FlowExecutor::State FlowExecutor::getState() const {
+    return { m_activeFlowNode, m_currentEventIndex, m_lastEvent, m_eventCompleted };
+}
+
+void FlowExecutor::setState(const State& state) {
+    m_activeFlowNode = state.flowNode;
+    m_currentEventIndex = state.eventIndex;
+    m_lastEvent = state.lastEvent;
+    m_eventCompleted = state.eventCompleted;
+}
@@ -1,9 +1,16 @@
 #pragma once
 #include "Engine/EntitySystem/Entity.hpp"
+#include "Core/Atom.hpp"
 #include <string>
+#include <string_view>
+
+// Link targets of the form "@Event:<id>" jump to an event within the current
+// flow node; returns INVALID_ENTITY for anything else (e.g. a flow node name)
+Entity parseEventTarget(std::string_view target);
 
 class FlowExecutor {
 public:
+    // Flow state of World::current()
     static FlowExecutor& get();
 
     void reset();
@@ -15,7 +22,20 @@ public:
     Entity currentEventEntity() const;
     bool eventCompleted() const;
 
+    // Where the flow stands, for save games (SaveGame)
+    struct State {
+        Entity flowNode = INVALID_ENTITY;
+        int eventIndex = 0;
+        Entity lastEvent = INVALID_ENTITY;
+        bool eventCompleted = false;
+    };
+    State getState() const;
+    void setState(const State& state);
+
 private:
+    friend class World;
+    FlowExecutor() = default;
+
     Entity m_activeFlowNode = INVALID_ENTITY;
     int m_currentEventIndex = 0;
     Entity m_lastEvent = INVALID_ENTITY;
@@ -27,5 +47,5 @@ private:
     bool handleDialogue(Entity);
     bool handleUIButton(Entity);
 
-    Entity findFlowNodeByName(const std::string& name);
+    Entity findFlowNodeByName(Atom name);
 };
@@ -1,35 +1,74 @@
 #include "GameInstance.hpp"
 #include "Engine/EntitySystem/EntityManager.hpp"
+#include "Engine/EntitySystem/Components/DiceRollComponent.hpp"
 #include "Engine/EntitySystem/Components/ProjectMetaComponent.hpp"
 #include "Engine/RenderSystem/SceneManager.hpp"
 #include "FlowExecutor.hpp"
+#include "GameplaySystems.hpp"
+#include "Engine/World.hpp"
+
+#include <algorithm>
+#include <random>
 
 GameInstance& GameInstance::get() {
-    static GameInstance instance;
-    return instance;
+    return World::current().game();
 }
 
 void GameInstance::startGame() {
-    auto& em = EntityManager::get();
-
-    for (auto e : em.getAllEntities()) {
-        auto proj = em.getComponent<ProjectMetaComponent>(e);
-        if (proj && proj->startNode != INVALID_ENTITY) {
-            FlowExecutor::get().reset();
-            SceneManager::get().setCurrentFlowNode(proj->startNode);
-            GameInstance::get().reset();
+    auto& em = m_world.entities();
+
+    for (auto [e, proj] : em.view<ProjectMetaComponent>()) {
+        if (proj.startNode != INVALID_ENTITY) {
+            m_world.flow().reset();
+            m_world.scene().setCurrentFlowNode(proj.startNode);
+            reset();
+            m_randomState = (uint64_t(std::random_device{}()) << 32) ^ std::random_device{}();
+            m_variables.clear();
+            registerSystems();
             m_running = true;
             return;
         }
     }
 }
 
+// splitmix64: one word of state, which is all a save game has to store
+int GameInstance::roll(int sides) {
+    uint64_t z = (m_randomState += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    z ^= z >> 31;
+    return 1 + static_cast<int>(z % static_cast<uint64_t>(std::max(1, sides)));
+}
+
+int GameInstance::rollDice(const DiceRollComponent& dice) {
+    const int result = roll(dice.sides);
+    if (!dice.resultVariable.empty()) m_variables[dice.resultVariable] = result;
+    return result;
+}
+
+int GameInstance::getVariable(Atom name) const {
+    auto it = m_variables.find(name);
+    return it != m_variables.end() ? it->second : 0;
+}
+
 void GameInstance::update(float deltaTime) {
     if (!m_running) return;
-    FlowExecutor::get().tick();
+    m_scheduler.update(m_world, deltaTime);
+}
+
+// Flow first: it may rewrite any component, so every other system orders after it.
+// Update systems only for types that have an Update(): each one makes its whole
+// type writable every frame, which copies it out of the forked project.
+void GameInstance::registerSystems() {
+    m_scheduler.clear();
+    m_scheduler.addSystem<FlowExecutorSystem>();
+    for (ComponentType type : ComponentTypeRegistry::getRegisteredTypes()) {
+        const auto* info = ComponentTypeRegistry::getInfo(type);
+        if (info && info->updates) m_scheduler.addSystem<ComponentUpdateSystem>(type);
+    }
 }
 
 void GameInstance::reset() {
     m_running = false;
-    FlowExecutor::get().reset();
+    m_world.flow().reset();
 }
@@ -1,8 +1,16 @@
 #pragma once
 #include "Engine/EntitySystem/Entity.hpp"
+#include "Core/Atom.hpp"
+#include "SystemScheduler.hpp"
+#include <cstdint>
+#include <unordered_map>
+
+class World;
+struct DiceRollComponent;
 
 class GameInstance {
 public:
+    // Game instance of World::current()
     static GameInstance& get();
 
     void startGame();             // Called when "Run" is pressed
@@ -11,6 +19,33 @@ public:
 
     bool isRunning() const { return m_running; }
 
+    SystemScheduler& getScheduler() { return m_scheduler; }
+
+    // 1..sides. Every roll of a game comes from one generator, reseeded by
+    // startGame(), so a save game restores the rolls to come as well.
+    int roll(int sides);
+    // roll(dice.sides), kept in the dice's result variable if it names one
+    int rollDice(const DiceRollComponent& dice);
+    uint64_t getRandomState() const { return m_randomState; }
+    void setRandomState(uint64_t state) { m_randomState = state; }
+
+    // Story variables: named values the story sets (dice results); 0 until set
+    int getVariable(Atom name) const;
+    void setVariable(Atom name, int value) { m_variables[name] = value; }
+    const std::unordered_map<Atom, int, AtomHash>& getVariables() const { return m_variables; }
+    void setVariables(std::unordered_map<Atom, int, AtomHash> variables) { m_variables = std::move(variables); }
+
+    World& getWorld() { return m_world; }
+
 private:
+    friend class World;
+    explicit GameInstance(World& world) : m_world(world) {}
+
+    void registerSystems();
+
+    World& m_world;
     bool m_running = false;
+    SystemScheduler m_scheduler;
+    uint64_t m_randomState = 0;
+    std::unordered_map<Atom, int, AtomHash> m_variables;
 };
@@ -0,0 +1,33 @@
+#include "GameplaySystems.hpp"
+#include "FlowExecutor.hpp"
+#include "Engine/EntitySystem/EntityManager.hpp"
+#include "Engine/World.hpp"
+
+ComponentUpdateSystem::ComponentUpdateSystem(ComponentType type)
+    : m_type(type) {
+    writes(type);
+}
+
+std::string ComponentUpdateSystem::getName() const {
+    const auto* info = ComponentTypeRegistry::getInfo(m_type);
+    return "ComponentUpdate(" + (info ? info->key : std::to_string(static_cast<int>(m_type))) + ")";
+}
+
+void ComponentUpdateSystem::update(World& world, float deltaTime) {
+    for (const Archetype& arch : world.entities().getArchetypes()) {
+        const Archetype::Column* col = arch.column(m_type);
+        if (!col) continue;
+        for (const auto& comp : *col) {
+            comp->Update(deltaTime);
+        }
+    }
+}
+
+FlowExecutorSystem::FlowExecutorSystem() {
+    runOnMainThread();
+    writesAll();
+}
+
+void FlowExecutorSystem::update(World& world, float) {
+    world.flow().tick();
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <string>
+
+#include "SystemScheduler.hpp"
+
+// Calls ComponentBase::Update on every component of one type. One instance per
+// type that overrides it, so different types update in parallel.
+class ComponentUpdateSystem : public System {
+public:
+    explicit ComponentUpdateSystem(ComponentType type);
+
+    std::string getName() const override;
+    void update(World& world, float deltaTime) override;
+
+private:
+    ComponentType m_type;
+};
+
+// Advances the world's flow graph. Touches scene/UI state, so it runs on the
+// thread calling update() and is ordered before everything registered after it.
+class FlowExecutorSystem : public System {
+public:
+    FlowExecutorSystem();
+
+    std::string getName() const override { return "FlowExecutor"; }
+    void update(World& world, float deltaTime) override;
+};
@@ -0,0 +1,337 @@
+#include "SaveGame.hpp"
+#include "FlowExecutor.hpp"
+#include "GameInstance.hpp"
+#include "Core/ByteStream.hpp"
+#include "Core/Compression.hpp"
+#include "Engine/World.hpp"
+#include "Engine/EntitySystem/Archetype.hpp"
+#include "Engine/EntitySystem/ComponentBase.hpp"
+#include "Engine/EntitySystem/EntityManager.hpp"
+#include "Engine/RenderSystem/SceneManager.hpp"
+#include "Project/ProjectManager.hpp"
+#include "Project/SceneStreamer.hpp"
+
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+namespace fs = std::filesystem;
+
+namespace {
+    constexpr char MAGIC[8] = { 'T', 'R', 'P', 'G', 'S', 'A', 'V', 'E' };
+    constexpr uint32_t FLAG_COMPRESSED = 1;
+
+    struct Header {
+        uint32_t version = 0;
+        uint32_t flags = 0;
+        uint32_t storedSize = 0;
+        uint32_t rawSize = 0;
+        uint64_t project = 0;
+        uint32_t checksum = 0;
+        int64_t savedAt = 0;
+    };
+    // magic, version, flags, stored size, raw size, project, checksum, savedAt
+    constexpr size_t HEADER_SIZE = 8 + 4 * 4 + 8 + 4 + 8;
+
+    uint32_t fnv1a(const uint8_t* data, size_t size) {
+        uint32_t h = 2166136261u;
+        for (size_t i = 0; i < size; ++i) {
+            h ^= data[i];
+            h *= 16777619u;
+        }
+        return h;
+    }
+
+    uint64_t projectGuid(const EntityManager& em) {
+        return em.getGuid(ProjectManager::getProjectMetaEntity());
+    }
+
+    void writeHeader(ByteWriter& w, const Header& h) {
+        w.bytes(MAGIC, sizeof(MAGIC));
+        w.u32(h.version);
+        w.u32(h.flags);
+        w.u32(h.storedSize);
+        w.u32(h.rawSize);
+        w.u64(h.project);
+        w.u32(h.checksum);
+        w.pod(h.savedAt);
+    }
+
+    // False if the data does not start with a save game header
+    bool readHeader(ByteReader& r, Header& h) {
+        if (r.remaining() < HEADER_SIZE || std::memcmp(r.bytes(sizeof(MAGIC)), MAGIC, sizeof(MAGIC)) != 0)
+            return false;
+        h.version = r.u32();
+        h.flags = r.u32();
+        h.storedSize = r.u32();
+        h.rawSize = r.u32();
+        h.project = r.u64();
+        h.checksum = r.u32();
+        h.savedAt = r.pod<int64_t>();
+        return true;
+    }
+
+    void writePayload(ByteWriter& w, const EntityManager& em, const FlowExecutor::State& flow, const GameInstance& game) {
+        w.u64(em.getGuid(flow.flowNode));
+        w.u32(static_cast<uint32_t>(flow.eventIndex));
+        w.u64(em.getGuid(flow.lastEvent));
+        w.u8(flow.eventCompleted ? 1 : 0);
+
+        w.u64(game.getRandomState());
+
+        w.u32(static_cast<uint32_t>(game.getVariables().size()));
+        for (const auto& [name, value] : game.getVariables()) {
+            w.string(name.str());
+            w.pod(static_cast<int32_t>(value));
+        }
+
+        const size_t blockCountAt = w.reserveU32();
+        uint32_t blockCount = 0;
+        for (size_t t = 0; t < COMPONENT_TYPE_COUNT; ++t) {
+            const auto* info = ComponentTypeRegistry::getInfo(static_cast<int>(t));
+            if (!info || !info->encodeState) continue;
+            const ComponentType type = static_cast<ComponentType>(t);
+
+            w.string(info->key);
+            const size_t rowCountAt = w.reserveU32();
+            uint32_t rowCount = 0;
+            for (const Archetype& archetype : em.getArchetypes()) {
+                const Archetype::Column* column = archetype.column(type);
+                if (!column) continue;
+                for (size_t row = 0; row < archetype.size(); ++row) {
+                    const uint64_t guid = em.getGuid(archetype.entities()[row]);
+                    if (!guid || !(*column)[row]) continue;
+                    w.u64(guid);
+                    info->encodeState(*(*column)[row], w);
+                    ++rowCount;
+                }
+            }
+            w.patchU32(rowCountAt, rowCount);
+            ++blockCount;
+        }
+        w.patchU32(blockCountAt, blockCount);
+    }
+
+    void skipRecord(ByteReader& r) {
+        r.bytes(r.u32());
+    }
+
+    void applyPayload(World& world, ByteReader& r) {
+        EntityManager& em = world.entities();
+        SceneStreamer& streamer = SceneStreamer::get();
+
+        FlowExecutor::State flow;
+        flow.flowNode = em.findByGuid(r.u64());
+        flow.eventIndex = static_cast<int>(r.u32());
+        flow.lastEvent = em.findByGuid(r.u64());
+        flow.eventCompleted = r.u8() != 0;
+        const uint64_t randomState = r.u64();
+
+        std::unordered_map<Atom, int, AtomHash> variables;
+        const uint32_t variableCount = r.u32();
+        variables.reserve(variableCount);
+        for (uint32_t i = 0; i < variableCount; ++i) {
+            const Atom name(r.string());
+            variables[name] = r.pod<int32_t>();
+        }
+
+        // The node first: in a lazily loaded project this pages its scene in
+        world.scene().setCurrentFlowNode(flow.flowNode);
+
+        size_t skipped = 0;
+        const uint32_t blockCount = r.u32();
+        for (uint32_t b = 0; b < blockCount; ++b) {
+            const std::string_view key = r.string();
+            const uint32_t rowCount = r.u32();
+            const ComponentTypeRegistry::RegisteredComponent* info = nullptr;
+            ComponentType type = ComponentType::Count;
+            try {
+                type = ComponentTypeRegistry::getTypeFromString(key);
+                info = ComponentTypeRegistry::getInfo(type);
+            } catch (const std::runtime_error&) {}
+            if (!info || !info->decodeState) {
+                std::cerr << "[SaveGame] Skipping state of unknown component '" << key << "'\n";
+                for (uint32_t i = 0; i < rowCount; ++i) { r.u64(); skipRecord(r); }
+                continue;
+            }
+
+            for (uint32_t i = 0; i < rowCount; ++i) {
+                const Entity e = em.findByGuid(r.u64());
+                if (e != INVALID_ENTITY && !em.hasComponent(e, type)) streamer.pageIn(em, e);
+                if (e == INVALID_ENTITY || !em.hasComponent(e, type)) {
+                    skipRecord(r);
+                    ++skipped;
+                    continue;
+                }
+                info->decodeState(*em.getComponent(e, type), r);
+                em.markDirty(e, type);
+            }
+        }
+        if (skipped > 0)
+            std::cerr << "[SaveGame] Skipped " << skipped << " entries the project no longer has\n";
+
+        world.flow().setState(flow);
+        world.game().setRandomState(randomState);
+        world.game().setVariables(std::move(variables));
+    }
+
+    bool readFile(const std::string& path, std::vector<uint8_t>& out) {
+        std::ifstream in(path, std::ios::binary | std::ios::ate);
+        if (!in.is_open()) return false;
+        out.resize(static_cast<size_t>(in.tellg()));
+        in.seekg(0);
+        in.read(reinterpret_cast<char*>(out.data()), static_cast<std::streamsize>(out.size()));
+        return static_cast<bool>(in);
+    }
+}
+
+namespace SaveGame {
+
+std::vector<uint8_t> capture(World& world, bool compress) {
+    World::Scope scope(world);
+    const EntityManager& em = world.entities();
+    const FlowExecutor::State flow = world.flow().getState();
+    const GameInstance& game = world.game();
+
+    // Sized first, then written once right behind the header
+    ByteWriter counter;
+    writePayload(counter, em, flow, game);
+    const size_t rawSize = counter.position();
+
+    std::vector<uint8_t> out(HEADER_SIZE + rawSize);
+    ByteWriter payload(out.data() + HEADER_SIZE, rawSize);
+    writePayload(payload, em, flow, game);
+
+    Header header;
+    header.version = VERSION;
+    header.rawSize = static_cast<uint32_t>(rawSize);
+    header.storedSize = header.rawSize;
+    if (compress) {
+        std::vector<uint8_t> packed = Compression::compress(out.data() + HEADER_SIZE, rawSize);
+        if (packed.size() < rawSize) {
+            std::memcpy(out.data() + HEADER_SIZE, packed.data(), packed.size());
+            out.resize(HEADER_SIZE + packed.size());
+            header.flags |= FLAG_COMPRESSED;
+            header.storedSize = static_cast<uint32_t>(packed.size());
+        }
+    }
+    header.project = projectGuid(em);
+    header.checksum = fnv1a(out.data() + HEADER_SIZE, header.storedSize);
+    header.savedAt = std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+
+    ByteWriter headerWriter(out.data(), HEADER_SIZE);
+    writeHeader(headerWriter, header);
+    return out;
+}
+
+bool restore(World& world, const uint8_t* data, size_t size) {
+    World::Scope scope(world);
+    try {
+        ByteReader reader(data, size);
+        Header header;
+        if (!readHeader(reader, header)) {
+            std::cerr << "[SaveGame] Not a save game\n";
+            return false;
+        }
+        if (header.version > VERSION) {
+            std::cerr << "[SaveGame] Save game version " << header.version << " is newer than this build reads\n";
+            return false;
+        }
+        if (header.storedSize != reader.remaining() || fnv1a(data + HEADER_SIZE, header.storedSize) != header.checksum) {
+            std::cerr << "[SaveGame] Save game is corrupt\n";
+            return false;
+        }
+        if (header.project != projectGuid(world.entities())) {
+            std::cerr << "[SaveGame] Save game belongs to another project\n";
+            return false;
+        }
+
+        std::vector<uint8_t> unpacked;
+        const uint8_t* payload = data + HEADER_SIZE;
+        if (header.flags & FLAG_COMPRESSED) {
+            unpacked.resize(header.rawSize);
+            if (!Compression::decompress(payload, header.storedSize, unpacked.data(), unpacked.size())) {
+                std::cerr << "[SaveGame] Save game is corrupt\n";
+                return false;
+            }
+            payload = unpacked.data();
+        }
+
+        ByteReader payloadReader(payload, header.rawSize);
+        applyPayload(world, payloadReader);
+        return true;
+    } catch (const std::exception& ex) {
+        std::cerr << "[SaveGame] Failed to restore save game: " << ex.what() << "\n";
+        return false;
+    }
+}
+
+std::string slotPath(int slot) {
+    const fs::path project = ProjectManager::getCurrentProjectPath();
+    return (project.parent_path() / "Saves" / ("slot" + std::to_string(slot) + EXTENSION)).string();
+}
+
+bool saveSlot(int slot, bool compress) {
+    World* session = World::getPlaySession();
+    if (!session) {
+        std::cerr << "[SaveGame] No game running to save\n";
+        return false;
+    }
+    const std::vector<uint8_t> bytes = capture(*session, compress);
+
+    // Written next to the slot and renamed over it, like project saves
+    const std::string path = slotPath(slot);
+    const std::string tempPath = path + ".tmp";
+    std::error_code ec;
+    fs::create_directories(fs::path(path).parent_path(), ec);
+    {
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        if (!out) {
+            std::cerr << "[SaveGame] Failed to write " << path << "\n";
+            return false;
+        }
+    }
+    fs::rename(tempPath, path, ec);
+    if (ec) {
+        std::cerr << "[SaveGame] Failed to replace " << path << ": " << ec.message() << "\n";
+        fs::remove(tempPath, ec);
+        return false;
+    }
+    return true;
+}
+
+bool loadSlot(int slot) {
+    World* session = World::getPlaySession();
+    if (!session) {
+        std::cerr << "[SaveGame] No game running to load into\n";
+        return false;
+    }
+    std::vector<uint8_t> bytes;
+    if (!readFile(slotPath(slot), bytes)) {
+        std::cerr << "[SaveGame] Failed to read " << slotPath(slot) << "\n";
+        return false;
+    }
+    return restore(*session, bytes.data(), bytes.size());
+}
+
+std::vector<SlotInfo> listSlots() {
+    std::vector<SlotInfo> slots(SLOT_COUNT);
+    for (int i = 0; i < SLOT_COUNT; ++i) {
+        slots[i].slot = i;
+        std::ifstream in(slotPath(i), std::ios::binary);
+        uint8_t bytes[HEADER_SIZE];
+        if (!in.read(reinterpret_cast<char*>(bytes), HEADER_SIZE)) continue;
+        ByteReader reader(bytes, HEADER_SIZE);
+        Header header;
+        if (!readHeader(reader, header)) continue;
+        slots[i].used = true;
+        slots[i].savedAt = header.savedAt;
+    }
+    return slots;
+}
+
+}
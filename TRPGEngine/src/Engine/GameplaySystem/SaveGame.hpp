@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class World;
+
+/**
+ * Save games (.trpgsave): only what a running game changes on top of the
+ * project, so loading one writes it into the play session in place instead
+ * of reloading the project.
+ *
+ *   Header   magic "TRPGSAVE", version, flags, payload size as stored and
+ *            uncompressed, guid of the project's meta entity, FNV-1a of the
+ *            stored payload, save time (seconds since the epoch)
+ *   Payload  flow position (node and last event by entity guid, event
+ *            index, completed flag), dice RNG state, story variables as
+ *            {name, value}, then one block per component type with a
+ *            stateFields() list: its key, a row count and {entity guid,
+ *            state record} rows
+ *
+ * With the Compressed flag the payload is one Compression block; capture()
+ * sets it only when that comes out smaller. Numbers are little-endian.
+ * Rows for entities the project no longer has are skipped, and entities a
+ * save does not list keep their state.
+ */
+namespace SaveGame {
+
+    constexpr uint32_t VERSION = 1;
+    constexpr const char* EXTENSION = ".trpgsave";
+    constexpr int SLOT_COUNT = 8;
+
+    std::vector<uint8_t> capture(World& world, bool compress = true);
+
+    // Checks the header and checksum before changing anything. False (and
+    // logged) for corrupt data, newer versions and other projects' saves.
+    bool restore(World& world, const uint8_t* data, size_t size);
+
+    struct SlotInfo {
+        int slot = 0;
+        bool used = false;
+        int64_t savedAt = 0;    // seconds since the epoch
+    };
+
+    // <project dir>/Saves/slot<N>.trpgsave
+    std::string slotPath(int slot);
+    // Slots of the current project's running play session
+    bool saveSlot(int slot, bool compress = true);
+    bool loadSlot(int slot);
+    std::vector<SlotInfo> listSlots();
+}
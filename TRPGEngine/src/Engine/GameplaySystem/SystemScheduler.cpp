@@ -0,0 +1,103 @@
+#include "SystemScheduler.hpp"
+#include "Core/JobSystem.hpp"
+#include "Engine/EntitySystem/EntityManager.hpp"
+#include "Engine/World.hpp"
+
+#include <exception>
+#include <iostream>
+
+bool System::conflictsWith(const System& other) const {
+    if (m_mainThreadOnly && other.m_mainThreadOnly) return true;    // would share one thread anyway
+    return (m_writes & (other.m_reads | other.m_writes)).any()
+        || (other.m_writes & m_reads).any();
+}
+
+void SystemScheduler::clear() {
+    m_systems.clear();
+}
+
+void SystemScheduler::update(World& world, float deltaTime) {
+    if (m_systems.empty()) return;
+
+    World::Scope scope(world);
+    for (auto& system : m_systems) {
+        system->prepare(world);
+        // Copy shared (forked) components now; workers must not replace column slots
+        if (!system->isMainThreadOnly()) world.entities().ensureWritable(system->getWrites());
+    }
+
+    if (m_serial || JobSystem::get().getWorkerCount() == 0) {
+        runSerial(world, deltaTime);
+    } else {
+        const Graph graph = buildGraph();
+        runParallel(world, deltaTime, graph);
+    }
+
+    // Structural changes, in registration order so results are deterministic
+    auto& em = world.entities();
+    for (auto& system : m_systems) {
+        if (!system->commands().empty()) system->commands().playback(em);
+    }
+}
+
+// Edge i -> j for every earlier system i that conflicts with j. Registration
+// order breaks ties, so the graph is acyclic and matches serial execution.
+SystemScheduler::Graph SystemScheduler::buildGraph() const {
+    const size_t n = m_systems.size();
+    Graph graph;
+    graph.dependencies.resize(n);
+
+    for (uint32_t j = 0; j < n; ++j) {
+        for (uint32_t i = 0; i < j; ++i) {
+            if (m_systems[i]->conflictsWith(*m_systems[j])) {
+                graph.dependencies[j].push_back(i);
+            }
+        }
+    }
+    return graph;
+}
+
+void SystemScheduler::runSerial(World& world, float deltaTime) {
+    for (auto& system : m_systems) {
+        runSystem(*system, world, deltaTime);
+    }
+}
+
+// Worker systems become jobs that depend on their predecessors' jobs. A
+// main-thread system is run inline once its predecessors are done; systems
+// registered after it are scheduled only then, so keep main-thread systems
+// early in the registration order.
+void SystemScheduler::runParallel(World& world, float deltaTime, const Graph& graph) {
+    JobSystem& jobs = JobSystem::get();
+    const size_t total = m_systems.size();
+
+    std::vector<JobSystem::JobHandle> handles(total);   // invalid handle == already finished
+    std::vector<JobSystem::JobHandle> deps;
+
+    for (uint32_t i = 0; i < total; ++i) {
+        deps.clear();
+        for (uint32_t d : graph.dependencies[i]) {
+            if (handles[d].valid()) deps.push_back(handles[d]);
+        }
+
+        System& system = *m_systems[i];
+        if (system.isMainThreadOnly()) {
+            jobs.waitAll(deps);
+            runSystem(system, world, deltaTime);
+        } else {
+            handles[i] = jobs.schedule([this, &system, &world, deltaTime] {
+                World::Scope scope(world);     // workers have no current world of their own
+                runSystem(system, world, deltaTime);
+            }, deps);
+        }
+    }
+    jobs.waitAll(handles);
+}
+
+void SystemScheduler::runSystem(System& system, World& world, float deltaTime) {
+    try {
+        system.update(world, deltaTime);
+    } catch (const std::exception& ex) {
+        std::cerr << "[SystemScheduler] " << system.getName() << " threw: " << ex.what() << "\n";
+    }
+}
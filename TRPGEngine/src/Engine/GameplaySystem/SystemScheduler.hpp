@@ -0,0 +1,104 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Engine/EntitySystem/Archetype.hpp"
+#include "Engine/EntitySystem/ComponentBase.hpp"
+#include "Engine/EntitySystem/EntityCommandBuffer.hpp"
+#include "Engine/EntitySystem/EntityView.hpp"
+
+class World;
+
+/**
+ * A unit of per-frame work over the ECS. Each system declares which component
+ * types it reads and writes; the scheduler uses that to decide which systems
+ * may run at the same time.
+ *
+ * Systems get the World they run in; that world is also World::current()
+ * while they run, on whichever thread. Systems running on workers must
+ * stick to read-only EntityManager calls and their declared component types. Structural changes go into commands(),
+ * which the scheduler applies on the main thread after the frame. New
+ * view<Ts...>() masks should be queried once in prepare() so the query cache
+ * is not modified during the parallel phase. Components of the declared write
+ * types are made writable (un-shared from any fork) before the frame starts.
+ */
+class System {
+public:
+    virtual ~System() = default;
+
+    virtual std::string getName() const = 0;
+    virtual void update(World& world, float deltaTime) = 0;
+
+    // Called on the thread calling SystemScheduler::update() before any system of the frame runs
+    virtual void prepare(World& /*world*/) {}
+
+    const ComponentMask& getReads() const { return m_reads; }
+    const ComponentMask& getWrites() const { return m_writes; }
+    bool isMainThreadOnly() const { return m_mainThreadOnly; }
+
+    bool conflictsWith(const System& other) const;
+
+    EntityCommandBuffer& commands() { return m_commands; }
+
+protected:
+    template <typename... Ts> void reads() { m_reads |= makeComponentMask<Ts...>(); }
+    template <typename... Ts> void writes() { m_writes |= makeComponentMask<Ts...>(); }
+    void reads(ComponentType t) { m_reads.set(static_cast<size_t>(t)); }
+    void writes(ComponentType t) { m_writes.set(static_cast<size_t>(t)); }
+    void writesAll() { m_writes.set(); }
+
+    // For systems that touch GL, ImGui or other main-thread-only singletons
+    void runOnMainThread() { m_mainThreadOnly = true; }
+
+private:
+    ComponentMask m_reads;
+    ComponentMask m_writes;
+    bool m_mainThreadOnly = false;
+    EntityCommandBuffer m_commands;
+};
+
+/**
+ * Runs registered systems once per frame. Two systems depend on each other
+ * when one writes a component type the other reads or writes; the earlier
+ * registered one then runs first. Independent systems run in parallel as
+ * JobSystem jobs, with the calling thread helping out. Serial mode runs
+ * everything in registration order on the calling thread, which is the same
+ * order the dependency graph enforces, for debugging.
+ */
+class SystemScheduler {
+public:
+    SystemScheduler() = default;
+
+    SystemScheduler(const SystemScheduler&) = delete;
+    SystemScheduler& operator=(const SystemScheduler&) = delete;
+
+    template <typename T, typename... Args>
+    T& addSystem(Args&&... args) {
+        auto system = std::make_unique<T>(std::forward<Args>(args)...);
+        T& ref = *system;
+        m_systems.push_back(std::move(system));
+        return ref;
+    }
+    void clear();
+
+    void update(World& world, float deltaTime);
+
+    void setSerial(bool serial) { m_serial = serial; }
+    bool isSerial() const { return m_serial; }
+    size_t getSystemCount() const { return m_systems.size(); }
+
+private:
+    struct Graph {
+        std::vector<std::vector<uint32_t>> dependencies;    // earlier systems each one waits for
+    };
+
+    Graph buildGraph() const;
+    void runSerial(World& world, float deltaTime);
+    void runParallel(World& world, float deltaTime, const Graph& graph);
+    void runSystem(System& system, World& world, float deltaTime);
+
+    std::vector<std::unique_ptr<System>> m_systems;
+    bool m_serial = false;
+};
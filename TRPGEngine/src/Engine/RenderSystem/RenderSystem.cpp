@@ -2,6 +2,7 @@
 #include "Engine/EntitySystem/EntityManager.hpp"
 #include "Engine/EntitySystem/Components/TransformComponent.hpp"
 #include "Engine/EntitySystem/Components/Transform2DComponent.hpp"
+#include "Engine/RenderSystem/TransformSystem.hpp"
 #include "Engine/EntitySystem/Components/CharacterComponent.hpp"
 #include "Engine/EntitySystem/Components/BackgroundComponent.hpp"
 #include "Engine/EntitySystem/Components/UIButtonComponent.hpp"
@@ -11,6 +12,7 @@
 #include "Engine/EntitySystem/Components/ModelComponent.hpp"
 // routing / executor / scene access
 #include "Engine/GameplaySystem/FlowExecutor.hpp"
+#include "Engine/GameplaySystem/GameInstance.hpp"
 #include "Engine/EntitySystem/Components/FlowNodeComponent.hpp"
 #include "Engine/EntitySystem/Components/ProjectMetaComponent.hpp"
 #include "Project/ProjectManager.hpp"
@@ -28,7 +30,6 @@
 #include <vector>
 #include <string>
 #include <algorithm>
-#include <random>
 #include <cstring>
 #include <cmath>
 #include <cctype>
@@ -70,14 +71,18 @@ static BackgroundQuad calcBackgroundQuad(Entity entity) {
 		quad.max = ImVec2(quad.min.x + dims.x, quad.min.y + dims.y);
 	};
 
+	// Placement comes from the cached world matrices, so parent transforms apply too
 	if (entity != INVALID_ENTITY) {
 		auto& em = EntityManager::get();
-		if (auto t2d = em.getComponent<Transform2DComponent>(entity)) {
-			applyTransform(t2d->scale.x, t2d->scale.y, t2d->position.x, t2d->position.y);
+		const auto& transforms = TransformSystem::get();
+		if (em.hasComponent(entity, ComponentType::Transform2D)) {
+			const glm::mat3& m = transforms.getWorldMatrix2D(entity);
+			applyTransform(glm::length(glm::vec2(m[0])), glm::length(glm::vec2(m[1])), m[2].x, m[2].y);
 			return quad;
 		}
-		if (auto t3d = em.getComponent<TransformComponent>(entity)) {
-			applyTransform(t3d->scale.x, t3d->scale.y, t3d->position.x, t3d->position.y);
+		if (em.hasComponent(entity, ComponentType::Transform)) {
+			const glm::mat4& m = transforms.getWorldMatrix(entity);
+			applyTransform(glm::length(glm::vec3(m[0])), glm::length(glm::vec3(m[1])), m[3].x, m[3].y);
 		}
 	}
 	return quad;
@@ -151,8 +156,8 @@ static void drawUITextBox(const std::string& text) {
 	dl->PopClipRect();
 }
 
-// Texture cache for background images
-static std::unordered_map<std::string, ImTextureID> s_bgTexCache;
+// Texture cache for background images, keyed by the image path as authored
+static std::unordered_map<Atom, ImTextureID, AtomHash> s_bgTexCache;
 static std::unordered_map<std::string, bool> s_bgTexLogState;
 static std::unordered_map<std::string, std::filesystem::path> s_assetFilenameCache;
 static Entity s_lastFlowNodeLogged = INVALID_ENTITY;
@@ -185,9 +190,9 @@ static void logBackgroundLoad(const std::string& key, bool success, const std::s
 
 // Public: allow invalidation if inspector changes the path
 void invalidateTexture(const std::string& key) {
+	s_bgTexCache.erase(Atom::find(key));
 	const std::string normalizedKey = normalizePath(sanitizeImagePath(key));
 	if (normalizedKey.empty()) return;
-	s_bgTexCache.erase(normalizedKey);
 	s_bgTexLogState.erase(normalizedKey);
 }
 
@@ -359,6 +364,10 @@ static std::filesystem::path findInRuntimeAssetsByName(const std::string& fileNa
 }
 
 static ImTextureID getTextureForPath(const std::string& imagePath) {
+	const Atom key(imagePath);
+	auto cached = s_bgTexCache.find(key);
+	if (cached != s_bgTexCache.end()) return cached->second;
+
 	const std::string cleanedInput = sanitizeImagePath(imagePath);
 	if (cleanedInput.empty()) return (ImTextureID)0;
 
@@ -384,6 +393,7 @@ static ImTextureID getTextureForPath(const std::string& imagePath) {
 		return ResourceUtils::getPlaceholderTexture();
 	}
 
+	s_bgTexCache[key] = tex;
 	return tex;
 }
 
@@ -407,7 +417,7 @@ static void drawSceneDebugConsole() {
 
 // Draw background for current scene (first background entity under FlowNode)
 void renderCurrentSceneBackground() {
-	auto& em = EntityManager::get();
+	const EntityManager& em = EntityManager::get();     // drawing only reads
 	Entity node = SceneManager::get().getCurrentFlowNode();
 	if (node == INVALID_ENTITY) return;
 
@@ -440,7 +450,7 @@ void renderCurrentSceneBackground() {
 		s_lastBackgroundList.assign(fn->backgroundEntities.begin(), fn->backgroundEntities.end());
 	}
 	if (fn->backgroundEntities.empty()) {
-		pushSceneDebug("FlowNode '" + fn->name + "' has no background entities", IM_COL32(255,200,160,255));
+		pushSceneDebug("FlowNode '" + fn->name.str() + "' has no background entities", IM_COL32(255,200,160,255));
 		s_lastBgEntity = INVALID_ENTITY;
 		s_lastBgImage.clear();
 		return;
@@ -492,7 +502,7 @@ void endScene() {
 }
 
 void renderEntityEditor(Entity e) {
-	auto& em = EntityManager::get();
+	const EntityManager& em = EntityManager::get();     // drawing only reads
  	// BackgroundComponent -> full-screen background
  	if (auto bg = em.getComponent<BackgroundComponent>(e)) {
  		ImTextureID tex = (ImTextureID)0;
@@ -538,10 +548,11 @@ void renderEntityEditor(Entity e) {
 
 void renderEntityRuntime(Entity e) {
 	auto& em = EntityManager::get();
+	const EntityManager& cem = em;     // const reads never unshare prefab or forked components
 
 	// Runtime rendering mirrors editor placeholders for now
 	// Background
-	if (auto bg = em.getComponent<BackgroundComponent>(e)) {
+	if (auto bg = cem.getComponent<BackgroundComponent>(e)) {
 		ImTextureID tex = (ImTextureID)0;
 		if (!bg->image.empty()) {
 			tex = getTextureForPath(bg->image);
@@ -551,40 +562,28 @@ void renderEntityRuntime(Entity e) {
 		return;
 	}
 	// Model
-	if (auto mdl = em.getComponent<ModelComponent>(e)) {
+	if (auto mdl = cem.getComponent<ModelComponent>(e)) {
 		// Model placeholder label
 		drawModelPlaceholder(e, "Model");
 		return;
 	}
 
 	// Helper: find FlowNode entity by name
-	auto findNodeByName = [&](const std::string& nodeName) -> Entity {
+	auto findNodeByName = [&](Atom nodeName) -> Entity {
 		if (nodeName.empty()) return INVALID_ENTITY;
 		Entity metaEntity = ProjectManager::getProjectMetaEntity();
-		auto base = em.getComponent(metaEntity, ComponentType::ProjectMetadata);
+		auto base = cem.getComponent(metaEntity, ComponentType::ProjectMetadata);
 		if (!base) return INVALID_ENTITY;
-		auto meta = std::static_pointer_cast<ProjectMetaComponent>(base);
+		auto meta = std::static_pointer_cast<const ProjectMetaComponent>(base);
 		for (Entity n : meta->sceneNodes) {
-			auto fn = em.getComponent<FlowNodeComponent>(n);
+			auto fn = cem.getComponent<FlowNodeComponent>(n);
 			if (fn && fn->name == nodeName) return n;
 		}
 		return INVALID_ENTITY;
 	};
 
-	// Helper: parse @Event:<id>
-	auto parseEventTag = [&](const std::string& s) -> Entity {
-		const std::string tag = "@Event:";
-		if (s.rfind(tag, 0) == 0) {
-			try {
-				uint64_t id = std::stoull(s.substr(tag.size()));
-				return (Entity)id;
-			} catch (...) { return INVALID_ENTITY; }
-		}
-		return INVALID_ENTITY;
-	};
-
 	// Dialogue: show text and Continue button (interactive)
-	if (auto dlg = em.getComponent<DialogueComponent>(e)) {
+	if (auto dlg = cem.getComponent<DialogueComponent>(e)) {
 		// Draw preview box inside Scene Panel window (no extra floating windows)
 		drawUITextBox(dlg->lines.empty() ? "(no lines)" : dlg->lines.front());
 
@@ -612,7 +611,7 @@ void renderEntityRuntime(Entity e) {
 				if (dlg->advanceOnClick) {
 					if (ImGui::Button("Continue")) {
 						// Mark triggered and advance via FlowExecutor
-						dlg->triggered = true;
+						em.getMutable<DialogueComponent>(e)->triggered = true;
 						FlowExecutor::get().tick();
 						// bind new scene if we ended the scene
 						FlowExecutor::get().tick();
@@ -627,7 +626,7 @@ void renderEntityRuntime(Entity e) {
 	}
 
 	// Choice: present options and route on click
-	if (auto ch = em.getComponent<ChoiceComponent>(e)) {
+	if (auto ch = cem.getComponent<ChoiceComponent>(e)) {
 		// Draw preview inside Scene Panel window
 		drawUITextBox(ch->options.empty() ? "(no options)" : ch->options.front().text);
 
@@ -659,13 +658,12 @@ void renderEntityRuntime(Entity e) {
 					if (ImGui::Button(baseText.c_str())) {
 						if (!target.empty()) {
 							if (target.rfind("@Event:", 0) == 0) {
- 								try {
- 									Entity ev = (Entity)std::stoull(target.substr(7));
+ 								Entity ev = parseEventTarget(target);
+ 								if (ev != INVALID_ENTITY)
  									if (EditorUI* ui = EditorUI::get()) ui->setSelectedEntity(ev);
- 								} catch (...) {}
  								FlowExecutor::get().tick(); // advance within scene
  							} else {
- 								Entity dst = findNodeByName(target);
+ 								Entity dst = findNodeByName(Atom::find(target));
  								if (dst != INVALID_ENTITY) {
  									SceneManager::get().setCurrentFlowNode(dst);
  									if (EditorUI* ui = EditorUI::get()) ui->setSelectedEntity(dst);
@@ -688,7 +686,7 @@ void renderEntityRuntime(Entity e) {
  	}
 
 	// DiceRoll: roll and route on success/failure
-	if (auto dr = em.getComponent<DiceRollComponent>(e)) {
+	if (auto dr = cem.getComponent<DiceRollComponent>(e)) {
 		// Draw preview inside Scene Panel window
 		drawUITextBox(std::string("Dice d") + std::to_string(dr->sides) + " >= " + std::to_string(dr->threshold));
 
@@ -705,15 +703,12 @@ void renderEntityRuntime(Entity e) {
 		if (ImGui::Begin("DiceControls", nullptr, ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoSavedSettings)) {
 			ImGui::Text("Roll d%d; success if >= %d", dr->sides, dr->threshold);
 			if (ImGui::Button("Roll")) {
-				int sides = (std::max)(1, dr->sides);
-				std::random_device rd; std::mt19937 gen(rd());
-				std::uniform_int_distribution<int> dist(1, sides);
-				int roll = dist(gen);
+				int roll = GameInstance::get().rollDice(*dr);
 				bool success = (roll >= dr->threshold);
-				const std::string& nextName = success ? dr->onSuccess : dr->onFailure;
+				const Atom nextName = success ? dr->onSuccess : dr->onFailure;
 
 				// handle routing
-				Entity evtTarget = parseEventTag(nextName);
+				Entity evtTarget = parseEventTarget(nextName.str());
 				if (evtTarget != INVALID_ENTITY) {
 					if (EditorUI* ui = EditorUI::get()) ui->setSelectedEntity(evtTarget);
 					FlowExecutor::get().tick(); // advance within scene
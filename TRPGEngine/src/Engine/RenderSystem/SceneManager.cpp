@@ -4,19 +4,23 @@
 #include "Engine/GameplaySystem/GameInstance.hpp"
 #include "Engine/GameplaySystem/FlowExecutor.hpp"
 #include "Engine/RenderSystem/RenderSystem.hpp"
+#include "Engine/RenderSystem/TransformSystem.hpp"
+#include "Engine/World.hpp"
 #include <iostream>
 #include <unordered_set>
+#include <utility>
 // Auto-select default scene for validation/preview
 #include "Engine/EntitySystem/Components/ProjectMetaComponent.hpp"
 #include "Project/ProjectManager.hpp"
+#include "Project/SceneStreamer.hpp"
 
 SceneManager& SceneManager::get() {
-    static SceneManager instance;
-    return instance;
+    return World::current().scene();
 }
 
 void SceneManager::setCurrentFlowNode(Entity node) {
     m_currentFlowNode = node;
+    SceneStreamer::get().request(EntityManager::get(), node);     // lazily loaded projects
     updateVisibleEntities();
     //std::cout << "[SceneManager] setCurrentFlowNode -> node: " << (unsigned)node << std::endl;
 }
@@ -26,12 +30,18 @@ Entity SceneManager::getCurrentFlowNode() const {
 }
 
 void SceneManager::updateVisibleEntities() {
-    auto& em = EntityManager::get();
+    const EntityManager& em = EntityManager::get();     // const reads never unshare prefab or forked components
     m_visibleEntities.clear();
     m_uiLayer.clear();
     m_objectLayer.clear();
 
     Entity node = m_currentFlowNode;
+    const bool previewRunning = (FlowExecutor::get().currentFlowNode() != INVALID_ENTITY);
+    m_builtForNode = node;
+    m_builtForVersion = em.getComponentVersion(node, ComponentType::FlowNode);
+    m_builtForRunning = GameInstance::get().isRunning() || previewRunning;
+    m_builtForEventIndex = FlowExecutor::get().currentEventIndex();
+
     auto fn = em.getComponent<FlowNodeComponent>(node);
     if (!fn) {
         return;
@@ -53,9 +63,8 @@ void SceneManager::updateVisibleEntities() {
         m_visibleEntities.insert(e);
 
     // Treat editor preview as "running" when FlowExecutor has an active node
-    const bool previewRunning = (FlowExecutor::get().currentFlowNode() != INVALID_ENTITY);
-    if (GameInstance::get().isRunning() || previewRunning) {
-        int idx = FlowExecutor::get().currentEventIndex();
+    if (m_builtForRunning) {
+        int idx = m_builtForEventIndex;
         if (idx < (int)fn->eventSequence.size()) {
             m_eventEntity = fn->eventSequence[idx];
             m_visibleEntities.insert(m_eventEntity);
@@ -70,6 +79,16 @@ void SceneManager::updateVisibleEntities() {
     //          << " eventEntity=" << (unsigned)m_eventEntity << std::endl;
 }
 
+// The visible set only depends on the current node's FlowNodeComponent and the
+// preview/event state, so skip the rebuild while none of those changed
+bool SceneManager::isVisibleSetStale() const {
+    const bool running = GameInstance::get().isRunning() || FlowExecutor::get().currentFlowNode() != INVALID_ENTITY;
+    return m_builtForNode != m_currentFlowNode
+        || m_builtForVersion != EntityManager::get().getComponentVersion(m_currentFlowNode, ComponentType::FlowNode)
+        || m_builtForRunning != running
+        || (running && m_builtForEventIndex != FlowExecutor::get().currentEventIndex());
+}
+
 const std::unordered_set<Entity>& SceneManager::getVisibleEntities() const {
     return m_visibleEntities;
 }
@@ -90,8 +109,8 @@ void SceneManager::renderEditorScene() {
     // Ensure a current FlowNode exists for end-to-end validation
     if (m_currentFlowNode == INVALID_ENTITY) {
         Entity meta = ProjectManager::getProjectMetaEntity();
-        if (auto base = EntityManager::get().getComponent(meta, ComponentType::ProjectMetadata)) {
-            auto pm = std::static_pointer_cast<ProjectMetaComponent>(base);
+        if (auto base = std::as_const(EntityManager::get()).getComponent(meta, ComponentType::ProjectMetadata)) {
+            auto pm = std::static_pointer_cast<const ProjectMetaComponent>(base);
             if (pm && !pm->sceneNodes.empty()) {
                 setCurrentFlowNode(pm->sceneNodes.front());
                 std::cout << "[SceneManager] Auto-selected default FlowNode for editor preview: "
@@ -99,7 +118,10 @@ void SceneManager::renderEditorScene() {
             }
         }
     }
-    updateVisibleEntities(); // ensure latest visibility while previewing
+    if (isVisibleSetStale()) {
+        updateVisibleEntities(); // ensure latest visibility while previewing
+    }
+    TransformSystem::get().update();
     for (Entity e : getVisibleEntities()) {
         RenderSystem::renderEntityEditor(e);
     }
@@ -109,8 +131,8 @@ void SceneManager::renderRuntimeScene() {
     // Ensure a current FlowNode exists for end-to-end validation
     if (m_currentFlowNode == INVALID_ENTITY) {
         Entity meta = ProjectManager::getProjectMetaEntity();
-        if (auto base = EntityManager::get().getComponent(meta, ComponentType::ProjectMetadata)) {
-            auto pm = std::static_pointer_cast<ProjectMetaComponent>(base);
+        if (auto base = std::as_const(EntityManager::get()).getComponent(meta, ComponentType::ProjectMetadata)) {
+            auto pm = std::static_pointer_cast<const ProjectMetaComponent>(base);
             if (pm && !pm->sceneNodes.empty()) {
                 setCurrentFlowNode(pm->sceneNodes.front());
                 std::cout << "[SceneManager] Auto-selected default FlowNode for runtime preview: "
@@ -118,10 +140,13 @@ void SceneManager::renderRuntimeScene() {
             }
         }
     }
-    updateVisibleEntities(); // ensure latest visibility while playing
+    if (isVisibleSetStale()) {
+        updateVisibleEntities(); // ensure latest visibility while playing
+    }
+    TransformSystem::get().update();
 
     // Draw backgrounds first (explicitly), then 3D objects, event UI, and finally the UI layer
-    if (auto node = EntityManager::get().getComponent<FlowNodeComponent>(m_currentFlowNode)) {
+    if (auto node = std::as_const(EntityManager::get()).getComponent<FlowNodeComponent>(m_currentFlowNode)) {
         for (Entity e : node->backgroundEntities) {
             if (e != INVALID_ENTITY) RenderSystem::renderEntityRuntime(e);
         }
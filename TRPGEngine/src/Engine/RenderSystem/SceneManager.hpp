@@ -1,11 +1,13 @@
 #pragma once
 
+#include <cstdint>
 #include <unordered_set>
 #include <vector>
 #include "Engine/EntitySystem/Entity.hpp"
 
 class SceneManager {
 public:
+    // Scene state of World::current()
     static SceneManager& get();
 
     void setCurrentFlowNode(Entity node);
@@ -29,12 +31,23 @@ public:
     float getRenderRegionH() const;
 
 private:
+    friend class World;
+    SceneManager() = default;
+
+    bool isVisibleSetStale() const;
+
     Entity m_currentFlowNode = INVALID_ENTITY;
     std::unordered_set<Entity> m_visibleEntities;
     std::vector<Entity> m_uiLayer;
     std::vector<Entity> m_objectLayer;
     Entity m_eventEntity = INVALID_ENTITY;
 
+    // Inputs the visible set was last built from; renderEditorScene() rebuilds only when they change
+    Entity m_builtForNode = INVALID_ENTITY;
+    uint64_t m_builtForVersion = 0;
+    bool m_builtForRunning = false;
+    int m_builtForEventIndex = -1;
+
     // Last known Scene Panel render region reported by UI
     float m_renderRegionX = 0.0f;
     float m_renderRegionY = 0.0f;
@@ -0,0 +1,239 @@
+#include "TransformSystem.hpp"
+#include "Core/JobSystem.hpp"
+#include "Engine/EntitySystem/EntityManager.hpp"
+#include "Engine/World.hpp"
+#include "Engine/EntitySystem/Components/TransformComponent.hpp"
+#include "Engine/EntitySystem/Components/Transform2DComponent.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    const glm::mat4 IDENTITY_3D(1.0f);
+    const glm::mat3 IDENTITY_2D(1.0f);
+
+    // Batches at least this large are composed on the job system
+    constexpr size_t PARALLEL_BATCH = 1024;
+    constexpr size_t PARALLEL_GRAIN = 256;
+
+    constexpr float DEG_TO_RAD = 0.017453292519943295f;
+
+    // Inputs and outputs of a local-matrix batch as flat float arrays, so the
+    // compose loops below have no gathers or calls and vectorize
+    struct Batch3D {
+        std::vector<uint32_t> slots;
+        std::vector<float> px, py, pz, rx, ry, rz, sx, sy, sz;
+        std::vector<float> m[9];    // upper 3x3 of T * Rx * Ry * Rz * S, column-major
+    };
+
+    struct Batch2D {
+        std::vector<uint32_t> slots;
+        std::vector<float> px, py, rot, sx, sy;
+        std::vector<float> m[4];    // upper 2x2 of T * R * S, column-major
+    };
+
+    void compose3D(Batch3D& b, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const float cx = std::cos(b.rx[i] * DEG_TO_RAD), sx = std::sin(b.rx[i] * DEG_TO_RAD);
+            const float cy = std::cos(b.ry[i] * DEG_TO_RAD), sy = std::sin(b.ry[i] * DEG_TO_RAD);
+            const float cz = std::cos(b.rz[i] * DEG_TO_RAD), sz = std::sin(b.rz[i] * DEG_TO_RAD);
+
+            b.m[0][i] = cy * cz * b.sx[i];
+            b.m[1][i] = (cx * sz + sx * sy * cz) * b.sx[i];
+            b.m[2][i] = (sx * sz - cx * sy * cz) * b.sx[i];
+            b.m[3][i] = -cy * sz * b.sy[i];
+            b.m[4][i] = (cx * cz - sx * sy * sz) * b.sy[i];
+            b.m[5][i] = (sx * cz + cx * sy * sz) * b.sy[i];
+            b.m[6][i] = sy * b.sz[i];
+            b.m[7][i] = -sx * cy * b.sz[i];
+            b.m[8][i] = cx * cy * b.sz[i];
+        }
+    }
+
+    void compose2D(Batch2D& b, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const float c = std::cos(b.rot[i] * DEG_TO_RAD), s = std::sin(b.rot[i] * DEG_TO_RAD);
+            b.m[0][i] = c * b.sx[i];
+            b.m[1][i] = s * b.sx[i];
+            b.m[2][i] = -s * b.sy[i];
+            b.m[3][i] = c * b.sy[i];
+        }
+    }
+
+    template <typename Fn>
+    void forEachChunk(size_t count, Fn&& fn) {
+        if (count >= PARALLEL_BATCH) {
+            const size_t chunks = (count + PARALLEL_GRAIN - 1) / PARALLEL_GRAIN;
+            JobSystem::get().parallelFor(0, chunks, 1, [&](size_t c) {
+                fn(c * PARALLEL_GRAIN, std::min(count, (c + 1) * PARALLEL_GRAIN));
+            });
+        } else {
+            fn(0, count);
+        }
+    }
+}
+
+TransformSystem& TransformSystem::get() {
+    return World::current().transforms();
+}
+
+void TransformSystem::invalidateAll() {
+    m_invalidated = true;
+}
+
+void TransformSystem::update() {
+    auto& em = EntityManager::get();
+
+    std::vector<Entity> dirty;
+    if (m_invalidated || !em.changeLogCovers(m_syncedVersion)) {
+        std::fill(m_entities.begin(), m_entities.end(), INVALID_ENTITY);
+        dirty = em.getAllEntities();
+        m_invalidated = false;
+    } else {
+        // Own transform, any component or meta/hierarchy change; one entry per entity
+        const uint32_t pass = ++m_pass;
+        em.forEachChangeSince(m_syncedVersion, [&](const EntityManager::ComponentChange& c) {
+            if (c.type != ComponentType::Unknown && c.type != ComponentType::Transform
+                && c.type != ComponentType::Transform2D) return;
+            const uint32_t idx = entityIndex(c.entity);
+            ensureSlot(idx);
+            if (!em.entityExists(c.entity)) {
+                if (m_entities[idx] == c.entity) m_entities[idx] = INVALID_ENTITY;   // destroyed
+                return;
+            }
+            if (m_visitedPass[idx] == pass) return;
+            m_visitedPass[idx] = pass;
+            dirty.push_back(c.entity);
+        });
+    }
+    m_syncedVersion = em.getVersion();
+
+    if (dirty.empty()) return;
+    rebuildLocals(dirty);
+    propagate(dirty);
+}
+
+void TransformSystem::rebuildLocals(const std::vector<Entity>& dirty) {
+    const auto& em = EntityManager::get();     // const reads never copy shared components
+
+    Batch3D b3;
+    Batch2D b2;
+    for (Entity e : dirty) {
+        const uint32_t idx = entityIndex(e);
+        ensureSlot(idx);
+        m_entities[idx] = e;
+        m_local[idx] = IDENTITY_3D;
+        m_local2D[idx] = IDENTITY_2D;
+
+        if (const auto* tf = em.get<TransformComponent>(e)) {
+            b3.slots.push_back(idx);
+            b3.px.push_back(tf->position.x); b3.py.push_back(tf->position.y); b3.pz.push_back(tf->position.z);
+            b3.rx.push_back(tf->rotation.x); b3.ry.push_back(tf->rotation.y); b3.rz.push_back(tf->rotation.z);
+            b3.sx.push_back(tf->scale.x);    b3.sy.push_back(tf->scale.y);    b3.sz.push_back(tf->scale.z);
+        }
+        if (const auto* tf = em.get<Transform2DComponent>(e)) {
+            b2.slots.push_back(idx);
+            b2.px.push_back(tf->position.x); b2.py.push_back(tf->position.y);
+            b2.rot.push_back(tf->rotation);
+            b2.sx.push_back(tf->scale.x);    b2.sy.push_back(tf->scale.y);
+        }
+    }
+
+    const size_t n3 = b3.slots.size();
+    const size_t n2 = b2.slots.size();
+    for (auto& v : b3.m) v.resize(n3);
+    for (auto& v : b2.m) v.resize(n2);
+
+    // Compose and scatter in the same chunk so each chunk's results stay in cache
+    forEachChunk(n3, [&](size_t begin, size_t end) {
+        compose3D(b3, begin, end);
+        for (size_t i = begin; i < end; ++i) {
+            glm::mat4& m = m_local[b3.slots[i]];
+            m[0] = glm::vec4(b3.m[0][i], b3.m[1][i], b3.m[2][i], 0.0f);
+            m[1] = glm::vec4(b3.m[3][i], b3.m[4][i], b3.m[5][i], 0.0f);
+            m[2] = glm::vec4(b3.m[6][i], b3.m[7][i], b3.m[8][i], 0.0f);
+            m[3] = glm::vec4(b3.px[i], b3.py[i], b3.pz[i], 1.0f);
+        }
+    });
+    forEachChunk(n2, [&](size_t begin, size_t end) {
+        compose2D(b2, begin, end);
+        for (size_t i = begin; i < end; ++i) {
+            glm::mat3& m = m_local2D[b2.slots[i]];
+            m[0] = glm::vec3(b2.m[0][i], b2.m[1][i], 0.0f);
+            m[1] = glm::vec3(b2.m[2][i], b2.m[3][i], 0.0f);
+            m[2] = glm::vec3(b2.px[i], b2.py[i], 1.0f);
+        }
+    });
+}
+
+// Recomputes world matrices for every dirty entity's subtree. Shallow roots
+// go first and mark what they visit, so a subtree is walked only once even
+// when several of its members changed.
+void TransformSystem::propagate(const std::vector<Entity>& dirty) {
+    auto& em = EntityManager::get();
+
+    std::vector<std::pair<uint32_t, Entity>> roots;
+    roots.reserve(dirty.size());
+    for (Entity e : dirty) {
+        uint32_t depth = 0;
+        for (Entity p = em.getParent(e); p != INVALID_ENTITY; p = em.getParent(p)) ++depth;
+        roots.emplace_back(depth, e);
+    }
+    std::sort(roots.begin(), roots.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    const uint32_t pass = ++m_pass;
+    for (const auto& [depth, root] : roots) {
+        if (m_visitedPass[entityIndex(root)] == pass) continue;
+
+        // Pre-order walk: a node's parent is always up to date when it is reached
+        em.forEachInSubtree(root, [&](Entity e, int) {
+            const uint32_t idx = entityIndex(e);
+            ensureSlot(idx);
+            if (m_entities[idx] != e) rebuildLocals({ e });    // not seen by an earlier update
+            m_visitedPass[idx] = pass;
+
+            const Entity parent = em.getParent(e);
+            if (isCached(parent)) {
+                const uint32_t p = entityIndex(parent);
+                m_world[idx] = m_world[p] * m_local[idx];
+                m_world2D[idx] = m_world2D[p] * m_local2D[idx];
+            } else {
+                m_world[idx] = m_local[idx];
+                m_world2D[idx] = m_local2D[idx];
+            }
+        });
+    }
+}
+
+void TransformSystem::ensureSlot(uint32_t idx) {
+    if (idx < m_entities.size()) return;
+    const size_t size = std::max<size_t>(idx + 1, m_entities.size() * 2);
+    m_entities.resize(size, INVALID_ENTITY);
+    m_local.resize(size, IDENTITY_3D);
+    m_world.resize(size, IDENTITY_3D);
+    m_local2D.resize(size, IDENTITY_2D);
+    m_world2D.resize(size, IDENTITY_2D);
+    m_visitedPass.resize(size, 0);
+}
+
+bool TransformSystem::isCached(Entity e) const {
+    if (e == INVALID_ENTITY) return false;
+    const uint32_t idx = entityIndex(e);
+    return idx < m_entities.size() && m_entities[idx] == e;
+}
+
+const glm::mat4& TransformSystem::getWorldMatrix(Entity e) const {
+    return isCached(e) ? m_world[entityIndex(e)] : IDENTITY_3D;
+}
+
+const glm::mat4& TransformSystem::getLocalMatrix(Entity e) const {
+    return isCached(e) ? m_local[entityIndex(e)] : IDENTITY_3D;
+}
+
+const glm::mat3& TransformSystem::getWorldMatrix2D(Entity e) const {
+    return isCached(e) ? m_world2D[entityIndex(e)] : IDENTITY_2D;
+}
+
+const glm::mat3& TransformSystem::getLocalMatrix2D(Entity e) const {
+    return isCached(e) ? m_local2D[entityIndex(e)] : IDENTITY_2D;
+}
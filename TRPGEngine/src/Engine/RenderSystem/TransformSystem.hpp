@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <glm.hpp>
+#include "Engine/EntitySystem/Entity.hpp"
+
+/**
+ * Caches local and world matrices for TransformComponent (mat4) and
+ * Transform2DComponent (mat3) and composes them through the entity
+ * hierarchy: world = parent world * local. Entities without a transform pass
+ * their parent's world through unchanged.
+ *
+ * update() reads the EntityManager change log, so only entities whose
+ * transform, components or parent changed are rebuilt, together with their
+ * subtrees. Field edits must go through getMutable<T>() or markDirty() to be
+ * seen. Call it on the main thread before rendering.
+ */
+class TransformSystem {
+public:
+    // Transform cache of World::current()
+    static TransformSystem& get();
+
+    void update();
+    void invalidateAll();
+
+    // Identity for unknown entities and entities without that transform kind
+    const glm::mat4& getWorldMatrix(Entity e) const;
+    const glm::mat4& getLocalMatrix(Entity e) const;
+    const glm::mat3& getWorldMatrix2D(Entity e) const;
+    const glm::mat3& getLocalMatrix2D(Entity e) const;
+
+private:
+    friend class World;
+    TransformSystem() = default;
+
+    void ensureSlot(uint32_t idx);
+    bool isCached(Entity e) const;
+    void rebuildLocals(const std::vector<Entity>& dirty);
+    void propagate(const std::vector<Entity>& dirty);
+
+    uint64_t m_syncedVersion = 0;
+    bool m_invalidated = true;
+    uint32_t m_pass = 0;
+
+    // Indexed by entityIndex(); m_entities holds the handle each slot was computed for
+    std::vector<Entity> m_entities;
+    std::vector<glm::mat4> m_local;
+    std::vector<glm::mat4> m_world;
+    std::vector<glm::mat3> m_local2D;
+    std::vector<glm::mat3> m_world2D;
+    std::vector<uint32_t> m_visitedPass;
+};
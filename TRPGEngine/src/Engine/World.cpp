@@ -0,0 +1,95 @@
+#include "World.hpp"
+#include "Engine/EntitySystem/EntityManager.hpp"
+#include "Engine/RenderSystem/SceneManager.hpp"
+#include "Engine/RenderSystem/TransformSystem.hpp"
+#include "Engine/GameplaySystem/FlowExecutor.hpp"
+#include "Engine/GameplaySystem/GameInstance.hpp"
+
+#include <iostream>
+
+namespace {
+    thread_local World* t_currentWorld = nullptr;
+
+    // Constructed after the default world (and so the component pools) so it is destroyed before them
+    std::unique_ptr<World>& playSession() {
+        World::getDefault();
+        static std::unique_ptr<World> session;
+        return session;
+    }
+}
+
+World::World()
+    : m_entities(new EntityManager()),
+      m_scene(new SceneManager()),
+      m_flow(new FlowExecutor()),
+      m_game(new GameInstance(*this)),
+      m_transforms(new TransformSystem()) {
+}
+
+World::~World() {
+    // Members reach each other through World::current(), so tear down as current
+    Scope scope(*this);
+    m_transforms.reset();
+    m_game.reset();
+    m_flow.reset();
+    m_scene.reset();
+    m_entities.reset();
+}
+
+void World::update(float deltaTime) {
+    Scope scope(*this);
+    m_game->update(deltaTime);
+}
+
+std::unique_ptr<World> World::fork() {
+    auto copy = std::make_unique<World>();
+    copy->m_entities->forkFrom(*m_entities);
+    *copy->m_scene = *m_scene;
+    *copy->m_flow = *m_flow;
+    *copy->m_transforms = *m_transforms;
+    return copy;
+}
+
+World& World::getDefault() {
+    static World instance;
+    return instance;
+}
+
+World& World::current() {
+    return t_currentWorld ? *t_currentWorld : getDefault();
+}
+
+void World::setCurrent(World* world) {
+    t_currentWorld = world;
+}
+
+World& World::beginPlaySession() {
+    auto& session = playSession();
+    if (!session) {
+        session = getDefault().fork();
+        std::cout << "[World] Play session started.\n";
+    }
+    setCurrent(session.get());
+    return *session;
+}
+
+void World::endPlaySession() {
+    auto& session = playSession();
+    if (!session) return;
+    if (t_currentWorld == session.get()) setCurrent(nullptr);
+    session.reset();
+    std::cout << "[World] Play session ended.\n";
+}
+
+World* World::getPlaySession() {
+    return playSession().get();
+}
+
+World::Scope::Scope(World& world)
+    : m_previous(t_currentWorld) {
+    t_currentWorld = &world;
+}
+
+World::Scope::~Scope() {
+    t_currentWorld = m_previous;
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <memory>
+
+class EntityManager;
+class SceneManager;
+class FlowExecutor;
+class GameInstance;
+class TransformSystem;
+
+/**
+ * One independent game state: entity storage, scene state, flow executor,
+ * game instance and transform cache. Worlds share nothing mutable except
+ * the thread-safe component pools and the job system, so several can be
+ * ticked at once from different threads.
+ *
+ * The old singleton accessors (EntityManager::get(), SceneManager::get(),
+ * FlowExecutor::get(), GameInstance::get(), TransformSystem::get()) return
+ * the members of the calling thread's current world. That is the default
+ * world unless a World::Scope says otherwise:
+ *
+ *     World sim;
+ *     std::thread t([&] { for (int i = 0; i < 1000; ++i) sim.update(dt); });
+ *
+ *     World::Scope scope(sim);             // or set it explicitly
+ *     EntityManager::get().createEntity(); // created in `sim`
+ */
+class World {
+public:
+    World();
+    ~World();
+
+    World(const World&) = delete;
+    World& operator=(const World&) = delete;
+
+    EntityManager& entities() { return *m_entities; }
+    SceneManager& scene() { return *m_scene; }
+    FlowExecutor& flow() { return *m_flow; }
+    GameInstance& game() { return *m_game; }
+    TransformSystem& transforms() { return *m_transforms; }
+
+    // Runs one game frame with this world current on the calling thread
+    void update(float deltaTime);
+
+    // Copy-on-write snapshot of entities, scene, flow and transform state.
+    // Takes time linear in the entity count but copies no components; each
+    // side copies a shared component the first time it writes it. The game
+    // instance is not copied: the fork starts stopped.
+    std::unique_ptr<World> fork();
+
+    // The editor's world; created on first use
+    static World& getDefault();
+    // This thread's current world, or the default one
+    static World& current();
+    // Replaces this thread's current world; nullptr goes back to the default one
+    static void setCurrent(World* world);
+
+    // Play mode runs on a fork of the default world that is current on the
+    // calling thread until the session ends; ending it throws the fork away,
+    // leaving the editor's world as it was when the session began.
+    static World& beginPlaySession();   // returns the running session if there is one
+    static void endPlaySession();
+    static World* getPlaySession();
+
+    // Makes a world current on this thread until the scope ends
+    class Scope {
+    public:
+        explicit Scope(World& world);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        World* m_previous;
+    };
+
+private:
+    // Entity storage first: everything else may still look entities up while being destroyed
+    std::unique_ptr<EntityManager> m_entities;
+    std::unique_ptr<SceneManager> m_scene;
+    std::unique_ptr<FlowExecutor> m_flow;
+    std::unique_ptr<GameInstance> m_game;
+    std::unique_ptr<TransformSystem> m_transforms;
+};
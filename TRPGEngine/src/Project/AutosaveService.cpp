@@ -0,0 +1,201 @@
+#include "AutosaveService.hpp"
+#include "Core/Compression.hpp"
+#include "Core/DurableFile.hpp"
+#include "Core/MappedFile.hpp"
+#include "Engine/EntitySystem/EntityManager.hpp"
+#include "Engine/World.hpp"
+#include "Project/BinaryProject.hpp"
+#include "Project/ProjectManager.hpp"
+#include "Project/SceneStreamer.hpp"
+#include "Resources/ResourceManager.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <iostream>
+#include <stdexcept>
+
+namespace fs = std::filesystem;
+
+namespace {
+    constexpr char MAGIC[8] = { 'T', 'R', 'P', 'G', 'A', 'U', 'T', 'O' };
+    constexpr uint32_t VERSION = 1;
+
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t reserved;
+        uint64_t rawSize;       // the BinaryProject image
+        uint64_t packedSize;    // the Compression block that follows
+    };
+    static_assert(sizeof(Header) == 32, "Header layout is part of the file format");
+}
+
+struct AutosaveService::Result {
+    bool ok = false;
+    size_t bytes = 0;
+    std::string error;
+};
+
+AutosaveService& AutosaveService::get() {
+    static AutosaveService instance;
+    return instance;
+}
+
+std::string AutosaveService::pathFor(const std::string& projectPath) {
+    return projectPath + EXTENSION;
+}
+
+bool AutosaveService::hasNewerAutosave(const std::string& projectPath) {
+    std::error_code ec;
+    const auto autosaved = fs::last_write_time(pathFor(projectPath), ec);
+    if (ec) return false;
+    const auto saved = fs::last_write_time(projectPath, ec);
+    if (!ec && saved >= autosaved) return false;
+    const auto journaled = fs::last_write_time(ProjectJournal::pathFor(projectPath), ec);
+    return ec || journaled < autosaved;
+}
+
+Entity AutosaveService::load(EntityManager& em, const std::string& autosavePath) {
+    MappedFile file(autosavePath);
+    if (!file.isOpen()) throw std::runtime_error("cannot open " + autosavePath);
+
+    Header header;
+    if (file.size() < sizeof(header)) throw std::runtime_error("not an autosave file");
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (!std::equal(MAGIC, MAGIC + 8, header.magic)) throw std::runtime_error("not an autosave file");
+    if (header.version > VERSION) throw std::runtime_error("autosave written by a newer version");
+    if (header.packedSize != file.size() - sizeof(header)) throw std::runtime_error("autosave is truncated");
+
+    std::vector<uint8_t> raw(header.rawSize);
+    if (!Compression::decompress(file.data() + sizeof(header), header.packedSize, raw.data(), raw.size())) {
+        throw std::runtime_error("autosave is corrupt");
+    }
+    return BinaryProject::load(em, raw.data(), raw.size());
+}
+
+void AutosaveService::setInterval(float seconds) {
+    m_interval = std::max(seconds, 10.0f);
+}
+
+void AutosaveService::update(float deltaTime) {
+    if (m_running) {
+        if (m_job.isDone()) finish();
+        return;
+    }
+    if (!m_enabled) return;
+
+    m_elapsed += deltaTime;
+    if (m_elapsed < m_interval) return;
+    m_elapsed = 0.0f;
+
+    // Only edits since the last autosave are worth another one
+    if (!ResourceManager::get().hasUnsavedChanges()) return;
+    if (World::getDefault().entities().getVersion() == m_savedVersion) return;
+    trigger();
+}
+
+bool AutosaveService::trigger() {
+    if (m_running) return false;
+
+    // Always the editor's world, also while a play session is current
+    World& editor = World::getDefault();
+    const std::string projectPath = ProjectManager::getCurrentProjectPath();
+    const Entity root = ProjectManager::getProjectMetaEntity();
+    if (projectPath.empty() || !editor.entities().entityExists(root)) return false;
+
+    // The only work on this thread: the fork copies index arrays, not components
+    std::shared_ptr<World> snapshot = editor.fork();
+    SceneStreamer::ColdEntities cold = SceneStreamer::get().coldEntities(editor.entities());
+    m_savedVersion = editor.entities().getVersion();
+    m_target = pathFor(projectPath);
+    m_result = std::make_shared<Result>();
+    m_running = true;
+    m_discardWhenDone = false;
+    m_status = Status::Saving;
+    m_statusText = "Autosaving...";
+
+    m_job = JobSystem::get().schedule([snapshot, cold = std::move(cold), root, target = m_target, result = m_result]() mutable {
+        try {
+            std::vector<uint8_t> packed, raw;
+            {
+                World::Scope scope(*snapshot);
+                nlohmann::json project = snapshot->entities().serializeEntity(root);
+                cold.restore(project);
+                raw = BinaryProject::encode(project);
+            }
+            snapshot.reset();   // dropping the last references is not free either; keep it off the main thread
+            packed = Compression::compress(raw.data(), raw.size());
+
+            Header header{};
+            std::copy(MAGIC, MAGIC + 8, header.magic);
+            header.version = VERSION;
+            header.rawSize = raw.size();
+            header.packedSize = packed.size();
+
+            // Renamed over the previous autosave, so there is always one complete file
+            const std::string tempPath = target + ".tmp";
+            if (!DurableFile::write(tempPath, { { &header, sizeof(header) }, { packed.data(), packed.size() } })) {
+                throw std::runtime_error("cannot write " + tempPath);
+            }
+            fs::rename(tempPath, target);
+
+            result->ok = true;
+            result->bytes = sizeof(header) + packed.size();
+        } catch (const std::exception& ex) {
+            result->error = ex.what();
+            std::error_code ec;
+            fs::remove(target + ".tmp", ec);
+        }
+    });
+    return true;
+}
+
+void AutosaveService::wait() {
+    if (!m_running) return;
+    JobSystem::get().wait(m_job);
+    finish();
+}
+
+void AutosaveService::discard(const std::string& projectPath) {
+    const std::string path = pathFor(projectPath);
+    if (m_running && m_target == path) m_discardWhenDone = true;
+    std::error_code ec;
+    fs::remove(path, ec);
+    m_elapsed = 0.0f;
+    if (!m_running) {
+        m_status = Status::Idle;
+        m_statusText.clear();
+    }
+}
+
+void AutosaveService::finish() {
+    m_running = false;
+    m_job = {};
+    const std::shared_ptr<Result> result = std::move(m_result);
+
+    if (m_discardWhenDone) {
+        // The project was saved while this autosave was being written
+        std::error_code ec;
+        fs::remove(m_target, ec);
+        m_discardWhenDone = false;
+        m_status = Status::Idle;
+        m_statusText.clear();
+        return;
+    }
+
+    if (!result->ok) {
+        std::cerr << "[AutosaveService] Autosave to " << m_target << " failed: " << result->error << "\n";
+        m_status = Status::Failed;
+        m_statusText = "Autosave failed";
+        return;
+    }
+
+    char clock[16] = "";
+    const std::time_t now = std::time(nullptr);
+    if (const std::tm* local = std::localtime(&now)) std::strftime(clock, sizeof(clock), "%H:%M:%S", local);
+    std::cout << "[AutosaveService] Autosaved to " << m_target << " (" << result->bytes << " bytes)\n";
+    m_status = Status::Saved;
+    m_statusText = std::string("Autosaved ") + clock;
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "Core/JobSystem.hpp"
+#include "Engine/EntitySystem/Entity.hpp"
+
+class EntityManager;
+
+/**
+ * Periodic background autosave of the open project to <project>.autosave.
+ *
+ * The main thread only forks the editor's world (copy-on-write: entity
+ * index arrays are copied, components are shared), which is all the
+ * consistency the snapshot needs. Serializing, compressing and writing
+ * happen on a job thread: binary project format, Compression block,
+ * written to a temp file and renamed over the previous autosave. The
+ * project file itself is never touched; a normal save discards the
+ * autosave.
+ */
+class AutosaveService {
+public:
+    static AutosaveService& get();
+
+    enum class Status { Idle, Saving, Saved, Failed };
+
+    static constexpr const char* EXTENSION = ".autosave";
+    static std::string pathFor(const std::string& projectPath);
+    // True if `projectPath` has an autosave written after its last save
+    static bool hasNewerAutosave(const std::string& projectPath);
+    // Creates the autosaved entities in `em` and returns the root. Throws
+    // std::runtime_error if the file is missing, corrupt or of a newer version.
+    static Entity load(EntityManager& em, const std::string& autosavePath);
+
+    void setEnabled(bool enabled) { m_enabled = enabled; }
+    bool isEnabled() const { return m_enabled; }
+    void setInterval(float seconds);
+    float getInterval() const { return m_interval; }
+
+    // Once per frame on the main thread: starts an autosave when the interval
+    // has passed, the project has unsaved edits and none is running yet
+    void update(float deltaTime);
+    // Starts an autosave now unless one is running; false if there is nothing to save
+    bool trigger();
+    // Blocks until the running autosave, if any, has finished
+    void wait();
+    // Deletes the autosave of `projectPath` after it was saved normally,
+    // including one that is still being written
+    void discard(const std::string& projectPath);
+
+    Status getStatus() const { return m_status; }
+    // "Autosaving...", "Autosaved 14:02:11", ...; empty when idle
+    const std::string& getStatusText() const { return m_statusText; }
+
+private:
+    struct Result;      // filled in by the job, read once it is done
+
+    AutosaveService() = default;
+    AutosaveService(const AutosaveService&) = delete;
+    AutosaveService& operator=(const AutosaveService&) = delete;
+
+    void finish();
+
+    bool m_enabled = true;
+    float m_interval = 120.0f;          // seconds
+    float m_elapsed = 0.0f;
+    uint64_t m_savedVersion = 0;        // editor world version of the last snapshot
+    bool m_running = false;
+    bool m_discardWhenDone = false;
+    std::string m_target;               // file being written
+    JobSystem::JobHandle m_job;
+    std::shared_ptr<Result> m_result;
+    Status m_status = Status::Idle;
+    std::string m_statusText;
+};
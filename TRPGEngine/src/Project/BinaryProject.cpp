@@ -0,0 +1,719 @@
+#include "BinaryProject.hpp"
+#include "Engine/EntitySystem/EntityManager.hpp"
+#include "Engine/EntitySystem/EntityRefs.hpp"
+#include "Core/ByteStream.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+namespace BinaryProject {
+
+namespace {
+    constexpr char MAGIC[8] = { 'T', 'R', 'P', 'G', 'P', 'R', 'J', 'B' };
+    constexpr uint32_t NONE = std::numeric_limits<uint32_t>::max();
+    constexpr uint32_t MAX_DEPTH = 256;     // nesting of one value; JSON we write stays far below
+
+    enum EntityFlags : uint32_t {
+        HasMeta = 1u << 0,
+        HasComponents = 1u << 1,
+        HasChildren = 1u << 2,
+    };
+
+    enum class Tag : uint32_t { Null, False, True, Int, UInt, Float, String, Array, Object };
+
+    // How a block stores its rows' fields
+    enum class Format : uint32_t {
+        Json,       // a value, as in version 1
+        Record,     // the type's binary record (ComponentTypeRegistry encode/decode)
+    };
+
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t fileSize;
+        uint32_t stringCount, stringTable;
+        uint32_t entityCount, entityTable;
+        uint32_t blockCount, blockTable;
+    };
+    static_assert(sizeof(Header) == 40, "Header layout is part of the file format");
+
+    struct StringEntry { uint32_t offset, length; };
+    struct EntityEntry { uint32_t parent, flags, meta, extras; };
+    struct BlockEntry { uint32_t key, rowCount, rows; Format format; };    // key == NONE: components without a "type"
+    struct BlockEntryV1 { uint32_t key, rowCount, rows; };
+    struct RowEntry { uint32_t entity, slot, fields; };
+
+    [[noreturn]] void fail(const std::string& what) {
+        throw std::runtime_error("[BinaryProject] " + what);
+    }
+
+    class Writer {
+    public:
+        Writer() { m_out.resize(sizeof(Header)); }
+
+        void entity(const nlohmann::json& j, uint32_t parent) {
+            if (!j.is_object()) fail("entity is not a JSON object");
+            const uint32_t index = static_cast<uint32_t>(m_entities.size());
+            m_entities.push_back({ parent, 0, 0, 0 });
+
+            EntityEntry entry{ parent, 0, 0, 0 };
+            std::vector<std::pair<uint32_t, uint32_t>> extras;
+            const nlohmann::json* children = nullptr;
+            for (auto it = j.begin(); it != j.end(); ++it) {
+                if (it.key() == "_meta") {
+                    entry.flags |= HasMeta;
+                    entry.meta = value(it.value());
+                } else if (it.key() == "components" && it->is_array()) {
+                    entry.flags |= HasComponents;
+                    uint32_t slot = 0;
+                    for (const auto& comp : *it) component(index, slot++, comp);
+                } else if (it.key() == "children" && it->is_array()) {
+                    entry.flags |= HasChildren;
+                    children = &it.value();
+                } else {
+                    extras.emplace_back(string(it.key()), value(it.value()));
+                }
+            }
+            if (!extras.empty()) entry.extras = object(extras);
+            m_entities[index] = entry;
+
+            if (children) {
+                for (const auto& child : *children) entity(child, index);
+            }
+        }
+
+        std::vector<uint8_t> finish() {
+            Header header{};
+            std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+            header.version = VERSION;
+
+            header.entityCount = static_cast<uint32_t>(m_entities.size());
+            header.entityTable = offset();
+            for (const EntityEntry& e : m_entities) append(e);
+
+            std::vector<BlockEntry> blocks;
+            for (const Block& block : m_blocks) {
+                blocks.push_back({ block.key, static_cast<uint32_t>(block.rows.size()), offset(), block.format });
+                for (const RowEntry& row : block.rows) append(row);
+            }
+            header.blockCount = static_cast<uint32_t>(blocks.size());
+            header.blockTable = offset();
+            for (const BlockEntry& b : blocks) append(b);
+
+            header.stringCount = static_cast<uint32_t>(m_strings.size());
+            header.stringTable = offset();
+            size_t text = m_out.size() + m_strings.size() * sizeof(StringEntry);
+            for (const std::string* s : m_strings) {
+                append(StringEntry{ static_cast<uint32_t>(text), static_cast<uint32_t>(s->size()) });
+                text += s->size() + 1;
+            }
+            for (const std::string* s : m_strings) {
+                m_out.insert(m_out.end(), s->begin(), s->end());
+                m_out.push_back('\0');
+            }
+            while (m_out.size() % 4) m_out.push_back(0);
+
+            if (m_out.size() > NONE) fail("project is too large for a binary project file");
+            header.fileSize = static_cast<uint32_t>(m_out.size());
+            std::memcpy(m_out.data(), &header, sizeof(header));
+            return std::move(m_out);
+        }
+
+    private:
+        struct Block {
+            uint32_t key;
+            Format format;
+            const ComponentTypeRegistry::RegisteredComponent* reg;     // Record blocks
+            std::vector<RowEntry> rows;
+        };
+
+        std::vector<uint8_t> m_out;
+        std::vector<EntityEntry> m_entities;
+        std::vector<Block> m_blocks;                        // first-seen order
+        std::unordered_map<uint64_t, size_t> m_blockIndex;    // key << 1 | JSON fallback
+        std::unordered_map<std::string, uint32_t> m_stringIds;
+        std::vector<const std::string*> m_strings;          // keys of m_stringIds, by id
+
+        uint32_t offset() const {
+            if (m_out.size() > NONE) fail("project is too large for a binary project file");
+            return static_cast<uint32_t>(m_out.size());
+        }
+
+        template <typename T>
+        void append(const T& v) {
+            const auto* bytes = reinterpret_cast<const uint8_t*>(&v);
+            m_out.insert(m_out.end(), bytes, bytes + sizeof(T));
+        }
+
+        uint32_t string(const std::string& s) {
+            auto [it, inserted] = m_stringIds.emplace(s, static_cast<uint32_t>(m_strings.size()));
+            if (inserted) m_strings.push_back(&it->first);
+            return it->second;
+        }
+
+        uint32_t tag(Tag t) {
+            const uint32_t at = offset();
+            append(static_cast<uint32_t>(t));
+            return at;
+        }
+
+        uint32_t object(const std::vector<std::pair<uint32_t, uint32_t>>& entries) {
+            const uint32_t at = tag(Tag::Object);
+            append(static_cast<uint32_t>(entries.size()));
+            for (const auto& [key, val] : entries) {
+                append(key);
+                append(val);
+            }
+            return at;
+        }
+
+        // Children are written before their parent, so every offset a value
+        // holds points backwards; the reader relies on that to stop on cycles
+        uint32_t value(const nlohmann::json& v) {
+            using value_t = nlohmann::json::value_t;
+            switch (v.type()) {
+            case value_t::null:
+                return tag(Tag::Null);
+            case value_t::boolean:
+                return tag(v.get<bool>() ? Tag::True : Tag::False);
+            case value_t::number_integer: {
+                const uint32_t at = tag(Tag::Int);
+                append(v.get<int64_t>());
+                return at;
+            }
+            case value_t::number_unsigned: {
+                const uint32_t at = tag(Tag::UInt);
+                append(v.get<uint64_t>());
+                return at;
+            }
+            case value_t::number_float: {
+                const uint32_t at = tag(Tag::Float);
+                append(v.get<double>());
+                return at;
+            }
+            case value_t::string: {
+                const uint32_t id = string(v.get_ref<const std::string&>());
+                const uint32_t at = tag(Tag::String);
+                append(id);
+                return at;
+            }
+            case value_t::array: {
+                std::vector<uint32_t> items;
+                items.reserve(v.size());
+                for (const auto& item : v) items.push_back(value(item));
+                const uint32_t at = tag(Tag::Array);
+                append(static_cast<uint32_t>(items.size()));
+                for (uint32_t item : items) append(item);
+                return at;
+            }
+            case value_t::object: {
+                std::vector<std::pair<uint32_t, uint32_t>> entries;
+                entries.reserve(v.size());
+                for (auto it = v.begin(); it != v.end(); ++it) {
+                    entries.emplace_back(string(it.key()), value(it.value()));
+                }
+                return object(entries);
+            }
+            default:
+                fail("JSON binary values cannot be stored");
+            }
+        }
+
+        // Registered types become records; components without a type, or of
+        // a type this build does not know, stay JSON values. A registered type
+        // gets a second, JSON block for components its record cannot give back.
+        Block& block(uint32_t key, bool fallback = false) {
+            auto [it, inserted] = m_blockIndex.emplace(uint64_t(key) << 1 | uint64_t(fallback), m_blocks.size());
+            if (inserted) {
+                const ComponentTypeRegistry::RegisteredComponent* reg = nullptr;
+                if (key != NONE && !fallback) {
+                    try {
+                        reg = ComponentTypeRegistry::getInfo(ComponentTypeRegistry::getTypeFromString(*m_strings[key]));
+                    } catch (const std::exception&) {}
+                }
+                const bool record = reg && reg->loader && reg->encode && reg->decode;
+                m_blocks.push_back({ key, record ? Format::Record : Format::Json, record ? reg : nullptr, {} });
+            }
+            return m_blocks[it->second];
+        }
+
+        // The component's loader reads the JSON with its references staged,
+        // so encode() writes back the GUIDs it was given. One counting pass
+        // sizes the record, the second writes it in place. NONE if the record
+        // would not decode to `comp`: keys the type does not read, or values
+        // it normalizes, would be lost.
+        uint32_t record(const ComponentTypeRegistry::RegisteredComponent& reg, const nlohmann::json& comp) {
+            std::vector<uint64_t> refs;
+            EntityRefs::Staging staging(refs);
+            const std::shared_ptr<ComponentBase> loaded = reg.loader(comp);
+            if (!loaded) fail("component " + reg.key + " did not load");
+            nlohmann::json saved = loaded->toJson();
+            saved["type"] = comp["type"];
+            if (saved != comp) return NONE;
+
+            ByteWriter counter;
+            reg.encode(*loaded, counter);
+            const uint32_t at = offset();
+            m_out.resize(at + counter.position());
+            ByteWriter writer(m_out.data() + at, counter.position());
+            reg.encode(*loaded, writer);
+            while (m_out.size() % 4) m_out.push_back(0);
+            return at;
+        }
+
+        void component(uint32_t entity, uint32_t slot, const nlohmann::json& comp) {
+            uint32_t key = NONE;
+            auto type = comp.is_object() ? comp.find("type") : comp.end();
+            if (comp.is_object() && type != comp.end() && type->is_string()) key = string(type->get_ref<const std::string&>());
+            Block* b = &block(key);
+
+            uint32_t fields = NONE;
+            if (b->format == Format::Record) {
+                fields = record(*b->reg, comp);
+                if (fields == NONE) b = &block(key, true);
+            }
+            if (fields == NONE && key != NONE) {
+                std::vector<std::pair<uint32_t, uint32_t>> entries;
+                for (auto it = comp.begin(); it != comp.end(); ++it) {
+                    if (it != type) entries.emplace_back(string(it.key()), value(it.value()));
+                }
+                fields = object(entries);
+            } else if (fields == NONE) {
+                fields = value(comp);
+            }
+            b->rows.push_back({ entity, slot, fields });
+        }
+    };
+
+    class Reader {
+    public:
+        Reader(const uint8_t* data, size_t size) : m_data(data), m_size(size) {
+            if (!isBinary(data, size) || size < sizeof(Header)) fail("not a binary project");
+            std::memcpy(&m_header, data, sizeof(Header));
+            if (m_header.version == 0 || m_header.version > VERSION) {
+                fail("unsupported format version " + std::to_string(m_header.version));
+            }
+            if (m_header.fileSize != size) fail("file is truncated");
+            range(m_header.stringTable, size_t(m_header.stringCount) * sizeof(StringEntry));
+            range(m_header.entityTable, size_t(m_header.entityCount) * sizeof(EntityEntry));
+            range(m_header.blockTable, size_t(m_header.blockCount) * blockEntrySize());
+            if (m_header.entityCount == 0) fail("file holds no entities");
+        }
+
+        const Header& header() const { return m_header; }
+
+        EntityEntry entity(uint32_t index) const {
+            EntityEntry e = read<EntityEntry>(m_header.entityTable + size_t(index) * sizeof(EntityEntry));
+            if (index == 0 ? e.parent != NONE : e.parent >= index) fail("bad entity parent");
+            return e;
+        }
+
+        BlockEntry block(uint32_t index) const {
+            const size_t at = m_header.blockTable + size_t(index) * blockEntrySize();
+            BlockEntry b{};
+            if (m_header.version == 1) {
+                const BlockEntryV1 v1 = read<BlockEntryV1>(at);
+                b = { v1.key, v1.rowCount, v1.rows, Format::Json };
+            } else {
+                b = read<BlockEntry>(at);
+                if (b.format != Format::Json && b.format != Format::Record) fail("bad block format");
+                if (b.format == Format::Record && b.key == NONE) fail("untyped block of records");
+            }
+            range(b.rows, size_t(b.rowCount) * sizeof(RowEntry));
+            return b;
+        }
+
+        RowEntry row(const BlockEntry& b, uint32_t index) const {
+            RowEntry r = read<RowEntry>(b.rows + size_t(index) * sizeof(RowEntry));
+            if (r.entity >= m_header.entityCount) fail("component row names a missing entity");
+            return r;
+        }
+
+        std::string_view string(uint32_t index) const {
+            if (index >= m_header.stringCount) fail("bad string index");
+            StringEntry s = read<StringEntry>(m_header.stringTable + size_t(index) * sizeof(StringEntry));
+            range(s.offset, s.length);
+            return { reinterpret_cast<const char*>(m_data + s.offset), s.length };
+        }
+
+        nlohmann::json value(uint32_t at) const {
+            Walk walk = startWalk();
+            return value(at, NONE, 0, walk);
+        }
+
+        // Bytes the value at `at` takes up, children included
+        size_t valueSize(uint32_t at) const {
+            Walk walk = startWalk();
+            return valueSize(at, NONE, 0, walk);
+        }
+
+        // The record at `at`, size prefix included, for the type's decode()
+        ByteReader record(uint32_t at) const {
+            if (at < sizeof(Header)) fail("bad record offset");
+            const size_t size = sizeof(uint32_t) + size_t(read<uint32_t>(at));
+            range(at, size);
+            return ByteReader(m_data + at, size);
+        }
+
+        // The entity's JSON without "components" and "children"
+        nlohmann::json shell(const EntityEntry& e) const {
+            nlohmann::json j = nlohmann::json::object();
+            if (e.flags & HasMeta) j["_meta"] = value(e.meta);
+            if (e.extras) {
+                nlohmann::json extras = value(e.extras);
+                if (!extras.is_object()) fail("bad entity extras");
+                for (auto it = extras.begin(); it != extras.end(); ++it) j[it.key()] = std::move(it.value());
+            }
+            return j;
+        }
+
+    private:
+        const uint8_t* m_data;
+        size_t m_size;
+        Header m_header{};
+
+        // Offsets only have to point backwards, so a corrupt file can nest
+        // values deeper than any stack or share one child between many
+        // parents. A value written by Writer holds each node once, and every
+        // node takes at least 4 bytes, so a walk that needs more nodes than
+        // that is refused as well.
+        struct Walk { size_t nodesLeft; };
+
+        size_t blockEntrySize() const {
+            return m_header.version == 1 ? sizeof(BlockEntryV1) : sizeof(BlockEntry);
+        }
+        Walk startWalk() const { return { m_size / 4 }; }
+
+        void enter(uint32_t at, uint32_t limit, uint32_t depth, Walk& walk) const {
+            if (at < sizeof(Header) || at >= limit) fail("bad value offset");
+            if (depth > MAX_DEPTH) fail("values nested too deeply");
+            if (walk.nodesLeft-- == 0) fail("value has more nodes than the file can hold");
+        }
+
+        // `limit`: the value must start before it (see Writer::value)
+        nlohmann::json value(uint32_t at, uint32_t limit, uint32_t depth, Walk& walk) const {
+            enter(at, limit, depth, walk);
+            switch (static_cast<Tag>(read<uint32_t>(at))) {
+            case Tag::Null:  return nullptr;
+            case Tag::False: return false;
+            case Tag::True:  return true;
+            case Tag::Int:   return read<int64_t>(at + 4);
+            case Tag::UInt:  return read<uint64_t>(at + 4);
+            case Tag::Float: return read<double>(at + 4);
+            case Tag::String:
+                return std::string(string(read<uint32_t>(at + 4)));
+            case Tag::Array: {
+                const uint32_t count = read<uint32_t>(at + 4);
+                range(at + size_t(8), size_t(count) * 4);
+                nlohmann::json arr = nlohmann::json::array();
+                arr.get_ref<nlohmann::json::array_t&>().reserve(count);
+                for (uint32_t i = 0; i < count; ++i) {
+                    arr.push_back(value(read<uint32_t>(at + 8 + size_t(i) * 4), at, depth + 1, walk));
+                }
+                return arr;
+            }
+            case Tag::Object: {
+                const uint32_t count = read<uint32_t>(at + 4);
+                range(at + size_t(8), size_t(count) * 8);
+                nlohmann::json obj = nlohmann::json::object();
+                for (uint32_t i = 0; i < count; ++i) {
+                    const size_t entry = at + 8 + size_t(i) * 8;
+                    obj[std::string(string(read<uint32_t>(entry)))] = value(read<uint32_t>(entry + 4), at, depth + 1, walk);
+                }
+                return obj;
+            }
+            }
+            fail("bad value tag");
+        }
+
+        size_t valueSize(uint32_t at, uint32_t limit, uint32_t depth, Walk& walk) const {
+            enter(at, limit, depth, walk);
+            switch (static_cast<Tag>(read<uint32_t>(at))) {
+            case Tag::Null:
+            case Tag::False:
+            case Tag::True:  return 4;
+            case Tag::Int:
+            case Tag::UInt:
+            case Tag::Float: return 12;
+            case Tag::String:
+                return 8 + string(read<uint32_t>(at + 4)).size();
+            case Tag::Array: {
+                const uint32_t count = read<uint32_t>(at + 4);
+                size_t total = 8 + size_t(count) * 4;
+                for (uint32_t i = 0; i < count; ++i) total += valueSize(read<uint32_t>(at + 8 + size_t(i) * 4), at, depth + 1, walk);
+                return total;
+            }
+            case Tag::Object: {
+                const uint32_t count = read<uint32_t>(at + 4);
+                size_t total = 8 + size_t(count) * 8;
+                for (uint32_t i = 0; i < count; ++i) {
+                    const size_t entry = at + 8 + size_t(i) * 8;
+                    total += string(read<uint32_t>(entry)).size() + valueSize(read<uint32_t>(entry + 4), at, depth + 1, walk);
+                }
+                return total;
+            }
+            }
+            fail("bad value tag");
+        }
+
+        void range(size_t offset, size_t length) const {
+            if (offset > m_size || length > m_size - offset) fail("offset out of range");
+        }
+
+        template <typename T>
+        T read(size_t offset) const {
+            range(offset, sizeof(T));
+            T v;
+            std::memcpy(&v, m_data + offset, sizeof(T));
+            return v;
+        }
+    };
+
+    template <typename T>
+    void sortBySlot(std::vector<std::pair<uint32_t, T>>& items) {
+        std::stable_sort(items.begin(), items.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+    }
+
+    // The registered type saved under `key`; nullptr (and logged) if this build has none
+    const ComponentTypeRegistry::RegisteredComponent* registered(std::string_view key) {
+        try {
+            const auto* reg = ComponentTypeRegistry::getInfo(ComponentTypeRegistry::getTypeFromString(key));
+            if (reg) return reg;
+            std::cerr << "[Deserialization] No loader registered for type: " << key << "\n";
+        } catch (const std::exception& ex) {
+            std::cerr << "[Deserialization] " << ex.what() << "\n";
+        }
+        return nullptr;
+    }
+
+    // Built from a Record row; the caller stages references if it needs to
+    std::shared_ptr<ComponentBase> decodeRecord(const Reader& reader, const ComponentTypeRegistry::RegisteredComponent& reg,
+                                                uint32_t fields) {
+        ByteReader in = reader.record(fields);
+        return reg.decode(in);
+    }
+
+    // A component row as JSON: its fields, plus "type" unless it had none.
+    // Null for records of types this build does not know.
+    nlohmann::json componentJson(const Reader& reader, const BlockEntry& block, uint32_t fields) {
+        if (block.format == Format::Record) {
+            const std::string_view key = reader.string(block.key);
+            const auto* reg = registered(key);
+            if (!reg || !reg->decode) return nullptr;
+            std::vector<uint64_t> refs;
+            EntityRefs::Staging staging(refs);      // toJson() writes the GUIDs back out
+            nlohmann::json comp = decodeRecord(reader, *reg, fields)->toJson();
+            comp["type"] = std::string(key);
+            return comp;
+        }
+        nlohmann::json comp = reader.value(fields);
+        if (block.key != NONE) {
+            if (!comp.is_object()) fail("typed component is not an object");
+            comp["type"] = std::string(reader.string(block.key));
+        }
+        return comp;
+    }
+}
+
+bool isBinary(const uint8_t* data, size_t size) {
+    return data && size >= sizeof(MAGIC) && std::memcmp(data, MAGIC, sizeof(MAGIC)) == 0;
+}
+
+bool isBinaryFile(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    uint8_t magic[sizeof(MAGIC)] = {};
+    return in.read(reinterpret_cast<char*>(magic), sizeof(magic)) && isBinary(magic, sizeof(magic));
+}
+
+std::vector<uint8_t> encode(const nlohmann::json& root) {
+    Writer writer;
+    writer.entity(root, NONE);
+    return writer.finish();
+}
+
+nlohmann::json decode(const uint8_t* data, size_t size) {
+    Reader reader(data, size);
+    const uint32_t count = reader.header().entityCount;
+
+    std::vector<std::vector<std::pair<uint32_t, nlohmann::json>>> comps(count);
+    for (uint32_t b = 0; b < reader.header().blockCount; ++b) {
+        const BlockEntry block = reader.block(b);
+        for (uint32_t r = 0; r < block.rowCount; ++r) {
+            const RowEntry row = reader.row(block, r);
+            nlohmann::json comp = componentJson(reader, block, row.fields);
+            if (!comp.is_null() || block.format == Format::Json) comps[row.entity].emplace_back(row.slot, std::move(comp));
+        }
+    }
+
+    std::vector<nlohmann::json> nodes(count);
+    std::vector<std::vector<uint32_t>> children(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        const EntityEntry e = reader.entity(i);
+        nodes[i] = reader.shell(e);
+        if (e.flags & HasComponents) {
+            sortBySlot(comps[i]);
+            nlohmann::json& arr = nodes[i]["components"] = nlohmann::json::array();
+            for (auto& [slot, comp] : comps[i]) arr.push_back(std::move(comp));
+        }
+        if (e.flags & HasChildren) nodes[i]["children"] = nlohmann::json::array();
+        if (i > 0) children[e.parent].push_back(i);
+    }
+
+    // Children have higher indices than their parent, so walking parents from
+    // the back moves each subtree into place only after it is complete
+    for (uint32_t p = count; p-- > 0;) {
+        if (children[p].empty()) continue;
+        nlohmann::json& arr = nodes[p]["children"];
+        for (uint32_t c : children[p]) arr.push_back(std::move(nodes[c]));
+    }
+    return std::move(nodes[0]);
+}
+
+Entity load(EntityManager& em, const uint8_t* data, size_t size) {
+    Reader reader(data, size);
+    const uint32_t count = reader.header().entityCount;
+
+    EntityBatch batch;
+    batch.entities.resize(count);
+
+    // Type by type: each block resolves its loader once and walks its rows in order
+    std::vector<std::vector<std::pair<uint32_t, std::shared_ptr<ComponentBase>>>> comps(count);
+    for (uint32_t b = 0; b < reader.header().blockCount; ++b) {
+        const BlockEntry block = reader.block(b);
+        if (block.key == NONE) {
+            std::cerr << "[Deserialization] Skipping " << block.rowCount << " component(s) with no type field\n";
+            continue;
+        }
+        const auto* reg = registered(reader.string(block.key));
+        if (!reg || !(block.format == Format::Record ? reg->decode != nullptr : reg->loader != nullptr)) continue;
+
+        for (uint32_t r = 0; r < block.rowCount; ++r) {
+            const RowEntry row = reader.row(block, r);
+            EntityRefs::Staging refs(batch.entities[row.entity].refs);
+            comps[row.entity].emplace_back(row.slot, block.format == Format::Record
+                                                         ? decodeRecord(reader, *reg, row.fields)
+                                                         : reg->loader(reader.value(row.fields)));
+        }
+    }
+
+    for (uint32_t i = 0; i < count; ++i) {
+        const EntityEntry e = reader.entity(i);
+        StagedEntity& staged = batch.entities[i];
+        staged.shell = reader.shell(e);
+        if (i > 0) staged.parent = e.parent;
+
+        sortBySlot(comps[i]);
+        staged.components.reserve(comps[i].size());
+        for (auto& [slot, comp] : comps[i]) staged.components.push_back(std::move(comp));
+        comps[i] = {};
+    }
+    const std::vector<Entity> roots = em.createBatch(std::move(batch));
+    return roots.empty() ? INVALID_ENTITY : roots.front();
+}
+
+bool writeFile(const std::string& path, const std::vector<uint8_t>& bytes) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        std::cerr << "[BinaryProject] Failed to write " << path << "\n";
+        return false;
+    }
+    out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    return static_cast<bool>(out);
+}
+
+Index::Index(const uint8_t* data, size_t size) : m_data(data), m_size(size) {
+    Reader reader(data, size);
+    const uint32_t count = reader.header().entityCount;
+    m_parents.resize(count);
+    for (uint32_t i = 0; i < count; ++i) m_parents[i] = reader.entity(i).parent;
+
+    // Counting sort of all rows by entity, then by slot within each entity
+    std::vector<std::pair<uint32_t, Row>> rows;
+    m_firstRow.assign(size_t(count) + 1, 0);
+    for (uint32_t b = 0; b < reader.header().blockCount; ++b) {
+        const BlockEntry block = reader.block(b);
+        for (uint32_t r = 0; r < block.rowCount; ++r) {
+            const RowEntry row = reader.row(block, r);
+            rows.emplace_back(row.entity, Row{ block.key, row.slot, row.fields, block.format == Format::Record });
+            ++m_firstRow[row.entity + 1];
+        }
+    }
+    for (uint32_t i = 0; i < count; ++i) m_firstRow[i + 1] += m_firstRow[i];
+
+    std::vector<uint32_t> next(m_firstRow.begin(), m_firstRow.end() - 1);
+    m_rows.resize(rows.size());
+    for (const auto& [entity, row] : rows) m_rows[next[entity]++] = row;
+    for (uint32_t i = 0; i < count; ++i) {
+        std::stable_sort(m_rows.begin() + m_firstRow[i], m_rows.begin() + m_firstRow[i + 1],
+                         [](const Row& a, const Row& b) { return a.slot < b.slot; });
+    }
+}
+
+nlohmann::json Index::shell(uint32_t entity) const {
+    Reader reader(m_data, m_size);
+    return reader.shell(reader.entity(entity));
+}
+
+nlohmann::json Index::components(uint32_t entity) const {
+    Reader reader(m_data, m_size);
+    nlohmann::json arr = nlohmann::json::array();
+    for (uint32_t r = m_firstRow[entity]; r < m_firstRow[entity + 1]; ++r) {
+        const Row& row = m_rows[r];
+        const BlockEntry block{ row.key, 0, 0, row.record ? Format::Record : Format::Json };
+        nlohmann::json comp = componentJson(reader, block, row.fields);
+        if (!comp.is_null() || !row.record) arr.push_back(std::move(comp));
+    }
+    return arr;
+}
+
+void Index::stageComponents(uint32_t entity, StagedEntity& out) const {
+    Reader reader(m_data, m_size);
+    EntityRefs::Staging refs(out.refs);
+    for (uint32_t r = m_firstRow[entity]; r < m_firstRow[entity + 1]; ++r) {
+        const Row& row = m_rows[r];
+        if (row.key == NONE) {
+            std::cerr << "[Deserialization] Skipping component with no type field\n";
+            continue;
+        }
+        std::shared_ptr<ComponentBase> comp;
+        if (row.record) {
+            if (const auto* reg = registered(reader.string(row.key)); reg && reg->decode) comp = decodeRecord(reader, *reg, row.fields);
+        } else {
+            comp = EntityManager::loadComponent(componentJson(reader, { row.key, 0, 0, Format::Json }, row.fields));
+        }
+        if (comp) out.components.push_back(std::move(comp));
+    }
+}
+
+size_t Index::componentBytes(uint32_t entity) const {
+    Reader reader(m_data, m_size);
+    size_t total = 0;
+    for (uint32_t r = m_firstRow[entity]; r < m_firstRow[entity + 1]; ++r) {
+        const Row& row = m_rows[r];
+        total += row.record ? reader.record(row.fields).remaining() : reader.valueSize(row.fields);
+    }
+    return total;
+}
+
+std::vector<uint32_t> Index::entitiesWith(std::string_view typeKey) const {
+    Reader reader(m_data, m_size);
+    std::vector<uint32_t> out;
+    for (uint32_t i = 0; i + 1 < m_firstRow.size(); ++i) {
+        for (uint32_t r = m_firstRow[i]; r < m_firstRow[i + 1]; ++r) {
+            if (m_rows[r].key != NONE && reader.string(m_rows[r].key) == typeKey) {
+                out.push_back(i);
+                break;
+            }
+        }
+    }
+    return out;
+}
+
+}
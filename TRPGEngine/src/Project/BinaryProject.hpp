@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <json.hpp>
+
+#include "Engine/EntitySystem/Entity.hpp"
+#include "Engine/EntitySystem/EntityBatch.hpp"
+
+class EntityManager;
+
+/**
+ * Binary project files (.trpgbin): the entity tree EntityManager::serializeEntity()
+ * produces, laid out for loading straight from a memory mapping.
+ *
+ *   Header   magic "TRPGPRJB", version, file size, then count + offset of
+ *            the string, entity and block tables
+ *   Strings  {offset, length} per string; every key, name and string value
+ *            is stored once, NUL-terminated
+ *   Entities {parent index, flags, _meta value, extra keys value}, parents
+ *            before children, in the order the JSON lists them
+ *   Blocks   one per component type key and format: rows of {entity
+ *            index, position in the entity's "components" array, fields}
+ *   Records  fields of registered component types, as their binary record
+ *            (ComponentTypeRegistry encode/decode)
+ *   Values   tagged nulls, booleans, numbers, string indices, arrays and
+ *            objects of child offsets: entity metadata, prefab overrides and
+ *            the fields of components no type is registered for
+ *
+ * All offsets are from the start of the file and 4-byte aligned; numbers are
+ * little-endian. A value's children come before it in the file; readers
+ * refuse values nested more than 256 deep or with more nodes than the file
+ * has room for. Version 1 files store every component as a value and still
+ * load. A component whose record would not decode to the JSON it came from
+ * (keys the type does not read, values it normalizes) is kept as a value in
+ * the type's JSON block instead, so decode() returns what encode() was given.
+ */
+namespace BinaryProject {
+
+    constexpr uint32_t VERSION = 2;
+    constexpr const char* EXTENSION = ".trpgbin";
+
+    bool isBinary(const uint8_t* data, size_t size);
+    bool isBinaryFile(const std::string& path);
+
+    // Builds each registered component from its JSON to write its record;
+    // references are written back as the GUIDs the JSON holds
+    std::vector<uint8_t> encode(const nlohmann::json& root);
+    // Throws std::runtime_error if the data is truncated, corrupt or of a newer version
+    nlohmann::json decode(const uint8_t* data, size_t size);
+
+    // Creates the encoded entities in `em` and returns the root. Components
+    // are decoded one at a time from their records, so the whole file never
+    // exists as a JSON document. Throws like decode().
+    Entity load(EntityManager& em, const uint8_t* data, size_t size);
+
+    bool writeFile(const std::string& path, const std::vector<uint8_t>& bytes);
+
+    /**
+     * One entity at a time out of an encoded project, for loading parts of it
+     * later (SceneStreamer). The constructor walks the block tables once to
+     * find every entity's component rows; nothing is decoded until asked
+     * for. `data` must outlive the index. Throws like decode().
+     */
+    class Index {
+    public:
+        static constexpr uint32_t NO_PARENT = UINT32_MAX;
+
+        Index(const uint8_t* data, size_t size);
+
+        uint32_t entityCount() const { return static_cast<uint32_t>(m_parents.size()); }
+        uint32_t parentOf(uint32_t entity) const { return m_parents[entity]; }     // NO_PARENT for the root
+        // The entity's JSON without "components" and "children"
+        nlohmann::json shell(uint32_t entity) const;
+        // Its "components" array as saved
+        nlohmann::json components(uint32_t entity) const;
+        // The same built by their loaders into `out.components`, with their
+        // references staged into `out.refs`
+        void stageComponents(uint32_t entity, StagedEntity& out) const;
+        // Encoded size of its components: a rough measure of what loading them costs
+        size_t componentBytes(uint32_t entity) const;
+        // Entities with a component saved under this type key, in file order
+        std::vector<uint32_t> entitiesWith(std::string_view typeKey) const;
+
+    private:
+        struct Row {
+            uint32_t key, slot, fields;     // key: string index of the type, or none
+            bool record;                    // fields is a record, not a value
+        };
+
+        const uint8_t* m_data;
+        size_t m_size;
+        std::vector<uint32_t> m_parents;
+        std::vector<uint32_t> m_firstRow;   // rows of entity i: [m_firstRow[i], m_firstRow[i + 1])
+        std::vector<Row> m_rows;            // by entity, then by position in "components"
+    };
+}
@@ -1,7 +1,9 @@
 #include "BuildSystem.hpp"
 #include "ProjectManager.hpp"
+#include "SceneStreamer.hpp"
 #include "Engine/EntitySystem/EntityManager.hpp"
 #include "Resources/ResourceManager.hpp"
+#include "Core/JobSystem.hpp"
 #include <filesystem>
 #include <fstream>
 #include <iostream>
@@ -23,6 +25,7 @@ bool BuildSystem::buildProject(const std::string& projectPath, const std::string
     fs::path sceneOut = fs::path(outputDirectory) / "Entities";
     fs::create_directories(sceneOut);
 
+    SceneStreamer::get().loadAll(EntityManager::get());   // scenes not paged in yet are built too
     for (auto entity : EntityManager::get().getAllEntities()) {
         json j = EntityManager::get().serializeEntity(entity);
         std::string fileName = "entity_" + std::to_string(entity) + ".entity";
@@ -48,11 +51,24 @@ void BuildSystem::copyAssets(const std::string& from, const std::string& to) {
 
         fs::create_directories(to);
 
+        // Create the directory tree up front, then copy the files in parallel
+        std::vector<fs::path> files;
         for (auto& entry : fs::recursive_directory_iterator(from)) {
             const auto& path = entry.path();
-            auto relativePath = fs::relative(path, from);
-            fs::copy(path, fs::path(to) / relativePath, fs::copy_options::overwrite_existing | fs::copy_options::recursive);
+            if (entry.is_directory()) {
+                fs::create_directories(fs::path(to) / fs::relative(path, from));
+            } else {
+                files.push_back(path);
+            }
         }
+
+        JobSystem::get().parallelFor(0, files.size(), 4, [&](size_t i) {
+            std::error_code ec;
+            fs::copy_file(files[i], fs::path(to) / fs::relative(files[i], from), fs::copy_options::overwrite_existing, ec);
+            if (ec) {
+                std::cerr << "[BuildSystem] Failed to copy " << files[i] << ": " << ec.message() << "\n";
+            }
+        });
     } catch (const std::exception& e) {
         std::cerr << "[BuildSystem] Asset copy failed: " << e.what() << "\n";
     }
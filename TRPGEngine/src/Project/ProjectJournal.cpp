@@ -0,0 +1,361 @@
+#include "ProjectJournal.hpp"
+#include "Engine/EntitySystem/EntityManager.hpp"
+#include "Engine/EntitySystem/EntityRefs.hpp"
+#include "Engine/EntitySystem/EntityRemap.hpp"
+#include "Engine/EntitySystem/PrefabManager.hpp"
+#include "Core/DurableFile.hpp"
+#include "Core/MappedFile.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <json.hpp>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+using json = nlohmann::json;
+namespace fs = std::filesystem;
+
+namespace {
+    constexpr char MAGIC[4] = { 'T', 'J', 'N', 'L' };
+    constexpr size_t SEGMENT_HEADER = 12;   // magic, payload size, checksum
+
+    uint32_t fnv1a(const char* data, size_t size) {
+        uint32_t h = 2166136261u;
+        for (size_t i = 0; i < size; ++i) {
+            h ^= static_cast<uint8_t>(data[i]);
+            h *= 16777619u;
+        }
+        return h;
+    }
+
+    void putU32(char* out, uint32_t v) {
+        for (int i = 0; i < 4; ++i) out[i] = static_cast<char>((v >> (8 * i)) & 0xFF);
+    }
+
+    uint32_t getU32(const char* in) {
+        uint32_t v = 0;
+        for (int i = 0; i < 4; ++i) v |= uint32_t(static_cast<uint8_t>(in[i])) << (8 * i);
+        return v;
+    }
+
+    uint64_t fileSize(const std::string& path) {
+        std::error_code ec;
+        const auto size = fs::file_size(path, ec);
+        return ec ? 0 : static_cast<uint64_t>(size);
+    }
+
+    // Identifies the snapshot a journal continues. Sizes alone collide too
+    // easily (a same-length edit, a file swapped in by version control), and
+    // a stale journal replayed over a newer snapshot would undo its changes.
+    // FNV-1a over 64-bit words: one pass over the mapped file.
+    uint64_t snapshotHash(const std::string& path) {
+        MappedFile file(path);
+        if (!file.isOpen()) return 0;
+        const uint8_t* data = file.data();
+        const size_t size = file.size();
+        uint64_t h = 14695981039346656037ull ^ size;
+        size_t i = 0;
+        for (; i + 8 <= size; i += 8) {
+            uint64_t word;
+            std::memcpy(&word, data + i, 8);
+            h = (h ^ word) * 1099511628211ull;
+        }
+        for (; i < size; ++i) h = (h ^ data[i]) * 1099511628211ull;
+        return h ^ (h >> 32);
+    }
+
+    // Writes one segment and returns once it has reached the disk, so a save
+    // reported as done survives a crash or power loss
+    bool writeSegment(const std::string& path, const std::string& payload, bool truncate) {
+        char header[SEGMENT_HEADER];
+        std::copy(MAGIC, MAGIC + 4, header);
+        putU32(header + 4, static_cast<uint32_t>(payload.size()));
+        putU32(header + 8, fnv1a(payload.data(), payload.size()));
+
+        const bool ok = DurableFile::write(path, { { header, sizeof(header) }, { payload.data(), payload.size() } }, !truncate);
+        if (!ok) std::cerr << "[ProjectJournal] Failed to write " << path << "\n";
+        return ok;
+    }
+
+    // Entities new in a segment exist before any record is applied, so
+    // parents and component references among them resolve in any order
+    Entity findOrCreate(EntityManager& em, uint64_t guid) {
+        Entity e = em.findByGuid(guid);
+        if (e == INVALID_ENTITY) {
+            e = em.createEntity();
+            em.setGuid(e, guid);
+        }
+        return e;
+    }
+
+    void applyRecord(EntityManager& em, Entity root, const json& rec) {
+        const uint64_t guid = rec.at("guid").get<uint64_t>();
+        const Entity e = findOrCreate(em, guid);
+
+        if (rec.contains("meta")) {
+            const json& metaJ = rec["meta"];
+            em.setEntityMeta(e, metaJ.value("name", "Unnamed"), static_cast<EntityType>(metaJ.value("type", 0)));
+
+            const uint64_t parentGuid = metaJ.value("parent", uint64_t(0));
+            Entity parent = INVALID_ENTITY;
+            if (parentGuid != 0) {
+                parent = em.findByGuid(parentGuid);
+                if (parent == INVALID_ENTITY) {
+                    std::cerr << "[ProjectJournal] Parent of " << guid << " is missing; attaching it to the project root\n";
+                    parent = root;
+                }
+            }
+            if (em.getParent(e) != parent) em.setEntityParent(e, parent);   // keeps sibling order when unchanged
+
+            const std::string prefabId = metaJ.value("prefab", "");
+            const auto& current = em.getMeta(e)->prefab;
+            if (prefabId.empty()) {
+                em.getMeta(e)->prefab.reset();
+            } else if (!current || current->path != PrefabManager::get().pathForId(prefabId)) {
+                if (auto prefab = PrefabManager::get().load(prefabId)) {
+                    em.linkPrefab(e, prefab);
+                } else {
+                    std::cerr << "[ProjectJournal] Missing prefab " << prefabId << " for " << guid << "\n";
+                }
+            }
+        }
+
+        // Changed components replace the stored ones in a single archetype move
+        if (rec.contains("components")) {
+            std::vector<std::shared_ptr<ComponentBase>> comps;
+            std::vector<uint64_t> refs;
+            {
+                EntityRefs::Staging staging(refs);
+                for (const auto& compJ : rec["components"]) {
+                    if (auto comp = EntityManager::loadComponent(compJ)) comps.push_back(std::move(comp));
+                }
+            }
+            EntityRemap remap(&em);
+            remap.setRefs(&refs);
+            for (const auto& comp : comps) {
+                comp->remapEntities(remap);
+                if (em.hasComponent(e, comp->getType())) em.removeComponent(e, comp->getType());
+            }
+            if (!comps.empty()) em.addComponents(e, std::move(comps));
+        }
+        if (rec.contains("removed")) {
+            for (const auto& key : rec["removed"]) {
+                try {
+                    em.removeComponent(e, ComponentTypeRegistry::getTypeFromString(key.get<std::string>()));
+                } catch (const std::exception& ex) {
+                    std::cerr << "[ProjectJournal] " << ex.what() << "\n";
+                }
+            }
+        }
+    }
+}
+
+std::string ProjectJournal::pathFor(const std::string& projectPath) {
+    return projectPath + EXTENSION;
+}
+
+bool ProjectJournal::replay(EntityManager& em, Entity root, const std::string& projectPath,
+                            const std::function<void(Entity)>& beforeChange) {
+    const std::string path = pathFor(projectPath);
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) return false;
+    std::ostringstream buffer;
+    buffer << in.rdbuf();
+    in.close();
+    const std::string data = buffer.str();
+
+    size_t offset = 0, segments = 0;
+    bool belongs = false;
+    while (offset + SEGMENT_HEADER <= data.size()) {
+        const char* header = data.data() + offset;
+        if (!std::equal(MAGIC, MAGIC + 4, header)) break;
+        const size_t size = getU32(header + 4);
+        if (size > data.size() - offset - SEGMENT_HEADER) break;
+        const char* payload = header + SEGMENT_HEADER;
+        if (fnv1a(payload, size) != getU32(header + 8)) break;
+
+        try {
+            const json segment = json::parse(payload, payload + size);
+            if (offset == 0) {
+                belongs = segment.value("snapshotSize", uint64_t(0)) == fileSize(projectPath)
+                       && segment.value("snapshotHash", uint64_t(0)) == snapshotHash(projectPath);
+                if (!belongs) break;
+            } else {
+                if (segment.contains("entities")) {
+                    for (const auto& rec : segment["entities"]) {
+                        const uint64_t guid = rec.at("guid").get<uint64_t>();
+                        if (beforeChange) {
+                            if (const Entity e = em.findByGuid(guid); e != INVALID_ENTITY) beforeChange(e);
+                        }
+                        findOrCreate(em, guid);
+                    }
+                    for (const auto& rec : segment["entities"]) applyRecord(em, root, rec);
+                }
+                if (segment.contains("destroyed")) {
+                    for (const auto& guid : segment["destroyed"]) {
+                        const Entity e = em.findByGuid(guid.get<uint64_t>());
+                        if (e != INVALID_ENTITY) em.destroyEntity(e);
+                    }
+                }
+                ++segments;
+            }
+        } catch (const std::exception& ex) {
+            std::cerr << "[ProjectJournal] Stopping at a bad segment in " << path << ": " << ex.what() << "\n";
+            break;
+        }
+        offset += SEGMENT_HEADER + size;
+    }
+
+    std::error_code ec;
+    if (!belongs) {
+        std::cerr << "[ProjectJournal] " << path << " does not belong to " << projectPath << "; removing it\n";
+        fs::remove(path, ec);
+        return false;
+    }
+    if (offset < data.size()) {
+        std::cerr << "[ProjectJournal] Dropping " << (data.size() - offset) << " unreadable bytes at the end of " << path << "\n";
+        fs::resize_file(path, offset, ec);
+    }
+    std::cout << "[ProjectJournal] Replayed " << segments << " journal segment(s) from " << path << "\n";
+    return true;
+}
+
+bool ProjectJournal::start(EntityManager& em, Entity root, const std::string& projectPath) {
+    stop();
+    const std::string header = json{ {"snapshotSize", fileSize(projectPath)}, {"snapshotHash", snapshotHash(projectPath)} }.dump();
+    if (!writeSegment(pathFor(projectPath), header, true)) return false;
+    track(em, root, projectPath);
+    return true;
+}
+
+void ProjectJournal::resume(EntityManager& em, Entity root, const std::string& projectPath) {
+    track(em, root, projectPath);
+}
+
+void ProjectJournal::track(EntityManager& em, Entity root, const std::string& projectPath) {
+    m_projectPath = projectPath;
+    m_root = root;
+    m_snapshotSize = fileSize(projectPath);
+    m_journalSize = fileSize(pathFor(projectPath));
+    m_version = em.getVersion();
+    m_known.clear();
+    em.forEachInSubtree(root, [&](Entity e, int) { m_known[e] = em.getMeta(e)->guid; });
+}
+
+void ProjectJournal::stop() {
+    m_projectPath.clear();
+    m_root = INVALID_ENTITY;
+    m_known.clear();
+}
+
+bool ProjectJournal::isActiveFor(const std::string& projectPath, Entity root) const {
+    return !m_projectPath.empty() && m_projectPath == projectPath && m_root == root;
+}
+
+bool ProjectJournal::shouldCompact() const {
+    return m_journalSize > std::max(COMPACT_MIN_SIZE, m_snapshotSize / 2);
+}
+
+ProjectJournal::AppendResult ProjectJournal::append(EntityManager& em) {
+    if (m_projectPath.empty() || !em.entityExists(m_root) || !em.changeLogCovers(m_version)) {
+        return AppendResult::NeedsSnapshot;
+    }
+    const EntityManager& cem = em;     // const reads never unshare prefab or forked components
+
+    struct Change {
+        bool meta = false;
+        ComponentMask types;
+    };
+    std::unordered_map<Entity, Change> changes;
+    cem.forEachChangeSince(m_version, [&](const EntityManager::ComponentChange& c) {
+        Change& change = changes[c.entity];
+        if (c.type == ComponentType::Unknown) change.meta = true;
+        else change.types.set(static_cast<size_t>(c.type));
+    });
+
+    // Entities that left the project (destroyed or moved out) are dropped by guid
+    std::vector<std::pair<int, Entity>> live;
+    json destroyed = json::array();
+    std::vector<Entity> forgotten;
+    for (const auto& [e, change] : changes) {
+        if (cem.entityExists(e) && cem.getRoot(e) == m_root) {
+            int depth = 0;
+            for (Entity p = cem.getParent(e); p != INVALID_ENTITY; p = cem.getParent(p)) ++depth;
+            live.emplace_back(depth, e);
+        } else if (auto it = m_known.find(e); it != m_known.end()) {
+            destroyed.push_back(it->second);
+            forgotten.push_back(e);
+        }
+    }
+    std::sort(live.begin(), live.end());    // parents before children
+
+    json entities = json::array();
+    std::unordered_map<Entity, uint64_t> learned;
+    auto writeRecord = [&](Entity e, bool whole, const Change* change) {
+        const EntityMeta* meta = cem.getMeta(e);
+        const Prefab* prefab = meta->prefab.get();
+        json rec = { {"guid", meta->guid} };
+
+        if (whole || change->meta) {
+            const Entity parent = cem.getParent(e);
+            json metaJ = {
+                {"name", meta->name},
+                {"type", static_cast<int>(meta->type)},
+                {"parent", parent != INVALID_ENTITY ? cem.getMeta(parent)->guid : uint64_t(0)},
+            };
+            if (prefab) metaJ["prefab"] = PrefabManager::get().idForPath(prefab->path);
+            rec["meta"] = std::move(metaJ);
+        }
+
+        for (size_t t = 0; t < COMPONENT_TYPE_COUNT; ++t) {
+            const auto type = static_cast<ComponentType>(t);
+            if (type == ComponentType::Unknown) continue;
+            const bool has = cem.hasComponent(e, type);
+            if (whole ? !(has || (prefab && prefab->find(type) >= 0)) : !change->types.test(t)) continue;
+
+            const auto* reg = ComponentTypeRegistry::getInfo(type);
+            if (!reg) continue;
+            if (has) {
+                json compJ = cem.getComponent(e, type)->toJson();
+                compJ["type"] = reg->key;
+                rec["components"].push_back(std::move(compJ));
+            } else {
+                rec["removed"].push_back(reg->key);
+            }
+        }
+        entities.push_back(std::move(rec));
+        learned[e] = meta->guid;
+    };
+
+    for (const auto& [depth, e] : live) {
+        if (learned.count(e)) continue;
+        const bool known = m_known.count(e) != 0;
+        writeRecord(e, !known, &changes[e]);
+        if (known) continue;
+
+        // A new entity brings its new descendants along, whether or not they changed since
+        cem.forEachInSubtree(e, [&](Entity d, int) {
+            if (d != e && !m_known.count(d) && !learned.count(d)) writeRecord(d, true, nullptr);
+        });
+    }
+
+    if (entities.empty() && destroyed.empty()) {
+        m_version = em.getVersion();
+        return AppendResult::NothingChanged;
+    }
+
+    const std::string payload = json{ {"entities", std::move(entities)}, {"destroyed", std::move(destroyed)} }.dump();
+    if (!writeSegment(pathFor(m_projectPath), payload, false)) return AppendResult::Failed;
+
+    for (Entity e : forgotten) m_known.erase(e);
+    for (const auto& [e, guid] : learned) m_known[e] = guid;
+    m_journalSize += SEGMENT_HEADER + payload.size();
+    m_version = em.getVersion();
+    std::cout << "[ProjectJournal] Appended " << learned.size() << " entities, " << forgotten.size()
+              << " removed (" << payload.size() << " bytes) to " << pathFor(m_projectPath) << "\n";
+    return AppendResult::Ok;
+}
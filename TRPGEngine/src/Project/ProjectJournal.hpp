@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+
+#include "Engine/EntitySystem/Entity.hpp"
+
+class EntityManager;
+
+/**
+ * Append-only change journal kept next to a project file (<project>.journal).
+ * Each incremental save appends one segment with the entities and components
+ * that changed since the previous one, keyed by their "_meta.guid"; loading
+ * the project replays the segments over the snapshot.
+ *
+ *   Segment  magic "TJNL", payload size, FNV-1a of the payload, JSON payload
+ *   First    {"snapshotSize": N, "snapshotHash": H}: the journal belongs to
+ *            the snapshot of that size and content hash
+ *   Others   {"entities": [...], "destroyed": [guid, ...]}, parents before children
+ *
+ * Entity records hold absolute values (whole components, whole meta), so
+ * replaying a segment twice does no harm. A segment whose checksum does not
+ * match ends the journal: a save cut short by a crash loses only itself.
+ */
+class ProjectJournal {
+public:
+    static constexpr const char* EXTENSION = ".journal";
+    static std::string pathFor(const std::string& projectPath);
+
+    enum class AppendResult { Ok, NothingChanged, NeedsSnapshot, Failed };
+
+    // Applies the journal of `projectPath` to the snapshot just loaded under
+    // `root`. A journal written for another snapshot is deleted, a torn tail
+    // cut off. True if the journal belongs to this snapshot. `beforeChange`
+    // sees each entity already loaded before a record changes it, so a
+    // SceneStreamer can page its scene in first.
+    static bool replay(EntityManager& em, Entity root, const std::string& projectPath,
+                       const std::function<void(Entity)>& beforeChange = {});
+
+    // Begins an empty journal for the snapshot just written to `projectPath`
+    bool start(EntityManager& em, Entity root, const std::string& projectPath);
+    // Continues the journal replay() accepted
+    void resume(EntityManager& em, Entity root, const std::string& projectPath);
+    void stop();
+
+    bool isActiveFor(const std::string& projectPath, Entity root) const;
+    // Writes everything under the root that changed since start(), resume()
+    // or the last append(). NeedsSnapshot when the changes cannot be told
+    // apart any more (the world was cleared); the caller saves in full then.
+    AppendResult append(EntityManager& em);
+
+    // True once replaying the journal would cost a fair share of reloading
+    // the snapshot, i.e. it is time for a full save
+    bool shouldCompact() const;
+    uint64_t getJournalSize() const { return m_journalSize; }
+
+private:
+    std::string m_projectPath;
+    Entity m_root = INVALID_ENTITY;
+    uint64_t m_snapshotSize = 0;
+    uint64_t m_journalSize = 0;                     // size of the journal file
+    uint64_t m_version = 0;                         // EntityManager::getVersion() already written
+    std::unordered_map<Entity, uint64_t> m_known;   // guid of each entity a replay would recreate
+
+    static constexpr uint64_t COMPACT_MIN_SIZE = 1u << 20;
+
+    void track(EntityManager& em, Entity root, const std::string& projectPath);
+};
@@ -1,12 +1,21 @@
 #include "ProjectManager.hpp"
 #include "Resources/ResourceManager.hpp"
 #include "UI/EditorUI.hpp"
+#include "Engine/EntitySystem/PrefabManager.hpp"
+#include "Engine/World.hpp"
+#include "Project/AutosaveService.hpp"
+#include "Project/BinaryProject.hpp"
+#include "Project/SceneStreamer.hpp"
+#include "Core/DurableFile.hpp"
+#include "Core/MappedFile.hpp"
 
 #include <json.hpp>
 #include <fstream>
 #include <filesystem>
+#include <chrono>
 #include <ctime>
 #include <iostream>
+#include <sstream>
 
 using json = nlohmann::json;
 namespace fs = std::filesystem;
@@ -15,6 +24,7 @@ Entity ProjectManager::s_projectMetaEntity = INVALID_ENTITY;
 
 std::string ProjectManager::s_currentProjectPath = "";
 std::string ProjectManager::s_tempLoadPath = "";
+ProjectJournal ProjectManager::s_journal;
 
 static std::string ensureTrpgExtension(const std::string& path) {
     fs::path p(path);
@@ -34,13 +44,15 @@ bool ProjectManager::CreateNewProject(const std::string& projectName, const std:
         return false;
     }
 
+    SceneStreamer::get().close();
+
     // Create project meta entity
     s_projectMetaEntity = EntityManager::get().createEntity();
     EntityManager::get().setEntityMeta(s_projectMetaEntity, projectName, EntityType::ProjectMeta);
     setProjectMetaEntity(s_projectMetaEntity);
 
     {
-        auto meta = std::make_shared<ProjectMetaComponent>();
+        auto meta = makeComponent<ProjectMetaComponent>();
         meta->projectName = projectName.empty() ? "Untitled" : projectName;
         meta->version     = "1.0.0";
         meta->author      = "Unknown";
@@ -69,6 +81,12 @@ void ProjectManager::setProjectMetaEntity(Entity e) {
     s_projectMetaEntity = e;
 }
 
+// Prefab ids in a project file are relative to its folder
+static void resetPrefabs(const std::string& projectPath) {
+    PrefabManager::get().clear();  // pick up prefab files edited since the last load
+    PrefabManager::get().setProjectDir(fs::path(projectPath).parent_path().string());
+}
+
 bool ProjectManager::saveProjectToFile(const std::string& filePath) {
     if (s_projectMetaEntity == INVALID_ENTITY) {
         std::cerr << "[ProjectManager] No project meta entity to save.\n";
@@ -76,46 +94,238 @@ bool ProjectManager::saveProjectToFile(const std::string& filePath) {
     }
 
     nlohmann::json projectJson = EntityManager::get().serializeEntity(s_projectMetaEntity);
+    SceneStreamer& streamer = SceneStreamer::get();
+    streamer.coldEntities(EntityManager::get()).restore(projectJson);     // scenes not paged in
+    PrefabManager::get().rebaseIds(projectJson, fs::path(filePath).parent_path().string());     // Save As / export elsewhere
 
-    std::ofstream out(filePath);
-    if (!out.is_open()) {
+    // Written next to the target and renamed over it, so a crash mid-save
+    // leaves the previous file intact
+    const std::string tempPath = filePath + ".tmp";
+    bool written = false;
+    if (fs::path(filePath).extension() == BinaryProject::EXTENSION) {
+        std::vector<uint8_t> bytes;
+        try {
+            bytes = BinaryProject::encode(projectJson);
+        } catch (const std::exception& ex) {
+            std::cerr << "[ProjectManager] Failed to encode project: " << ex.what() << "\n";
+            return false;
+        }
+        written = DurableFile::write(tempPath, bytes.data(), bytes.size());
+    } else {
+        const std::string text = projectJson.dump(4);
+        written = DurableFile::write(tempPath, text.data(), text.size());
+    }
+    if (!written) {
         std::cerr << "[ProjectManager] Failed to write project file: " << filePath << "\n";
+        std::error_code ec;
+        fs::remove(tempPath, ec);
         return false;
     }
 
-    out << projectJson.dump(4);
+    // A memory-mapped file cannot be replaced on every platform
+    if (streamer.isOpenFor(EntityManager::get())) {
+        AutosaveService::get().wait();
+        streamer.releaseFile(filePath);
+    }
+
+    std::error_code ec;
+    fs::rename(tempPath, filePath, ec);
+    if (ec) {
+        std::cerr << "[ProjectManager] Failed to replace " << filePath << ": " << ec.message() << "\n";
+        fs::remove(tempPath, ec);
+        return false;
+    }
     std::cout << "[ProjectManager] Project saved to " << filePath << "\n";
 
+    // The snapshot now holds everything; the journal restarts from it
+    if (filePath == s_currentProjectPath) {
+        streamer.rebase(EntityManager::get(), projectJson, filePath);
+        s_journal.start(EntityManager::get(), s_projectMetaEntity, filePath);
+        AutosaveService::get().discard(filePath);
+    } else {
+        fs::remove(ProjectJournal::pathFor(filePath), ec);
+    }
+
     ResourceManager::get().setUnsavedChanges(false);
     return true;
 }
 
 bool ProjectManager::save() {
     if (s_currentProjectPath.empty()) return false;
+
+    if (s_incrementalSave && s_journal.isActiveFor(s_currentProjectPath, s_projectMetaEntity)) {
+        const auto result = s_journal.append(EntityManager::get());
+        if (result == ProjectJournal::AppendResult::Ok || result == ProjectJournal::AppendResult::NothingChanged) {
+            if (!s_journal.shouldCompact()) {
+                AutosaveService::get().discard(s_currentProjectPath);
+                ResourceManager::get().setUnsavedChanges(false);
+                return true;
+            }
+            std::cout << "[ProjectManager] Compacting the journal into " << s_currentProjectPath << "\n";
+        }
+    }
     return saveProjectToFile(s_currentProjectPath);
 }
 
 bool ProjectManager::loadProject(const std::string& filePath) {
-    std::ifstream in(filePath);
-    if (!in.is_open()) {
-        std::cerr << "[ProjectManager] Failed to open project file: " << filePath << "\n";
-        return false;
-    }
+    s_journal.stop();
+    SceneStreamer::get().close();
+    if (s_lazyLoading) {
+        if (!fs::exists(filePath)) {
+            std::cerr << "[ProjectManager] Failed to open project file: " << filePath << "\n";
+            return false;
+        }
+        EntityManager::get().clear();  // reset scene
+        resetPrefabs(filePath);
+        Entity root = INVALID_ENTITY;
+        try {
+            root = SceneStreamer::get().open(EntityManager::get(), filePath);
+        } catch (const std::exception& ex) {
+            std::cerr << "[ProjectManager] Failed to load " << filePath << ": " << ex.what() << "\n";
+            SceneStreamer::get().close();
+            EntityManager::get().clear();
+        }
+        setProjectMetaEntity(root);
+    } else if (BinaryProject::isBinaryFile(filePath)) {
+        MappedFile file(filePath);
+        if (!file.isOpen()) return false;
 
-    nlohmann::json rootJson;
-    in >> rootJson;
+        EntityManager::get().clear();  // reset scene
+        resetPrefabs(filePath);
+        Entity root = INVALID_ENTITY;
+        try {
+            root = BinaryProject::load(EntityManager::get(), file.data(), file.size());
+        } catch (const std::exception& ex) {
+            std::cerr << "[ProjectManager] Failed to load " << filePath << ": " << ex.what() << "\n";
+            EntityManager::get().clear();  // drop whatever was created before the error
+        }
+        setProjectMetaEntity(root);
+    } else {
+        std::ifstream in(filePath);
+        if (!in.is_open()) {
+            std::cerr << "[ProjectManager] Failed to open project file: " << filePath << "\n";
+            return false;
+        }
 
-    EntityManager::get().clear();  // reset scene
-    setProjectMetaEntity(EntityManager::get().deserializeEntity(rootJson));
+        EntityManager::get().clear();  // reset scene
+        resetPrefabs(filePath);
+        setProjectMetaEntity(EntityManager::get().deserializeEntity(in, filePath));   // streamed, no DOM
+    }
     EntityManager::get().setSelectedEntity(s_projectMetaEntity);
     if (s_projectMetaEntity == INVALID_ENTITY) {
         std::cerr << "[ProjectManager] Failed to load project meta entity.\n";
         return false;
     }
 
+    // Saves since the snapshot was written live in its journal; scenes it
+    // changes are paged in first and stay in (the file lacks those changes)
+    auto pageIn = [](Entity e) { SceneStreamer::get().pageIn(EntityManager::get(), e); };
+    if (ProjectJournal::replay(EntityManager::get(), s_projectMetaEntity, filePath, pageIn)) {
+        s_journal.resume(EntityManager::get(), s_projectMetaEntity, filePath);
+    }
+
     std::cout << "[ProjectManager] Project loaded from " << filePath << "\n";
     setCurrentProjectPath(filePath);
     ResourceManager::get().setUnsavedChanges(false);
+
+    if (AutosaveService::hasNewerAutosave(filePath)) {
+        std::cout << "[ProjectManager] " << AutosaveService::pathFor(filePath) << " is newer than the project\n";
+        if (auto* ui = EditorUI::get()) ui->setStatusMessage("An autosave newer than this project exists: Project > Recover Autosave");
+    }
+    return true;
+}
+
+bool ProjectManager::recoverAutosave() {
+    if (s_currentProjectPath.empty()) return false;
+    const std::string path = AutosaveService::pathFor(s_currentProjectPath);
+    AutosaveService::get().wait();
+
+    s_journal.stop();   // the autosave is not the snapshot the journal continues
+    SceneStreamer::get().close();
+    EntityManager::get().clear();
+    PrefabManager::get().clear();
+    Entity root = INVALID_ENTITY;
+    try {
+        root = AutosaveService::load(EntityManager::get(), path);
+    } catch (const std::exception& ex) {
+        std::cerr << "[ProjectManager] Failed to recover " << path << ": " << ex.what() << "\n";
+        EntityManager::get().clear();
+    }
+    setProjectMetaEntity(root);
+    if (root == INVALID_ENTITY) return false;
+
+    std::cout << "[ProjectManager] Recovered " << path << "\n";
+    ResourceManager::get().setUnsavedChanges(true);
+    return true;
+}
+
+bool ProjectManager::benchmarkLoad(const std::string& filePath) {
+    using Clock = std::chrono::steady_clock;
+    auto ms = [](Clock::duration d) { return std::chrono::duration<double, std::milli>(d).count(); };
+
+    // Bring the input to both formats first; only loading is timed
+    std::string jsonText;
+    std::vector<uint8_t> binary;
+    try {
+        if (BinaryProject::isBinaryFile(filePath)) {
+            MappedFile file(filePath);
+            if (!file.isOpen()) return false;
+            binary.assign(file.data(), file.data() + file.size());
+            jsonText = BinaryProject::decode(file.data(), file.size()).dump(4);
+        } else {
+            std::ifstream in(filePath, std::ios::binary);
+            if (!in.is_open()) {
+                std::cerr << "[ProjectManager] Failed to open project file: " << filePath << "\n";
+                return false;
+            }
+            std::ostringstream text;
+            text << in.rdbuf();
+            jsonText = text.str();
+            binary = BinaryProject::encode(nlohmann::json::parse(jsonText));
+        }
+    } catch (const std::exception& ex) {
+        std::cerr << "[ProjectManager] Benchmark could not read " << filePath << ": " << ex.what() << "\n";
+        return false;
+    }
+
+    const fs::path binaryPath = fs::temp_directory_path() / ("trpg_benchmark" + std::string(BinaryProject::EXTENSION));
+    if (!BinaryProject::writeFile(binaryPath.string(), binary)) return false;
+
+    // Scratch worlds keep the open project out of it; their teardown is not timed
+    size_t entityCount = 0;
+    Clock::duration jsonTime{}, binaryTime{};
+    bool ok = true;
+    try {
+        World scratch;
+        World::Scope scope(scratch);
+        std::istringstream in(jsonText);
+        const auto start = Clock::now();
+        EntityManager::get().deserializeEntity(in, filePath);
+        jsonTime = Clock::now() - start;
+        entityCount = EntityManager::get().getEntityCount();
+    } catch (const std::exception& ex) {
+        std::cerr << "[ProjectManager] JSON load failed: " << ex.what() << "\n";
+        ok = false;
+    }
+    try {
+        World scratch;
+        World::Scope scope(scratch);
+        const auto start = Clock::now();
+        MappedFile file(binaryPath.string());
+        if (file.isOpen()) BinaryProject::load(EntityManager::get(), file.data(), file.size());
+        binaryTime = Clock::now() - start;
+    } catch (const std::exception& ex) {
+        std::cerr << "[ProjectManager] Binary load failed: " << ex.what() << "\n";
+        ok = false;
+    }
+
+    std::error_code ec;
+    fs::remove(binaryPath, ec);
+    if (!ok) return false;
+
+    std::cout << "[ProjectManager] Load benchmark for " << filePath << " (" << entityCount << " entities): "
+              << "JSON " << ms(jsonTime) << " ms (" << jsonText.size() << " bytes), "
+              << "binary " << ms(binaryTime) << " ms (" << binary.size() << " bytes)\n";
     return true;
 }
 
@@ -125,6 +335,7 @@ std::string ProjectManager::getCurrentProjectPath() {
 
 void ProjectManager::setCurrentProjectPath(const std::string& path) {
     s_currentProjectPath = path;
+    PrefabManager::get().setProjectDir(fs::path(path).parent_path().string());
 }
 
 std::string ProjectManager::getTempLoadPath() {
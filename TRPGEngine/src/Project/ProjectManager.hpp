@@ -1,6 +1,7 @@
 #pragma once
 #include <string>
 #include "Engine/EntitySystem/EntityManager.hpp"
+#include "Project/ProjectJournal.hpp"
 
 class ProjectManager {
 public:
@@ -13,9 +14,29 @@ public:
 
     static bool CreateNewProject(const std::string& projectName, const std::string& projectPath);
     static bool loadProject(const std::string& path);
+    // Appends the changes since the last save to the project's journal when
+    // incremental saving is on, and writes a full snapshot when it is off,
+    // when there is no journal yet or once the journal has grown too large
     static bool save();
+    // Writes the binary format when the path ends in BinaryProject::EXTENSION, JSON otherwise
     static bool saveProjectToFile(const std::string& filePath);
 
+    // Replaces the open project with its autosave (AutosaveService); the
+    // project stays marked unsaved until the user saves it
+    static bool recoverAutosave();
+
+    // Times loading `filePath` as JSON and as binary into scratch worlds and
+    // logs the results; the open project is not touched
+    static bool benchmarkLoad(const std::string& filePath);
+
+    static void setIncrementalSave(bool enabled) { s_incrementalSave = enabled; }
+    static bool isIncrementalSave() { return s_incrementalSave; }
+
+    // Load only the scene headers and page scene content in on demand
+    // (SceneStreamer); takes effect with the next loadProject()
+    static void setLazyLoading(bool enabled) { s_lazyLoading = enabled; }
+    static bool isLazyLoading() { return s_lazyLoading; }
+
     static void setProjectMetaEntity(Entity e);
     static Entity getProjectMetaEntity() { return s_projectMetaEntity; }
 
@@ -26,6 +47,9 @@ private:
     static Entity s_projectMetaEntity;
     static std::string s_currentProjectPath;  // FULL path to .trpgproj
     static std::string s_tempLoadPath;
+    static ProjectJournal s_journal;
+    static inline bool s_incrementalSave = true;
+    static inline bool s_lazyLoading = false;
 
     static inline bool s_needProjectInfoPrompt = false;  // default off
 };
@@ -0,0 +1,405 @@
+#include "SceneStreamer.hpp"
+#include "Core/MappedFile.hpp"
+#include "Engine/EntitySystem/ComponentRegistry.hpp"
+#include "Engine/EntitySystem/EntityManager.hpp"
+#include "Engine/EntitySystem/EntityRefs.hpp"
+#include "Engine/EntitySystem/Components/FlowNodeComponent.hpp"
+#include "Engine/RenderSystem/SceneManager.hpp"
+#include "Project/BinaryProject.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <utility>
+
+struct SceneStreamer::Source {
+    MappedFile file;
+    std::vector<uint8_t> bytes;         // when not mapped
+    BinaryProject::Index index;
+
+    explicit Source(MappedFile&& mapped) : file(std::move(mapped)), index(file.data(), file.size()) {}
+    explicit Source(std::vector<uint8_t>&& data) : bytes(std::move(data)), index(bytes.data(), bytes.size()) {}
+};
+
+namespace {
+    uint64_t savedGuid(const nlohmann::json& shell) {
+        const auto meta = shell.find("_meta");
+        if (meta == shell.end() || !meta->is_object()) return 0;
+        const auto guid = meta->find("guid");
+        return guid != meta->end() && guid->is_number_unsigned() ? guid->get<uint64_t>() : 0;
+    }
+
+    bool hasNoComponents(const EntityManager& em, Entity e) {
+        for (size_t t = 0; t < COMPONENT_TYPE_COUNT; ++t) {
+            if (em.hasComponent(e, static_cast<ComponentType>(t))) return false;
+        }
+        return true;
+    }
+
+    // What paging an entity in loads: its components, prefab link and overrides
+    StagedEntity stage(const BinaryProject::Index& index, uint32_t entity) {
+        StagedEntity staged;
+        staged.shell = index.shell(entity);
+        index.stageComponents(entity, staged);
+        return staged;
+    }
+}
+
+SceneStreamer& SceneStreamer::get() {
+    static SceneStreamer instance;
+    return instance;
+}
+
+Entity SceneStreamer::open(EntityManager& em, const std::string& path) {
+    close();
+    std::shared_ptr<Source> source;
+    if (BinaryProject::isBinaryFile(path)) {
+        MappedFile file(path);
+        if (!file.isOpen()) return INVALID_ENTITY;
+        source = std::make_shared<Source>(std::move(file));
+    } else {
+        std::ifstream in(path);
+        if (!in.is_open()) {
+            std::cerr << "[SceneStreamer] Failed to open project file: " << path << "\n";
+            return INVALID_ENTITY;
+        }
+        source = std::make_shared<Source>(BinaryProject::encode(nlohmann::json::parse(in)));
+    }
+    m_source = source;
+
+    const BinaryProject::Index& index = source->index;
+    const uint32_t count = index.entityCount();
+    std::vector<nlohmann::json> shells(count);
+    for (uint32_t i = 0; i < count; ++i) shells[i] = index.shell(i);
+    scan(shells);
+
+    // Scene content goes in as bare entities; the rest loads as usual
+    std::vector<uint8_t> member(count, 0);
+    for (const auto& [guid, m] : m_members) member[m.fileIndex] = 1;
+
+    EntityBatch batch;
+    batch.entities.resize(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        StagedEntity& staged = batch.entities[i];
+        staged.shell = std::move(shells[i]);
+        if (index.parentOf(i) != BinaryProject::Index::NO_PARENT) staged.parent = index.parentOf(i);
+        if (member[i]) {
+            staged.shell.erase("overrides");
+            staged.shell.erase("removed");
+            if (auto meta = staged.shell.find("_meta"); meta != staged.shell.end() && meta->is_object()) meta->erase("prefab");
+        } else {
+            index.stageComponents(i, staged);
+        }
+    }
+    const std::vector<Entity> roots = em.createBatch(std::move(batch));
+    if (roots.empty()) {
+        close();
+        return INVALID_ENTITY;
+    }
+
+    m_em = &em;
+    m_path = path;
+    m_rootGuid = em.getGuid(roots.front());
+    std::cout << "[SceneStreamer] Opened " << path << ": " << m_scenes.size() << " scenes, "
+              << m_members.size() << " of " << count << " entities left unloaded\n";
+    return roots.front();
+}
+
+void SceneStreamer::close() {
+    m_source.reset();
+    m_path.clear();
+    m_em = nullptr;
+    m_rootGuid = 0;
+    m_scenes.clear();
+    m_sceneIndex.clear();
+    m_members.clear();
+    m_loadedBytes = 0;
+}
+
+bool SceneStreamer::belongsTo(const EntityManager& em) const {
+    return m_source && m_rootGuid != 0 && em.findByGuid(m_rootGuid) != INVALID_ENTITY;
+}
+
+bool SceneStreamer::isOpenFor(const EntityManager& em) const {
+    return &em == m_em && belongsTo(em);
+}
+
+size_t SceneStreamer::getLoadedSceneCount() const {
+    size_t n = 0;
+    for (const Scene& s : m_scenes) n += s.loaded ? 1 : 0;
+    return n;
+}
+
+// Scenes and their content, from the FlowNodes in the file. Only entities
+// with a saved GUID take part; anything else is loaded up front.
+void SceneStreamer::scan(const std::vector<nlohmann::json>& shells) {
+    m_scenes.clear();
+    m_sceneIndex.clear();
+    m_members.clear();
+
+    const BinaryProject::Index& index = m_source->index;
+    const uint32_t count = index.entityCount();
+    std::unordered_map<uint64_t, uint32_t> byGuid;
+    std::unordered_map<Entity, uint32_t> bySavedId;       // files written before GUID references
+    std::vector<std::vector<uint32_t>> children(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        if (const uint64_t guid = savedGuid(shells[i])) byGuid.emplace(guid, i);
+        const auto meta = shells[i].find("_meta");
+        if (meta != shells[i].end() && meta->is_object() && meta->contains("id") && (*meta)["id"].is_number_unsigned()) {
+            bySavedId.emplace(static_cast<Entity>((*meta)["id"].get<uint64_t>()), i);
+        }
+        if (index.parentOf(i) != BinaryProject::Index::NO_PARENT) children[index.parentOf(i)].push_back(i);
+    }
+
+    const auto* reg = ComponentTypeRegistry::getInfo(ComponentType::FlowNode);
+    if (!reg) return;
+    const std::vector<uint32_t> heads = index.entitiesWith(reg->key);
+    std::vector<uint8_t> isHead(count, 0);
+    for (uint32_t h : heads) isHead[h] = 1;
+
+    std::vector<uint32_t> seen(count, UINT32_MAX);     // scene that last reached each entity
+    std::vector<uint32_t> stack;
+    for (uint32_t h : heads) {
+        const uint64_t headGuid = savedGuid(shells[h]);
+        if (headGuid == 0 || h == 0 || m_sceneIndex.count(headGuid)) continue;
+
+        std::shared_ptr<FlowNodeComponent> node;
+        std::vector<uint64_t> refs;
+        {
+            EntityRefs::Staging staging(refs);
+            for (const auto& compJ : index.components(h)) {
+                if (compJ.value("type", "") == reg->key) node = FlowNodeComponent::fromJson(compJ);
+            }
+        }
+        if (!node) continue;
+
+        const uint32_t sceneIdx = static_cast<uint32_t>(m_scenes.size());
+        stack = children[h];
+        for (const auto* list : { &node->characters, &node->backgroundEntities, &node->eventSequence,
+                                  &node->uiLayer, &node->objectLayer }) {
+            for (Entity e : *list) {
+                const size_t slot = EntityRefs::placeholderSlot(e);
+                if (slot < refs.size()) {
+                    if (auto it = byGuid.find(refs[slot]); it != byGuid.end()) stack.push_back(it->second);
+                } else if (auto it = bySavedId.find(e); it != bySavedId.end()) {
+                    stack.push_back(it->second);
+                }
+            }
+        }
+
+        Scene scene;
+        scene.guid = headGuid;
+        while (!stack.empty()) {
+            const uint32_t i = stack.back();
+            stack.pop_back();
+            if (i == 0 || isHead[i] || seen[i] == sceneIdx) continue;
+            seen[i] = sceneIdx;
+            for (uint32_t c : children[i]) stack.push_back(c);
+
+            const uint64_t guid = savedGuid(shells[i]);
+            if (guid == 0) continue;
+            scene.members.push_back(guid);
+            scene.bytes += index.componentBytes(i);
+            m_members.emplace(guid, Member{ i, sceneIdx });
+        }
+        m_sceneIndex.emplace(headGuid, sceneIdx);
+        m_scenes.push_back(std::move(scene));
+    }
+}
+
+int SceneStreamer::findScene(const EntityManager& em, Entity e) const {
+    const uint64_t guid = em.getGuid(e);
+    if (auto it = m_sceneIndex.find(guid); it != m_sceneIndex.end()) return static_cast<int>(it->second);
+    if (auto it = m_members.find(guid); it != m_members.end()) return static_cast<int>(it->second.scene);
+    return -1;
+}
+
+void SceneStreamer::request(EntityManager& em, Entity e) {
+    const int idx = pageIn(em, e);
+    if (idx >= 0 && &em == m_em) trim(em, idx);
+}
+
+int SceneStreamer::pageIn(EntityManager& em, Entity e) {
+    if (!m_source || e == INVALID_ENTITY || !belongsTo(em)) return -1;
+    const int idx = findScene(em, e);
+    if (idx < 0) return -1;
+    Scene& scene = m_scenes[idx];
+
+    // A fork shares the streamed world's entities but not its bookkeeping:
+    // fill in whatever is still bare there and leave eviction to the original
+    if (&em != m_em) {
+        EntityBatch batch;
+        std::vector<Entity> targets;
+        for (uint64_t guid : scene.members) {
+            const Entity t = em.findByGuid(guid);
+            if (t == INVALID_ENTITY || !hasNoComponents(em, t)) continue;
+            batch.entities.push_back(stage(m_source->index, m_members.at(guid).fileIndex));
+            targets.push_back(t);
+        }
+        if (!targets.empty()) em.loadInto(std::move(batch), targets);
+        return idx;
+    }
+
+    scene.lastUsed = ++m_clock;
+    if (!scene.loaded) loadScene(em, scene);
+    return idx;
+}
+
+void SceneStreamer::loadAll(EntityManager& em) {
+    if (!isOpenFor(em)) return;
+    for (Scene& scene : m_scenes) {
+        if (!scene.loaded) loadScene(em, scene);
+    }
+}
+
+void SceneStreamer::loadScene(EntityManager& em, Scene& scene) {
+    EntityBatch batch;
+    std::vector<Entity> targets;
+    for (uint64_t guid : scene.members) {
+        Member& m = m_members.at(guid);
+        ++m.loadedScenes;
+        if (m.loaded) continue;     // another loaded scene lists it too
+        m.loaded = true;
+        const Entity t = em.findByGuid(guid);
+        if (t == INVALID_ENTITY) continue;
+        batch.entities.push_back(stage(m_source->index, m.fileIndex));
+        targets.push_back(t);
+    }
+    if (!targets.empty()) em.loadInto(std::move(batch), targets);
+    scene.loaded = true;
+    scene.loadedVersion = em.getVersion();
+    m_loadedBytes += scene.bytes;
+}
+
+void SceneStreamer::unloadScene(EntityManager& em, Scene& scene) {
+    for (uint64_t guid : scene.members) {
+        Member& m = m_members.at(guid);
+        if (--m.loadedScenes > 0) continue;
+        m.loaded = false;
+        if (const Entity t = em.findByGuid(guid); t != INVALID_ENTITY) em.unload(t);
+    }
+    scene.loaded = false;
+    m_loadedBytes -= scene.bytes;
+}
+
+// Changed since it was paged in: the file no longer has what it holds
+bool SceneStreamer::isEdited(const EntityManager& em, const Scene& scene) const {
+    for (uint64_t guid : scene.members) {
+        const Entity t = em.findByGuid(guid);
+        if (t != INVALID_ENTITY && em.getEntityVersion(t) > scene.loadedVersion) return true;
+    }
+    return false;
+}
+
+// Least recently used first. The scene just requested and the one on
+// screen stay, and so do edited ones.
+void SceneStreamer::trim(EntityManager& em, int keep) {
+    if (m_loadedBytes <= m_budget) return;
+    const int shown = &EntityManager::get() == &em ? findScene(em, SceneManager::get().getCurrentFlowNode()) : -1;
+
+    std::vector<uint32_t> candidates;
+    for (uint32_t i = 0; i < m_scenes.size(); ++i) {
+        if (m_scenes[i].loaded && int(i) != keep && int(i) != shown) candidates.push_back(i);
+    }
+    std::sort(candidates.begin(), candidates.end(),
+              [&](uint32_t a, uint32_t b) { return m_scenes[a].lastUsed < m_scenes[b].lastUsed; });
+
+    size_t evicted = 0;
+    for (uint32_t i : candidates) {
+        if (m_loadedBytes <= m_budget) break;
+        if (isEdited(em, m_scenes[i])) continue;
+        unloadScene(em, m_scenes[i]);
+        ++evicted;
+    }
+    if (evicted) {
+        std::cout << "[SceneStreamer] Evicted " << evicted << " scene(s); " << m_loadedBytes
+                  << " of " << m_budget << " bytes loaded\n";
+    }
+}
+
+SceneStreamer::ColdEntities SceneStreamer::coldEntities(const EntityManager& em) const {
+    ColdEntities cold;
+    if (!isOpenFor(em)) return cold;
+    for (const auto& [guid, m] : m_members) {
+        if (!m.loaded) cold.m_entities.emplace(guid, m.fileIndex);
+    }
+    if (!cold.m_entities.empty()) cold.m_source = m_source;
+    return cold;
+}
+
+void SceneStreamer::ColdEntities::restore(nlohmann::json& project) const {
+    if (empty()) return;
+    const BinaryProject::Index& index = m_source->index;
+    std::vector<nlohmann::json*> stack{ &project };
+    while (!stack.empty()) {
+        nlohmann::json& node = *stack.back();
+        stack.pop_back();
+        if (!node.is_object()) continue;
+
+        if (auto it = m_entities.find(savedGuid(node)); it != m_entities.end()) {
+            nlohmann::json comps = index.components(it->second);
+            if (!comps.empty()) node["components"] = std::move(comps);
+            nlohmann::json shell = index.shell(it->second);
+            for (const char* key : { "overrides", "removed" }) {
+                if (shell.contains(key)) node[key] = std::move(shell[key]);
+            }
+            if (shell["_meta"].contains("prefab")) node["_meta"]["prefab"] = std::move(shell["_meta"]["prefab"]);
+        }
+
+        if (auto children = node.find("children"); children != node.end() && children->is_array()) {
+            for (auto& child : *children) stack.push_back(&child);
+        }
+    }
+}
+
+void SceneStreamer::releaseFile(const std::string& path) {
+    if (!m_source || !m_source->file.isOpen() || path != m_path) return;
+    const MappedFile& file = m_source->file;
+    m_source = std::make_shared<Source>(std::vector<uint8_t>(file.data(), file.data() + file.size()));
+}
+
+void SceneStreamer::rebase(EntityManager& em, const nlohmann::json& project, const std::string& path) {
+    if (!isOpenFor(em)) return;
+
+    std::shared_ptr<Source> source;
+    if (BinaryProject::isBinaryFile(path)) {
+        MappedFile file(path);
+        if (file.isOpen()) source = std::make_shared<Source>(std::move(file));
+    }
+    if (!source) source = std::make_shared<Source>(BinaryProject::encode(project));
+
+    // Which entities hold their components now, and what was in use
+    std::unordered_map<uint64_t, bool> wasLoaded;
+    for (const auto& [guid, m] : m_members) wasLoaded.emplace(guid, m.loaded);
+    std::unordered_map<uint64_t, std::pair<bool, uint64_t>> oldScenes;     // loaded, lastUsed
+    for (const Scene& s : m_scenes) oldScenes.emplace(s.guid, std::make_pair(s.loaded, s.lastUsed));
+
+    m_source = source;
+    m_path = path;
+    const uint32_t count = source->index.entityCount();
+    std::vector<nlohmann::json> shells(count);
+    for (uint32_t i = 0; i < count; ++i) shells[i] = source->index.shell(i);
+    scan(shells);
+
+    for (auto& [guid, m] : m_members) {
+        const auto it = wasLoaded.find(guid);
+        m.loaded = it == wasLoaded.end() || it->second;     // only former cold members are bare
+    }
+
+    // A scene stays cold only if it was and all of its content still is
+    m_loadedBytes = 0;
+    for (Scene& scene : m_scenes) {
+        const auto old = oldScenes.find(scene.guid);
+        bool keepLoaded = old == oldScenes.end() || old->second.first;
+        for (uint64_t guid : scene.members) keepLoaded = keepLoaded || m_members.at(guid).loaded;
+        if (old != oldScenes.end()) scene.lastUsed = old->second.second;
+        if (keepLoaded) loadScene(em, scene);
+    }
+
+    // Loaded entities that only cold scenes list now go back to the file
+    for (auto& [guid, m] : m_members) {
+        if (!m.loaded || m.loadedScenes > 0) continue;
+        m.loaded = false;
+        if (const Entity t = em.findByGuid(guid); t != INVALID_ENTITY) em.unload(t);
+    }
+}
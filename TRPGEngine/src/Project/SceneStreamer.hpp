@@ -0,0 +1,129 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <json.hpp>
+
+#include "Engine/EntitySystem/Entity.hpp"
+
+class EntityManager;
+
+/**
+ * Lazy loading of a project's scenes (ProjectManager::setLazyLoading()).
+ *
+ * open() creates every entity of the project, but only the root, the
+ * FlowNode scene entities and entities that belong to no scene get their
+ * components. A scene's content (what its FlowNode lists and what sits
+ * under the scene entity, with their children) starts as component-less
+ * shells: ids, GUIDs, names and the hierarchy are all there, so references
+ * and the hierarchy panel work as usual. request() pages a scene's
+ * components in when SceneManager shows it or the editor selects something
+ * in it, and evicts the least recently used scenes once the loaded ones
+ * exceed the memory budget.
+ *
+ * Binary projects are read from their memory mapping; JSON projects are
+ * encoded to the binary layout in memory once. A scene edited since it was
+ * paged in stays loaded until a full save makes the file current again
+ * (rebase()). Saves take cold entities from the file (ColdEntities), so
+ * nothing is lost by not loading them.
+ */
+class SceneStreamer {
+public:
+    static SceneStreamer& get();
+
+    // Loads `path` into `em`, which the caller has cleared, and returns the
+    // root; INVALID_ENTITY if the file cannot be opened. Throws
+    // std::runtime_error if it is corrupt.
+    Entity open(EntityManager& em, const std::string& path);
+    void close();
+    bool isOpenFor(const EntityManager& em) const;
+
+    // Pages in the scene `e` is the FlowNode of or belongs to, then evicts
+    // down to the budget. In a fork of the streamed world (a play session)
+    // it only pages in.
+    void request(EntityManager& em, Entity e);
+    // The same without evicting anything; returns the scene's index, -1 if
+    // `e` is in none
+    int pageIn(EntityManager& em, Entity e);
+    // Every scene, regardless of the budget, for code that reads the whole
+    // project (exports); the next request() trims again
+    void loadAll(EntityManager& em);
+
+    void setMemoryBudget(size_t bytes) { m_budget = bytes; }
+    size_t getMemoryBudget() const { return m_budget; }
+    // Encoded size of the loaded scenes' content, which the budget applies to
+    size_t getLoadedBytes() const { return m_loadedBytes; }
+    size_t getSceneCount() const { return m_scenes.size(); }
+    size_t getLoadedSceneCount() const;
+
+private:
+    struct Source;
+
+public:
+    // The saved data of every entity that is not loaded. Holds on to the
+    // file data, so it stays usable on a job thread after the streamer has
+    // moved on.
+    class ColdEntities {
+    public:
+        bool empty() const { return m_entities.empty(); }
+        // Puts components, prefab links and overrides back into a
+        // serializeEntity() of the project root
+        void restore(nlohmann::json& project) const;
+
+    private:
+        friend class SceneStreamer;
+        std::shared_ptr<const Source> m_source;
+        std::unordered_map<uint64_t, uint32_t> m_entities;     // GUID -> entity in the file
+    };
+    ColdEntities coldEntities(const EntityManager& em) const;
+
+    // Before `path` is replaced: stops mapping it, keeping a copy in memory
+    void releaseFile(const std::string& path);
+    // After `project` was saved in full to `path`: reads cold scenes from
+    // there from now on and lets edited scenes go again
+    void rebase(EntityManager& em, const nlohmann::json& project, const std::string& path);
+
+private:
+    struct Scene {
+        uint64_t guid = 0;                  // of the FlowNode entity
+        std::vector<uint64_t> members;      // GUIDs of its content
+        size_t bytes = 0;                   // encoded size of their components
+        bool loaded = false;
+        uint64_t loadedVersion = 0;         // EntityManager version right after paging in
+        uint64_t lastUsed = 0;
+    };
+
+    struct Member {
+        uint32_t fileIndex = 0;
+        uint32_t scene = 0;                 // first scene that lists it; request() pages that one in
+        uint32_t loadedScenes = 0;          // loaded scenes that list it
+        bool loaded = false;                // has its components
+    };
+
+    SceneStreamer() = default;
+    SceneStreamer(const SceneStreamer&) = delete;
+    SceneStreamer& operator=(const SceneStreamer&) = delete;
+
+    bool belongsTo(const EntityManager& em) const;
+    int findScene(const EntityManager& em, Entity e) const;
+    void scan(const std::vector<nlohmann::json>& shells);
+    void loadScene(EntityManager& em, Scene& scene);
+    void unloadScene(EntityManager& em, Scene& scene);
+    bool isEdited(const EntityManager& em, const Scene& scene) const;
+    void trim(EntityManager& em, int keep);
+
+    std::shared_ptr<const Source> m_source;
+    std::string m_path;
+    EntityManager* m_em = nullptr;
+    uint64_t m_rootGuid = 0;
+    std::vector<Scene> m_scenes;
+    std::unordered_map<uint64_t, uint32_t> m_sceneIndex;   // FlowNode GUID -> m_scenes
+    std::unordered_map<uint64_t, Member> m_members;
+    size_t m_budget = size_t(64) << 20;
+    size_t m_loadedBytes = 0;
+    uint64_t m_clock = 0;
+};
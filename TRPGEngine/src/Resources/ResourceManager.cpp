@@ -30,6 +30,7 @@ bool ResourceManager::hasUnsavedChanges() const {
 
 void ResourceManager::setUnsavedChanges(bool value) {
     m_unsaved = value;
+    if (value) ++m_editCount;
 }
 
 // -------------------------------
@@ -5,6 +5,7 @@
 #include <json.hpp>
 #include <memory>
 #include <optional>
+#include <cstdint>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -18,6 +19,8 @@ public:
     void clear();
     bool hasUnsavedChanges() const;
     void setUnsavedChanges(bool value);
+    // Bumped by every setUnsavedChanges(true); lets callers detect edits made in between
+    uint64_t getEditCount() const { return m_editCount; }
 
     std::optional<nlohmann::json> loadAssetFile(const std::string& path);
     bool saveAssetFile(const nlohmann::json& j, const std::string& id, const std::string& extension);
@@ -33,4 +36,5 @@ public:
 private:
     ResourceManager() = default;
     bool m_unsaved = false;
+    uint64_t m_editCount = 0;
 };
\ No newline at end of file
@@ -41,20 +41,27 @@ bool DataLoader::load(const std::string& path, GameData& outData) {
     if (j.contains("scenes") && j["scenes"].is_array()) {
         const auto& scenes = j["scenes"];
 
+        // Exported ids are 64-bit entity GUIDs (older exports: entity ids);
+        // the flow graph numbers events compactly from 1 in order of appearance
+        std::unordered_map<uint64_t, int> compactIds;
+        auto compact = [&](uint64_t id)->int {
+            return compactIds.emplace(id, static_cast<int>(compactIds.size()) + 1).first->second;
+        };
+
         // First pass: map scene name -> first event id (if any), and id->first event
         std::unordered_map<std::string, int> sceneNameToFirstEvent;
         std::unordered_map<uint64_t, int> sceneIdToFirstEvent;
         int startFirstEvent = -1;
 
         for (const auto& sc : scenes) {
-            uint64_t sid = sc.value("id", 0);
+            uint64_t sid = sc.value("id", uint64_t(0));
             std::string sname = sc.value("name", std::string{});
             int firstEventId = -1;
             if (sc.contains("events") && sc["events"].is_array()) {
                 const auto& evs = sc["events"];
                 for (const auto& ev : evs) {
                     if (ev.contains("id") && ev["id"].is_number_unsigned()) {
-                        firstEventId = (int)ev["id"].get<uint64_t>();
+                        firstEventId = compact(ev["id"].get<uint64_t>());
                         break;
                     }
                 }
@@ -71,7 +78,7 @@ bool DataLoader::load(const std::string& path, GameData& outData) {
             if (tgt.empty()) return -1;
             const std::string tag = "@Event:";
             if (tgt.rfind(tag, 0) == 0) {
-                try { return (int)std::stoull(tgt.substr(tag.size())); } catch (...) { return -1; }
+                try { return compact(std::stoull(tgt.substr(tag.size()))); } catch (...) { return -1; }
             }
             auto it = sceneNameToFirstEvent.find(tgt);
             if (it != sceneNameToFirstEvent.end()) return it->second;
@@ -80,9 +87,11 @@ bool DataLoader::load(const std::string& path, GameData& outData) {
 
         // Second pass: flatten events into GameData::flow
         for (const auto& sc : scenes) {
-            uint64_t sid = sc.value("id", 0);
+            uint64_t sid = sc.value("id", uint64_t(0));
             std::string sname = sc.value("name", std::string{});
-            int sceneNextNode = sc.value("nextNode", -1); // entity id or -1
+            const json& nextJ = sc.contains("nextNode") ? sc["nextNode"] : json();
+            const bool hasNextNode = nextJ.is_number_unsigned();    // scene guid, or -1 for none
+            const uint64_t sceneNextNode = hasNextNode ? nextJ.get<uint64_t>() : 0;
 
             int sceneFirstEvent = sceneIdToFirstEvent[sid];
 
@@ -94,7 +103,7 @@ bool DataLoader::load(const std::string& path, GameData& outData) {
             eventIds.reserve(evs.size());
             for (const auto& ev : evs) {
                 if (ev.contains("id") && ev["id"].is_number_unsigned())
-                    eventIds.push_back((int)ev["id"].get<uint64_t>());
+                    eventIds.push_back(compact(ev["id"].get<uint64_t>()));
             }
 
             for (size_t idx = 0; idx < evs.size(); ++idx) {
@@ -102,7 +111,7 @@ bool DataLoader::load(const std::string& path, GameData& outData) {
                 if (!ev.contains("id") || !ev["id"].is_number_unsigned()) continue;
 
                 GameData::FlowNode fn;
-                fn.id = (int)ev["id"].get<uint64_t>();
+                fn.id = compact(ev["id"].get<uint64_t>());
                 fn.type = ev.value("type", std::string("Unknown"));
                 fn.next = -1; // default; may be filled below
 
@@ -123,9 +132,9 @@ bool DataLoader::load(const std::string& path, GameData& outData) {
                         // default: next event in the same scene
                         if (idx + 1 < eventIds.size()) {
                             fn.next = eventIds[idx + 1];
-                        } else if (sceneNextNode != -1) {
+                        } else if (hasNextNode) {
                             // last event in scene -> go to next scene's first event (if any)
-                            auto itF = sceneIdToFirstEvent.find((uint64_t)sceneNextNode);
+                            auto itF = sceneIdToFirstEvent.find(sceneNextNode);
                             if (itF != sceneIdToFirstEvent.end()) fn.next = itF->second;
                         }
                     }
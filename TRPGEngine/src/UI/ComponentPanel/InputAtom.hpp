@@ -0,0 +1,31 @@
+#pragma once
+
+#include <imgui.h>
+#include <misc/cpp/imgui_stdlib.h>
+#include <string>
+
+#include "Core/Atom.hpp"
+
+// InputText for an Atom. The text being typed lives in a plain string and is
+// interned once, when the edit is committed, so the partial names typed on
+// the way never enter the atom table. True on that frame.
+inline bool inputAtom(const char* label, Atom& value) {
+    static ImGuiID s_editing = 0;       // widget holding s_text, if any
+    static std::string s_text;
+
+    const ImGuiID id = ImGui::GetID(label);
+    std::string text = (s_editing == id) ? s_text : value.str();
+    ImGui::InputText(label, &text);
+
+    if (ImGui::IsItemActive()) {
+        s_editing = id;
+        s_text = text;
+        return false;
+    }
+    if (s_editing == id) s_editing = 0;
+    if (ImGui::IsItemDeactivatedAfterEdit() && text != value.str()) {
+        value = Atom(text);
+        return true;
+    }
+    return false;
+}
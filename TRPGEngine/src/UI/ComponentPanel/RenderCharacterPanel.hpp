@@ -5,6 +5,7 @@
 #include "UI/EditorUI.hpp"
 #include "Engine/EntitySystem/Components/CharacterComponent.hpp"
 #include "Resources/ResourceManager.hpp" // + mark unsaved
+#include "UI/ComponentPanel/InputAtom.hpp"
 
 inline void renderCharacterInspector(const std::shared_ptr<CharacterComponent>& character) {
     if (!character) {
@@ -13,14 +14,8 @@ inline void renderCharacterInspector(const std::shared_ptr<CharacterComponent>&
     }
 
     // Editable name (buffered)
-    {
-        char nameBuf[128];
-        std::strncpy(nameBuf, character->name.c_str(), sizeof(nameBuf));
-        nameBuf[sizeof(nameBuf) - 1] = '\0';
-        if (ImGui::InputText("Name", nameBuf, sizeof(nameBuf))) {
-            character->name = nameBuf;
-            ResourceManager::get().setUnsavedChanges(true);
-        }
+    if (inputAtom("Name", character->name)) {
+        ResourceManager::get().setUnsavedChanges(true);
     }
 
     // Icon Image with drag-drop (buffered)
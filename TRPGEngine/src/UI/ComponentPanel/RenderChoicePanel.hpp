@@ -52,7 +52,7 @@ inline void renderChoiceInspector(const std::shared_ptr<ChoiceComponent>& comp)
             std::vector<std::string> scenes; scenes.emplace_back("<None>");
             for (Entity e : meta->sceneNodes) {
                 auto fn = em.getComponent<FlowNodeComponent>(e);
-                scenes.emplace_back(fn ? fn->name : std::string("[Missing] ") + std::to_string(e));
+                scenes.emplace_back(fn ? fn->name.str() : std::string("[Missing] ") + std::to_string(e));
             }
             std::vector<const char*> items; for (auto& s : scenes) items.push_back(s.c_str());
             int curScene = 0;
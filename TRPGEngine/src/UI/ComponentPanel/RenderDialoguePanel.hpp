@@ -74,13 +74,13 @@ inline void renderDialogueInspector(const std::shared_ptr<DialogueComponent>& co
             cache.emplace_back("<None>");
             for (Entity e : meta->sceneNodes) {
                 auto fn = em.getComponent<FlowNodeComponent>(e);
-                cache.emplace_back(fn ? fn->name : std::string("[Missing] ") + std::to_string(e));
+                cache.emplace_back(fn ? fn->name.str() : std::string("[Missing] ") + std::to_string(e));
             }
             for (auto& s : cache) items.push_back(s.c_str());
             int current = 0;
-            if (!comp->targetFlowNode.empty() && comp->targetFlowNode.rfind("@Event:", 0) != 0) {
+            if (!comp->targetFlowNode.empty() && !comp->targetFlowNode.startsWith("@Event:")) {
                 for (int i = 1; i < (int)cache.size(); ++i) {
-                    if (cache[i] == comp->targetFlowNode) { current = i; break; }
+                    if (cache[i] == comp->targetFlowNode.str()) { current = i; break; }
                 }
             }
             if (ImGui::Combo("Target Scene", &current, items.data(), (int)items.size())) {
@@ -108,8 +108,8 @@ inline void renderDialogueInspector(const std::shared_ptr<DialogueComponent>& co
             for (auto& s : labels) items.push_back(s.c_str());
 
             int cur = 0;
-            if (!comp->targetFlowNode.empty() && comp->targetFlowNode.rfind("@Event:", 0) == 0) {
-                for (size_t i = 1; i < labels.size(); ++i) if (labels[i] == comp->targetFlowNode) { cur = (int)i; break; }
+            if (!comp->targetFlowNode.empty() && comp->targetFlowNode.startsWith("@Event:")) {
+                for (size_t i = 1; i < labels.size(); ++i) if (labels[i] == comp->targetFlowNode.str()) { cur = (int)i; break; }
             }
             if (ImGui::Combo("Target Event", &cur, items.data(), (int)items.size())) {
                 comp->targetFlowNode = (cur == 0) ? std::string() : labels[cur];
@@ -122,7 +122,7 @@ inline void renderDialogueInspector(const std::shared_ptr<DialogueComponent>& co
 
     if (!comp->targetFlowNode.empty()) {
         ImGui::Text("Next: %s", comp->targetFlowNode.c_str());
-        if (ImGui::Button("Clear Target")) { comp->targetFlowNode.clear(); ResourceManager::get().setUnsavedChanges(true); }
+        if (ImGui::Button("Clear Target")) { comp->targetFlowNode = Atom(); ResourceManager::get().setUnsavedChanges(true); }
     } else {
         ImGui::TextDisabled("None (Drop a node here)");
     }
@@ -6,6 +6,7 @@
 #include <vector>   // cache/items
 #include "UI/EditorUI.hpp"
 #include "Engine/EntitySystem/EntityManager.hpp"
+#include "UI/ComponentPanel/InputAtom.hpp"
 #include "Engine/EntitySystem/Components/DiceRollComponent.hpp"
 #include "Engine/EntitySystem/Components/FlowNodeComponent.hpp"
 #include "Engine/EntitySystem/Components/ProjectMetaComponent.hpp"
@@ -37,18 +38,18 @@ inline void renderDiceInspector(const std::shared_ptr<DiceRollComponent>& comp)
         cache.emplace_back("<None>");
         for (Entity e : meta->sceneNodes) {
             auto fn = em.getComponent<FlowNodeComponent>(e);
-            cache.emplace_back(fn ? fn->name : std::string("[Missing] ") + std::to_string(e));
+            cache.emplace_back(fn ? fn->name.str() : std::string("[Missing] ") + std::to_string(e));
         }
         for (auto& s : cache) items.push_back(s.c_str());
 
         int succ = 0, fail = 0;
-        if (!comp->onSuccess.empty() && comp->onSuccess.rfind("@Event:", 0) != 0)
-            for (int i = 1; i < (int)cache.size(); ++i) if (cache[i] == comp->onSuccess) succ = i;
-        if (!comp->onFailure.empty() && comp->onFailure.rfind("@Event:", 0) != 0)
-            for (int i = 1; i < (int)cache.size(); ++i) if (cache[i] == comp->onFailure) fail = i;
+        if (!comp->onSuccess.empty() && !comp->onSuccess.startsWith("@Event:"))
+            for (int i = 1; i < (int)cache.size(); ++i) if (cache[i] == comp->onSuccess.str()) succ = i;
+        if (!comp->onFailure.empty() && !comp->onFailure.startsWith("@Event:"))
+            for (int i = 1; i < (int)cache.size(); ++i) if (cache[i] == comp->onFailure.str()) fail = i;
 
         if (ImGui::Combo("On Success -> Scene", &succ, items.data(), (int)items.size())) {
-            if (succ == 0 && comp->onSuccess.rfind("@Event:", 0) == 0) {
+            if (succ == 0 && comp->onSuccess.startsWith("@Event:")) {
                 // keep event tag if set; scene cleared
             } else {
                 comp->onSuccess = (succ == 0) ? std::string() : cache[succ];
@@ -56,7 +57,7 @@ inline void renderDiceInspector(const std::shared_ptr<DiceRollComponent>& comp)
             }
         }
         if (ImGui::Combo("On Failure -> Scene", &fail, items.data(), (int)items.size())) {
-            if (fail == 0 && comp->onFailure.rfind("@Event:", 0) == 0) {
+            if (fail == 0 && comp->onFailure.startsWith("@Event:")) {
                 // keep event tag if set; scene cleared
             } else {
                 comp->onFailure = (fail == 0) ? std::string() : cache[fail];
@@ -78,10 +79,10 @@ inline void renderDiceInspector(const std::shared_ptr<DiceRollComponent>& comp)
             }
             std::vector<const char*> items; for (auto& s : events) items.push_back(s.c_str());
             int succEvt = 0, failEvt = 0;
-            if (!comp->onSuccess.empty() && comp->onSuccess.rfind("@Event:", 0) == 0)
-                for (int i = 1; i < (int)events.size(); ++i) if (events[i] == comp->onSuccess) succEvt = i;
-            if (!comp->onFailure.empty() && comp->onFailure.rfind("@Event:", 0) == 0)
-                for (int i = 1; i < (int)events.size(); ++i) if (events[i] == comp->onFailure) failEvt = i;
+            if (!comp->onSuccess.empty() && comp->onSuccess.startsWith("@Event:"))
+                for (int i = 1; i < (int)events.size(); ++i) if (events[i] == comp->onSuccess.str()) succEvt = i;
+            if (!comp->onFailure.empty() && comp->onFailure.startsWith("@Event:"))
+                for (int i = 1; i < (int)events.size(); ++i) if (events[i] == comp->onFailure.str()) failEvt = i;
 
             if (ImGui::Combo("On Success -> Event", &succEvt, items.data(), (int)items.size())) {
                 comp->onSuccess = (succEvt == 0) ? std::string() : events[succEvt];
@@ -97,18 +98,13 @@ inline void renderDiceInspector(const std::shared_ptr<DiceRollComponent>& comp)
     }
 
     // Free-text fallback
-    char bufferSuccess[256];
-    std::strncpy(bufferSuccess, comp->onSuccess.c_str(), sizeof(bufferSuccess));
-    bufferSuccess[255] = '\0';
-    if (ImGui::InputText("On Success Trigger (name or @Event:id)", bufferSuccess, sizeof(bufferSuccess))) {
-        comp->onSuccess = bufferSuccess;
+    if (inputAtom("On Success Trigger (name or @Event:id)", comp->onSuccess)) {
         ResourceManager::get().setUnsavedChanges(true);
     }
-    char bufferFailure[256];
-    std::strncpy(bufferFailure, comp->onFailure.c_str(), sizeof(bufferFailure));
-    bufferFailure[255] = '\0';
-    if (ImGui::InputText("On Failure Trigger (name or @Event:id)", bufferFailure, sizeof(bufferFailure))) {
-        comp->onFailure = bufferFailure;
+    if (inputAtom("On Failure Trigger (name or @Event:id)", comp->onFailure)) {
+        ResourceManager::get().setUnsavedChanges(true);
+    }
+    if (inputAtom("Store Roll In Variable", comp->resultVariable)) {
         ResourceManager::get().setUnsavedChanges(true);
     }
 
@@ -6,6 +6,7 @@
 #include <algorithm>
 #include <json.hpp>
 #include <unordered_set>
+#include "UI/ComponentPanel/InputAtom.hpp"
 #include "UI/EditorUI.hpp"
 #include "Engine/EntitySystem/Entity.hpp"
 #include "Engine/EntitySystem/EntityManager.hpp"
@@ -29,11 +30,7 @@ inline void renderFlowNodeInspector(const std::shared_ptr<FlowNodeComponent>& co
     ImGui::Text("Flow Node: %s", comp->name.c_str());
     ImGui::Separator();
 
-    char nameBuffer[128];
-    std::strncpy(nameBuffer, comp->name.c_str(), sizeof(nameBuffer));
-    nameBuffer[sizeof(nameBuffer) - 1] = '\0';
-    if (ImGui::InputText("Name", nameBuffer, sizeof(nameBuffer))) {
-        comp->name = nameBuffer;
+    if (inputAtom("Name", comp->name)) {
         ResourceManager::get().setUnsavedChanges(true);
     }
 
@@ -90,7 +87,7 @@ inline void renderFlowNodeInspector(const std::shared_ptr<FlowNodeComponent>& co
             options.emplace_back(-1, std::string("<None>"));
             for (Entity e : meta->sceneNodes) {
                 auto f = em.getComponent<FlowNodeComponent>(e);
-                std::string label = f ? f->name : std::string("[Missing] ") + std::to_string((unsigned)e);
+                std::string label = f ? f->name.str() : std::string("[Missing] ") + std::to_string((unsigned)e);
                 options.emplace_back(static_cast<int>(e), label);
             }
 
@@ -131,6 +128,7 @@ inline void renderFlowNodeInspector(const std::shared_ptr<FlowNodeComponent>& co
         ImGui::SameLine();
         if (ImGui::SmallButton((std::string("Remove##char") + std::to_string(charId)).c_str())) {
             comp->characters.erase(comp->characters.begin() + i);
+            ResourceManager::get().setUnsavedChanges(true);
             i--;
         }
     }
@@ -138,8 +136,10 @@ inline void renderFlowNodeInspector(const std::shared_ptr<FlowNodeComponent>& co
     if (ImGui::BeginDragDropTarget()) {
         if (const ImGuiPayload* payload = ImGui::AcceptDragDropPayload("ENTITY_FILE")) {
             Entity dropped = *(Entity*)payload->Data;
-            if (em.getComponent<CharacterComponent>(dropped))
+            if (em.getComponent<CharacterComponent>(dropped)) {
                 comp->characters.push_back(dropped);
+                ResourceManager::get().setUnsavedChanges(true);
+            }
         }
         ImGui::EndDragDropTarget();
     }
@@ -169,8 +169,7 @@ inline void renderFlowNodeInspector(const std::shared_ptr<FlowNodeComponent>& co
     }
     if (ImGui::BeginPopup("AttachBackgroundPicker")) {
         // List all entities with BackgroundComponent
-        for (Entity e : em.getAllEntities()) {
-            if (!em.getComponent<BackgroundComponent>(e)) continue;
+        for (auto [e, bg] : em.view<BackgroundComponent>()) {
             bool already = std::find(comp->backgroundEntities.begin(), comp->backgroundEntities.end(), e) != comp->backgroundEntities.end();
             if (ImGui::Selectable((std::string("Entity #") + std::to_string((unsigned)e) + (already ? " (attached)" : "")).c_str())) {
                 // Enforce unique background per scene
@@ -211,6 +210,7 @@ inline void renderFlowNodeInspector(const std::shared_ptr<FlowNodeComponent>& co
         ImGui::SameLine();
         if (ImGui::SmallButton((std::string("Remove##ui") + std::to_string(e)).c_str())) {
             comp->uiLayer.erase(comp->uiLayer.begin() + i);
+            ResourceManager::get().setUnsavedChanges(true);
             i--;
         }
     }
@@ -218,8 +218,10 @@ inline void renderFlowNodeInspector(const std::shared_ptr<FlowNodeComponent>& co
     if (ImGui::BeginDragDropTarget()) {
         if (const ImGuiPayload* payload = ImGui::AcceptDragDropPayload("ENTITY_FILE")) {
             Entity dropped = *(Entity*)payload->Data;
-            if (em.getComponent<UIButtonComponent>(dropped) || em.getComponent<DialogueComponent>(dropped))
+            if (em.getComponent<UIButtonComponent>(dropped) || em.getComponent<DialogueComponent>(dropped)) {
                 comp->uiLayer.push_back(dropped);
+                ResourceManager::get().setUnsavedChanges(true);
+            }
         }
         ImGui::EndDragDropTarget();
     }
@@ -236,6 +238,7 @@ inline void renderFlowNodeInspector(const std::shared_ptr<FlowNodeComponent>& co
         ImGui::SameLine();
         if (ImGui::SmallButton((std::string("Remove##obj") + std::to_string(e)).c_str())) {
             comp->objectLayer.erase(comp->objectLayer.begin() + i);
+            ResourceManager::get().setUnsavedChanges(true);
             i--;
         }
     }
@@ -245,6 +248,7 @@ inline void renderFlowNodeInspector(const std::shared_ptr<FlowNodeComponent>& co
             Entity dropped = *(Entity*)payload->Data;
             // You can define custom logic to check for 3D object type components
             comp->objectLayer.push_back(dropped);
+            ResourceManager::get().setUnsavedChanges(true);
         }
         ImGui::EndDragDropTarget();
     }
@@ -267,11 +271,11 @@ inline void renderFlowNodeInspector(const std::shared_ptr<FlowNodeComponent>& co
         Entity owner = findOwnerScene(evt);
         if (owner == toNode) return true;
         if (owner != INVALID_ENTITY) {
-            if (auto ownFn = em.getComponent<FlowNodeComponent>(owner)) {
+            if (auto* ownFn = em.getMutable<FlowNodeComponent>(owner)) {
                 ownFn->eventSequence.erase(std::remove(ownFn->eventSequence.begin(), ownFn->eventSequence.end(), evt), ownFn->eventSequence.end());
             }
         }
-        if (auto dst = em.getComponent<FlowNodeComponent>(toNode)) {
+        if (auto* dst = em.getMutable<FlowNodeComponent>(toNode)) {
             dst->eventSequence.push_back(evt);
             ResourceManager::get().setUnsavedChanges(true);
             return true;
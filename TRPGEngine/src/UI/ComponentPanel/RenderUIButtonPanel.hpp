@@ -2,6 +2,7 @@
 
 #include "UI/EditorUI.hpp"
 #include "Engine/EntitySystem/Components/UIButtonComponent.hpp"
+#include "UI/ComponentPanel/InputAtom.hpp"
 
 inline void renderUIButtonInspector(const std::shared_ptr<UIButtonComponent>& btn) {
     if (!btn) return;
@@ -24,6 +25,6 @@ inline void renderUIButtonInspector(const std::shared_ptr<UIButtonComponent>& bt
         ImGui::EndDragDropTarget();
     }
 
-    ImGui::InputText("Target FlowNode", &btn->targetFlowNode);
+    inputAtom("Target FlowNode", btn->targetFlowNode);
     ImGui::TextDisabled("Target is optional. If set, clicking this button advances the flow.");
 }
\ No newline at end of file
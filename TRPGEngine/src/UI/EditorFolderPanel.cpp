@@ -12,6 +12,7 @@
 #include "Resources/ResourceManager.hpp"
 #include "Engine/EntitySystem/EntityManager.hpp"
 #include "Engine/EntitySystem/ComponentRegistry.hpp"
+#include "Engine/EntitySystem/PrefabManager.hpp"
 
 #include "Engine/RenderSystem/SceneManager.hpp"
 
@@ -103,6 +104,21 @@ void EditorUI::renderFolderPreview(const std::filesystem::path& folder) {
             ImGui::EndDragDropSource();
         }
 
+        if (entry.path().extension() == ".prefab" && ImGui::BeginPopupContextItem()) {
+            if (ImGui::MenuItem("Instantiate")) {
+                auto& em = EntityManager::get();
+                Entity e = em.instantiatePrefab(PrefabManager::get().load(PrefabManager::get().idForPath(fullPath)), em.getSelectedEntity());
+                if (e != INVALID_ENTITY) {
+                    setSelectedEntity(e);
+                    ResourceManager::get().setUnsavedChanges(true);
+                    setStatusMessage("Instantiated prefab: " + name);
+                } else {
+                    setStatusMessage("Failed to load prefab: " + name);
+                }
+            }
+            ImGui::EndPopup();
+        }
+
         ImGui::NextColumn();
     }
 
@@ -4,13 +4,18 @@
 #include <filesystem>
 #include <fstream>
 #include "Engine/EntitySystem/EntityManager.hpp"
+#include "Engine/EntitySystem/EntityRefs.hpp"
 #include "Engine/EntitySystem/Components/FlowNodeComponent.hpp"
 #include "Engine/EntitySystem/Components/DialogueComponent.hpp"
 #include "Engine/EntitySystem/Components/ChoiceComponent.hpp"
 #include "Engine/EntitySystem/Components/DiceRollComponent.hpp"
 #include "Engine/EntitySystem/Components/ProjectMetaComponent.hpp"
 #include "Project/ProjectManager.hpp"
+#include "Project/AutosaveService.hpp"
+#include "Project/BinaryProject.hpp"
+#include "Project/SceneStreamer.hpp"
 #include "UI/FlowPanel/EditorRunControls.hpp"
+#include "Engine/GameplaySystem/SaveGame.hpp"
 #include <json.hpp>
 #include "Resources/ResourceManager.hpp"
 #include "Engine/EntitySystem/ComponentRegistry.hpp"
@@ -24,6 +29,7 @@
 namespace {
 	static bool s_openChooseScenePopup = false;
 	static ComponentType s_pendingEventType = ComponentType::Unknown;
+	static std::vector<SaveGame::SlotInfo> s_saveSlots;     // read when the Run menu opens, not every frame
 } // anonymous namespace
 
 // Shared Play controls exposed from FlowPlayTester (C-linkage)
@@ -34,65 +40,62 @@ extern "C" {
 	void Editor_Run_Restart();
 }
 
-// Helper: build runtime data.json reflecting scenes, event ownership and targets
+// Helper: build runtime data.json reflecting scenes, event ownership and targets.
+// Entities are referred to by GUID; the runtime maps them to its own compact ids.
 static nlohmann::json buildRuntimeDataJson() {
 	auto& em = EntityManager::get();
+	SceneStreamer::get().loadAll(em);   // every scene is exported, loaded or not
+	const EntityManager& cem = em;      // const reads never unshare prefab or forked components
 	nlohmann::json root = nlohmann::json::object();
 	root["scenes"] = nlohmann::json::array();
 
 	Entity metaEntity = ProjectManager::getProjectMetaEntity();
-	auto base = em.getComponent(metaEntity, ComponentType::ProjectMetadata);
+	auto base = cem.getComponent(metaEntity, ComponentType::ProjectMetadata);
 	if (!base) return root;
-	auto meta = std::static_pointer_cast<ProjectMetaComponent>(base);
+	auto meta = std::static_pointer_cast<const ProjectMetaComponent>(base);
 
 	for (Entity nodeId : meta->sceneNodes) {
-		auto fn = em.getComponent<FlowNodeComponent>(nodeId);
+		auto fn = cem.getComponent<FlowNodeComponent>(nodeId);
 		if (!fn) continue;
 
 		nlohmann::json scene = nlohmann::json::object();
-		scene["id"] = static_cast<uint64_t>(nodeId);
+		scene["id"] = em.getGuid(nodeId);
 		scene["name"] = fn->name;
 		scene["isStart"] = (meta->startNode == nodeId);
 		scene["isEnd"] = fn->isEnd;
-		scene["nextNode"] = fn->nextNode; // -1 or entity id cast int
+		const uint64_t next = em.getGuid(fn->nextNode);
+		scene["nextNode"] = next ? nlohmann::json(next) : nlohmann::json(-1); // -1 or scene guid
 
 		// layers/refs
-		auto toArray = [](const std::vector<Entity>& arr) {
-			nlohmann::json out = nlohmann::json::array();
-			for (Entity e : arr) out.push_back(static_cast<uint64_t>(e));
-			return out;
-		};
-		scene["characters"] = toArray(fn->characters);
-		scene["backgrounds"] = toArray(fn->backgroundEntities);
-		scene["uiLayer"] = toArray(fn->uiLayer);
-		scene["objectLayer"] = toArray(fn->objectLayer);
+		scene["characters"] = EntityRefs::saveList(fn->characters);
+		scene["backgrounds"] = EntityRefs::saveList(fn->backgroundEntities);
+		scene["uiLayer"] = EntityRefs::saveList(fn->uiLayer);
+		scene["objectLayer"] = EntityRefs::saveList(fn->objectLayer);
 
 		// events with ownership and targets
 		nlohmann::json events = nlohmann::json::array();
 		for (Entity evt : fn->eventSequence) {
 			if (evt == INVALID_ENTITY) continue;
 			nlohmann::json ev = nlohmann::json::object();
-			ev["id"] = static_cast<uint64_t>(evt);
-			if (auto d = em.getComponent<DialogueComponent>(evt)) {
+			ev["id"] = em.getGuid(evt);
+			if (auto d = cem.getComponent<DialogueComponent>(evt)) {
 				ev["type"] = "Dialogue";
 				ev["lines"] = d->lines;
-				ev["speaker"] = static_cast<int64_t>(d->speaker);
+				ev["speaker"] = EntityRefs::save(d->speaker);
 				ev["advanceOnClick"] = d->advanceOnClick;
-				ev["target"] = d->targetFlowNode; // scene name or @Event:id
-			} else if (auto c = em.getComponent<ChoiceComponent>(evt)) {
+				ev["target"] = EntityRefs::saveTarget(d->targetFlowNode.str()); // scene name or @Event:guid
+			} else if (auto c = cem.getComponent<ChoiceComponent>(evt)) {
 				ev["type"] = "Choice";
 				nlohmann::json opts = nlohmann::json::array();
-				for (auto& o : c->options) {
-					// Persist full text including " -> target" (editor format)
-					opts.push_back(o.text);
-				}
+				// Persist full text including " -> target" (editor format)
+				for (const auto& o : c->toJson()["options"]) opts.push_back(o["text"]);
 				ev["options"] = opts;
-			} else if (auto r = em.getComponent<DiceRollComponent>(evt)) {
+			} else if (auto r = cem.getComponent<DiceRollComponent>(evt)) {
 				ev["type"] = "DiceRoll";
 				ev["sides"] = r->sides;
 				ev["threshold"] = r->threshold;
-				ev["onSuccess"] = r->onSuccess; // scene name or @Event:id
-				ev["onFailure"] = r->onFailure; // scene name or @Event:id
+				ev["onSuccess"] = EntityRefs::saveTarget(r->onSuccess.str()); // scene name or @Event:guid
+				ev["onFailure"] = EntityRefs::saveTarget(r->onFailure.str()); // scene name or @Event:guid
 			} else {
 				ev["type"] = "Unknown";
 			}
@@ -144,7 +147,7 @@ void EditorUI::renderMenuBar() {
 			}
 
 			if (ImGui::MenuItem("Open Project...")) {
-				const char* projFilter = "TRPG Project (*.trpgproj)\0*.trpgproj\0All Files (*.*)\0*.*\0";
+				const char* projFilter = "TRPG Project (*.trpgproj;*.trpgbin)\0*.trpgproj;*.trpgbin\0All Files (*.*)\0*.*\0";
 				std::string path = openFileDialog(projFilter);
 				if (!path.empty()) {
 					if (ResourceManager::get().hasUnsavedChanges()) {
@@ -170,7 +173,7 @@ void EditorUI::renderMenuBar() {
 			}
 
 			if (ImGui::MenuItem("Save Project As...")) {
-				const char* projFilter = "TRPG Project (*.trpgproj)\0*.trpgproj\0All Files (*.*)\0*.*\0";
+				const char* projFilter = "TRPG Project (*.trpgproj)\0*.trpgproj\0Binary TRPG Project (*.trpgbin)\0*.trpgbin\0All Files (*.*)\0*.*\0";
 				std::string path = saveFileDialog(projFilter);
 				if (!path.empty()) {
 					ProjectManager::saveProjectToFile(path);
@@ -179,6 +182,37 @@ void EditorUI::renderMenuBar() {
 				}
 			}
 
+			bool incremental = ProjectManager::isIncrementalSave();
+			if (ImGui::MenuItem("Incremental Save", nullptr, &incremental)) {
+				ProjectManager::setIncrementalSave(incremental);
+			}
+
+			bool lazy = ProjectManager::isLazyLoading();
+			if (ImGui::MenuItem("Load Scenes On Demand", nullptr, &lazy)) {
+				ProjectManager::setLazyLoading(lazy);
+				setStatusMessage("Takes effect when a project is opened.");
+			}
+
+			if (ImGui::BeginMenu("Autosave")) {
+				AutosaveService& autosave = AutosaveService::get();
+				bool enabled = autosave.isEnabled();
+				if (ImGui::MenuItem("Enabled", nullptr, &enabled)) {
+					autosave.setEnabled(enabled);
+				}
+				int minutes = static_cast<int>(autosave.getInterval() / 60.0f + 0.5f);
+				if (ImGui::SliderInt("Interval (min)", &minutes, 1, 30)) {
+					autosave.setInterval(minutes * 60.0f);
+				}
+				if (ImGui::MenuItem("Autosave Now", nullptr, false, !ProjectManager::getCurrentProjectPath().empty())) {
+					if (!autosave.trigger()) setStatusMessage("Nothing to autosave.");
+				}
+				const std::string& current = ProjectManager::getCurrentProjectPath();
+				if (ImGui::MenuItem("Recover Autosave", nullptr, false, !current.empty() && AutosaveService::hasNewerAutosave(current))) {
+					setStatusMessage(ProjectManager::recoverAutosave() ? "Recovered the autosave; save to keep it." : std::string("Could not recover the autosave."));
+				}
+				ImGui::EndMenu(); // Autosave
+			}
+
 			if (ImGui::MenuItem("Scene Metadata Settings...")) {
 				showProjectMetaPopup = true;
 				ImGui::OpenPopup("ProjectMetaPopup");
@@ -215,6 +249,25 @@ void EditorUI::renderMenuBar() {
 						}
 					}
 				}
+				if (ImGui::MenuItem("Export Binary Project (.trpgbin)")) {
+					const char* binFilter = "Binary TRPG Project (*.trpgbin)\0*.trpgbin\0All Files (*.*)\0*.*\0";
+					std::string out = saveFileDialog(binFilter);
+					if (!out.empty()) {
+						std::filesystem::path p(out);
+						if (p.extension() != BinaryProject::EXTENSION) p += BinaryProject::EXTENSION;
+						bool success = ProjectManager::saveProjectToFile(p.string());
+						setStatusMessage(success ? "Exported " + p.filename().string() : std::string("Binary export failed."));
+					}
+				}
+				if (ImGui::MenuItem("Benchmark Project Load")) {
+					std::string path = ProjectManager::getCurrentProjectPath();
+					if (path.empty()) {
+						setStatusMessage("Save the project before benchmarking its load time.");
+					} else {
+						bool success = ProjectManager::benchmarkLoad(path);
+						setStatusMessage(success ? "Load benchmark written to the console." : "Load benchmark failed.");
+					}
+				}
 				// + Export runtime data.json (scenes, events, targets)
 				if (ImGui::MenuItem("Export Runtime Data (data.json)")) {
 					try {
@@ -301,6 +354,7 @@ void EditorUI::renderMenuBar() {
 		// ---------------- RUN MENU ----------------
 		// Keep using shared Play controls
 		if (ImGui::BeginMenu("Run")) {
+			if (ImGui::IsWindowAppearing()) s_saveSlots = SaveGame::listSlots();
 			bool playing = Editor_Run_IsPlaying();
 			if (ImGui::MenuItem("Play", nullptr, false, !playing)) {
 				Editor_Run_Play();
@@ -311,6 +365,28 @@ void EditorUI::renderMenuBar() {
 			if (ImGui::MenuItem("Restart", nullptr, false, playing)) {
 				Editor_Run_Restart();
 			}
+			ImGui::Separator();
+			if (ImGui::BeginMenu("Save Game", playing)) {
+				bool saved = false;
+				for (const SaveGame::SlotInfo& slot : s_saveSlots) {
+					const std::string label = "Slot " + std::to_string(slot.slot + 1) + (slot.used ? "" : " (empty)");
+					if (ImGui::MenuItem(label.c_str())) {
+						saved = SaveGame::saveSlot(slot.slot);
+						setStatusMessage(saved ? "Saved game to " + label : std::string("Saving the game failed."));
+					}
+				}
+				if (saved) s_saveSlots = SaveGame::listSlots();
+				ImGui::EndMenu();
+			}
+			if (ImGui::BeginMenu("Load Game", playing)) {
+				for (const SaveGame::SlotInfo& slot : s_saveSlots) {
+					const std::string label = "Slot " + std::to_string(slot.slot + 1);
+					if (ImGui::MenuItem(label.c_str(), nullptr, false, slot.used)) {
+						setStatusMessage(SaveGame::loadSlot(slot.slot) ? "Loaded game from " + label : std::string("Loading the game failed."));
+					}
+				}
+				ImGui::EndMenu();
+			}
 			ImGui::EndMenu();
 		}
 
@@ -337,7 +413,7 @@ void EditorUI::renderMenuBar() {
 			auto meta = std::static_pointer_cast<ProjectMetaComponent>(base);
 			for (Entity nodeId : meta->sceneNodes) {
 				auto fn = em.getComponent<FlowNodeComponent>(nodeId);
-				std::string label = fn ? fn->name : std::string("[Missing] ") + std::to_string((unsigned)nodeId);
+				std::string label = fn ? fn->name.str() : std::string("[Missing] ") + std::to_string((unsigned)nodeId);
 				label += "##scene_pick_" + std::to_string((unsigned)nodeId);
 				if (ImGui::Button(label.c_str())) {
 					Entity e = EditorMenuHelpers::createEventAndAttach(s_pendingEventType, nodeId);
@@ -388,7 +464,7 @@ void EditorUI::renderProjectMetaPopup(Entity metaEntity) {
 		auto base = em.getComponent(metaEntity, ComponentType::ProjectMetadata);
 		if (!base) {
 			std::cout << "[EditorUI] ProjectMetaPopup: component missing -> creating now\n";
-			auto metaComp = std::make_shared<ProjectMetaComponent>();
+			auto metaComp = makeComponent<ProjectMetaComponent>();
 			auto res = em.addComponent(metaEntity, metaComp);
 			std::cout << "[EditorUI] ProjectMetaPopup: addComponent result=" << (int)res << "\n";
 			base = metaComp; // continue below with a valid component
@@ -572,7 +648,7 @@ void EditorUI::renderNewEntityPopup() {
 			auto meta = std::static_pointer_cast<ProjectMetaComponent>(base);
 			for (Entity nodeId : meta->sceneNodes) {
 				auto fn = em.getComponent<FlowNodeComponent>(nodeId);
-				std::string label = fn ? fn->name : std::string("[Missing] ") + std::to_string((unsigned)nodeId);
+				std::string label = fn ? fn->name.str() : std::string("[Missing] ") + std::to_string((unsigned)nodeId);
 				sceneItems.emplace_back(nodeId, label);
 			}
 		}
@@ -667,14 +743,16 @@ void EditorUI::renderNewEntityPopup() {
 
 					auto it = templateMap.find(type);
 					if (it != templateMap.end()) {
-						size_t added = 0;
+						std::vector<std::shared_ptr<ComponentBase>> comps;
+						comps.reserve(it->second.factories.size());
 						for (const auto& make : it->second.factories) {
 							if (!make) { std::cout << "[ERROR] Null factory in template!\n"; continue; }
 							auto comp = make();
 							if (!comp) { std::cout << "[ERROR] Factory returned null!\n"; continue; }
-							EntityManager::get().addComponent(e, comp);
-							++added;
+							comps.push_back(std::move(comp));
 						}
+						const size_t added = comps.size();
+						EntityManager::get().addComponents(e, std::move(comps));
 						std::cout << "Added " << added << " components.\n";
 					} else {
 						std::cout << "[WARNING] No template found for this type.\n";
@@ -698,7 +776,7 @@ void EditorUI::renderNewEntityPopup() {
 						}
 
 						if (selectedSceneForNewEntity != INVALID_ENTITY) {
-							if (auto fn = em.getComponent<FlowNodeComponent>(selectedSceneForNewEntity)) {
+							if (auto* fn = em.getMutable<FlowNodeComponent>(selectedSceneForNewEntity)) {
 								if (em.getComponent<BackgroundComponent>(e)) {
 									fn->backgroundEntities.clear();
 									fn->backgroundEntities.push_back(e);
@@ -1,5 +1,7 @@
 #include "EditorUI.hpp"
+#include "Project/AutosaveService.hpp"
 #include <imgui.h>
+#include <algorithm>
 
 void EditorUI::setStatusMessage(const std::string& message) {
     m_saveStatus = message;
@@ -7,15 +9,18 @@ void EditorUI::setStatusMessage(const std::string& message) {
 }
 
 void EditorUI::renderStatusBar() {
-    if (m_saveStatus.empty()) return;
-
-    m_statusTimer += ImGui::GetIO().DeltaTime;
-    if (m_statusTimer > 5.0f) {
-        m_saveStatus.clear();
-        m_statusTimer = 0.0f;
-        return;
+    if (!m_saveStatus.empty()) {
+        m_statusTimer += ImGui::GetIO().DeltaTime;
+        if (m_statusTimer > 5.0f) {
+            m_saveStatus.clear();
+            m_statusTimer = 0.0f;
+        }
     }
 
+    const AutosaveService& autosave = AutosaveService::get();
+    const std::string& autosaveText = autosave.getStatusText();
+    if (m_saveStatus.empty() && autosaveText.empty()) return;
+
     // This must match the name used in DockBuilderDockWindow("StatusBar", ...)
     if (ImGui::Begin("StatusBar", nullptr,
                      ImGuiWindowFlags_NoTitleBar |
@@ -23,7 +28,20 @@ void EditorUI::renderStatusBar() {
                      ImGuiWindowFlags_NoResize |
                      ImGuiWindowFlags_NoScrollbar)) {
 
-        ImGui::TextColored(ImVec4(0.3f, 0.9f, 0.4f, 1.0f), "%s", m_saveStatus.c_str());
+        if (!m_saveStatus.empty()) {
+            ImGui::TextColored(ImVec4(0.3f, 0.9f, 0.4f, 1.0f), "%s", m_saveStatus.c_str());
+        }
+
+        // Autosave state, right-aligned
+        if (!autosaveText.empty()) {
+            const float x = ImGui::GetWindowContentRegionMax().x - ImGui::CalcTextSize(autosaveText.c_str()).x;
+            if (!m_saveStatus.empty()) ImGui::SameLine();
+            ImGui::SetCursorPosX(std::max(ImGui::GetCursorPosX(), x));
+            const ImVec4 color = autosave.getStatus() == AutosaveService::Status::Failed
+                ? ImVec4(0.9f, 0.3f, 0.3f, 1.0f)
+                : ImVec4(0.6f, 0.6f, 0.6f, 1.0f);
+            ImGui::TextColored(color, "%s", autosaveText.c_str());
+        }
     }
 
     ImGui::End();
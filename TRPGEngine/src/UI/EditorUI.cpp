@@ -15,6 +15,7 @@
 #include "Project/ProjectManager.hpp"
 #include "Project/BuildSystem.hpp"
 #include "Project/RuntimeLauncher.hpp"
+#include "Project/SceneStreamer.hpp"
 #include "UI/ImGuiUtils/ImGuiUtils.hpp"
 
 #include <glad/glad.h> 
@@ -235,6 +236,8 @@ void EditorUI::setSelectedEntity(Entity e) {
     if (EntityManager::get().hasComponent(e, ComponentType::FlowNode)) {
         SceneManager::get().setCurrentFlowNode(e);  // Only show current FlowNode
         std::cout << "[EditorUI] FlowNode component found. Set as current FlowNode.\n";
+    } else {
+        SceneStreamer::get().request(EntityManager::get(), e);  // page in the scene it belongs to
     }
 }
 
@@ -14,6 +14,7 @@
 #include "Engine/EntitySystem/EntityManager.hpp"
 #include "Engine/EntitySystem/Entity.hpp"
 #include "Engine/EntitySystem/ComponentRegistry.hpp"
+#include "Engine/EntitySystem/PrefabManager.hpp"
 #include "Resources/ResourceManager.hpp"  // mark unsaved on changes
 
 /**
@@ -38,13 +39,40 @@ void EditorUI::renderEntityInspector(Entity entity) {
         return;
     }
 
+    // 0. Prefab link: instances share the prefab's data until a field is edited
+    if (ImGui::CollapsingHeader("Prefab")) {
+        const EntityMeta* meta = em.getMeta(entity);
+        if (meta && meta->prefab) {
+            ImGui::Text("Instance of: %s", PrefabManager::get().idForPath(meta->prefab->path).c_str());
+            if (ImGui::Button("Revert to Prefab")) {
+                em.linkPrefab(entity, meta->prefab);
+                ResourceManager::get().setUnsavedChanges(true);
+                setStatusMessage("Reverted to prefab.");
+            }
+        } else if (meta) {
+            ImGui::TextDisabled("Not a prefab instance.");
+            if (ImGui::Button("Save as Prefab")) {
+                const std::string fileName = (meta->name.empty() ? "Entity" : meta->name) + ".prefab";
+                const auto path = (getSelectedFolder() / fileName).string();
+                if (auto prefab = PrefabManager::get().saveEntityAsPrefab(entity, path)) {
+                    em.linkPrefab(entity, prefab);
+                    ResourceManager::get().setUnsavedChanges(true);
+                    forceFolderRefresh();
+                    setStatusMessage("Saved prefab: " + PrefabManager::get().idForPath(prefab->path));
+                } else {
+                    setStatusMessage("Failed to save prefab.");
+                }
+            }
+        }
+    }
+
     // 1. Add Component Section
     if (ImGui::CollapsingHeader("Add Component", ImGuiTreeNodeFlags_DefaultOpen)) {
         // Build a fresh list each frame to reflect registry changes and keep scale-friendly
         std::vector<std::pair<std::string, ComponentType>> entries;
-        entries.reserve(ComponentTypeRegistry::getAllInfos().size());
-        for (const auto& [type, info] : ComponentTypeRegistry::getAllInfos()) {
-            entries.emplace_back(info.key, type);
+        entries.reserve(ComponentTypeRegistry::getRegisteredTypes().size());
+        for (ComponentType type : ComponentTypeRegistry::getRegisteredTypes()) {
+            entries.emplace_back(ComponentTypeRegistry::getInfo(type)->key, type);
         }
         std::sort(entries.begin(), entries.end(), [](auto& a, auto& b){ return a.first < b.first; });
 
@@ -135,11 +163,11 @@ void EditorUI::renderEntityInspector(Entity entity) {
         // Build list of components actually on this entity
         std::vector<std::string> presentKeys;
         std::vector<ComponentType> presentTypes;
-        for (const auto& comp : em.getAllComponents(entity)) {
-            const auto* info = ComponentTypeRegistry::getInfo(comp->getType());
-            if (!info) continue;
-            presentKeys.push_back(info->key);
-            presentTypes.push_back(comp->getType());
+        // hasComponent, not getAllComponents: listing must not unshare prefab components
+        for (ComponentType type : ComponentTypeRegistry::getRegisteredTypes()) {
+            if (!em.hasComponent(entity, type)) continue;
+            presentKeys.push_back(ComponentTypeRegistry::getInfo(type)->key);
+            presentTypes.push_back(type);
         }
 
         if (presentKeys.empty()) {
@@ -192,7 +220,12 @@ void EditorUI::renderEntityInspector(Entity entity) {
         ImGui::PushID(info->key.c_str());
         if (ImGui::CollapsingHeader(info->key.c_str(), ImGuiTreeNodeFlags_DefaultOpen)) {
             if (info->inspectorRenderer) {
+                // Inspectors flag their edits through ResourceManager; forward them to change tracking
+                const uint64_t editsBefore = ResourceManager::get().getEditCount();
                 info->inspectorRenderer(comp);
+                if (ResourceManager::get().getEditCount() != editsBefore) {
+                    em.markDirty(entity, type);
+                }
             } else {
                 ImGui::Text("No inspector defined for %s", info->key.c_str());
             }
@@ -6,6 +6,7 @@
 #include <json.hpp>
 #include "UI/EditorUI.hpp"
 #include "Engine/EntitySystem/EntityManager.hpp"
+#include "Engine/EntitySystem/EntityRefs.hpp"
 #include "Engine/EntitySystem/Components/FlowNodeComponent.hpp"
 #include "Engine/EntitySystem/Components/DialogueComponent.hpp"
 #include "Engine/EntitySystem/Components/ChoiceComponent.hpp"
@@ -19,13 +20,13 @@ namespace {
 	bool g_verticalLayout = true;
 
 	// Resolve a scene-name to FlowNode entity
-	Entity findSceneByName(const std::string& name) {
+	Entity findSceneByName(Atom name) {
 		if (name.empty()) return INVALID_ENTITY;
-		auto& em = EntityManager::get();
+		const EntityManager& em = EntityManager::get();     // const: reading must not unshare anything
 		Entity metaEntity = ProjectManager::getProjectMetaEntity();
 		auto base = em.getComponent(metaEntity, ComponentType::ProjectMetadata);
 		if (!base) return INVALID_ENTITY;
-		auto meta = std::static_pointer_cast<ProjectMetaComponent>(base);
+		auto meta = std::static_pointer_cast<const ProjectMetaComponent>(base);
 		for (Entity n : meta->sceneNodes) {
 			auto fn = em.getComponent<FlowNodeComponent>(n);
 			if (fn && fn->name == name) return n;
@@ -36,7 +37,7 @@ namespace {
 	// Collect aggregated targets from events of a scene
 	std::map<Entity, std::vector<std::string>> collectAggregatedTargets(Entity sceneNode) {
 		std::map<Entity, std::vector<std::string>> agg;
-		auto& em = EntityManager::get();
+		const EntityManager& em = EntityManager::get();
 		auto flow = em.getComponent<FlowNodeComponent>(sceneNode);
 		if (!flow) return agg;
 
@@ -47,7 +48,7 @@ namespace {
 
 			if (auto d = em.getComponent<DialogueComponent>(evt)) {
 				// Only scene-name targets; skip @Event jumps
-				if (!d->targetFlowNode.empty() && d->targetFlowNode.rfind("@Event:", 0) != 0) {
+				if (!d->targetFlowNode.empty() && !d->targetFlowNode.startsWith("@Event:")) {
 					Entity tgt = findSceneByName(d->targetFlowNode);
 					if (tgt != INVALID_ENTITY) {
 						std::string label = "Dialogue";
@@ -56,11 +57,11 @@ namespace {
 					}
 				}
 			} else if (auto r = em.getComponent<DiceRollComponent>(evt)) {
-				if (!r->onSuccess.empty() && r->onSuccess.rfind("@Event:", 0) != 0) {
+				if (!r->onSuccess.empty() && !r->onSuccess.startsWith("@Event:")) {
 					Entity tgt = findSceneByName(r->onSuccess);
 					if (tgt != INVALID_ENTITY) agg[tgt].push_back("Dice: success");
 				}
-				if (!r->onFailure.empty() && r->onFailure.rfind("@Event:", 0) != 0) {
+				if (!r->onFailure.empty() && !r->onFailure.startsWith("@Event:")) {
 					Entity tgt = findSceneByName(r->onFailure);
 					if (tgt != INVALID_ENTITY) agg[tgt].push_back("Dice: failure");
 				}
@@ -74,7 +75,7 @@ namespace {
 						baseText = baseText.substr(0, pos);
 					}
 					if (!target.empty() && target.rfind("@Event:", 0) != 0) {
-						Entity tgt = findSceneByName(target);
+						Entity tgt = findSceneByName(Atom::find(target));
 						if (tgt != INVALID_ENTITY) {
 							agg[tgt].push_back("Choice: " + baseText);
 						}
@@ -119,13 +120,14 @@ namespace FlowCanvas {
 
 	void Render() {
 		auto& em = EntityManager::get();
+		const EntityManager& cem = em;     // const reads never unshare prefab or forked components
 		Entity metaEntity = ProjectManager::getProjectMetaEntity();
-		auto base = em.getComponent(metaEntity, ComponentType::ProjectMetadata);
+		auto base = cem.getComponent(metaEntity, ComponentType::ProjectMetadata);
 		if (!base) {
 			ImGui::TextDisabled("Project metadata missing.");
 			return;
 		}
-		auto meta = std::static_pointer_cast<ProjectMetaComponent>(base);
+		auto meta = std::static_pointer_cast<const ProjectMetaComponent>(base);
 
 		ImGui::TextDisabled("Flowchart: drag nodes; drag from port to connect; right-click output port to clear link");
 		ImGui::BeginChild("FlowchartCanvas", ImVec2(0, 0), true, ImGuiWindowFlags_NoScrollWithMouse | ImGuiWindowFlags_NoScrollbar);
@@ -153,8 +155,11 @@ namespace FlowCanvas {
 			nlohmann::json j;
 			in >> j;
 			if (!j.is_object()) return;
+			// Keyed by GUID; layouts saved before GUIDs are keyed by entity id
 			for (auto it = j.begin(); it != j.end(); ++it) {
-				Entity id = static_cast<Entity>(std::stoul(it.key()));
+				const uint64_t key = std::stoull(it.key());
+				const Entity id = key >= EntityRefs::FIRST_GUID ? em.findByGuid(key) : static_cast<Entity>(key);
+				if (id == INVALID_ENTITY) continue;
 				if (!it.value().is_array() || it.value().size() != 2) continue;
 				float x = it.value()[0].get<float>();
 				float y = it.value()[1].get<float>();
@@ -168,7 +173,8 @@ namespace FlowCanvas {
 			std::filesystem::create_directories(path.parent_path(), ec);
 			nlohmann::json j = nlohmann::json::object();
 			for (auto& kv : s_nodePos) {
-				j[std::to_string(static_cast<unsigned>(kv.first))] = { kv.second.x, kv.second.y };
+				const uint64_t guid = em.getGuid(kv.first);
+				if (guid) j[std::to_string(guid)] = { kv.second.x, kv.second.y };
 			}
 			std::ofstream out(path);
 			if (!out.is_open()) return;
@@ -193,7 +199,7 @@ namespace FlowCanvas {
 		for (size_t i = 0; i < meta->sceneNodes.size(); ++i) {
 			Entity nodeId = meta->sceneNodes[i];
 			ensurePos(nodeId, (int)i);
-			auto fn = em.getComponent<FlowNodeComponent>(nodeId);
+			auto fn = cem.getComponent<FlowNodeComponent>(nodeId);
 			if (!fn) continue;
 			if (fn->nextNode >= 0) {
 				Entity to = (Entity)fn->nextNode;
@@ -209,8 +215,8 @@ namespace FlowCanvas {
 		for (size_t i = 0; i < meta->sceneNodes.size(); ++i) {
 			Entity nodeId = meta->sceneNodes[i];
 			ensurePos(nodeId, (int)i);
-			auto fn = em.getComponent<FlowNodeComponent>(nodeId);
-			std::string title = fn ? fn->name : ("[Missing] " + std::to_string(nodeId));
+			auto fn = cem.getComponent<FlowNodeComponent>(nodeId);
+			std::string title = fn ? fn->name.str() : ("[Missing] " + std::to_string(nodeId));
 
 			ImVec2 npos = origin + s_nodePos[nodeId];
 			ImVec2 size(160, 60);
@@ -299,7 +305,7 @@ namespace FlowCanvas {
 			if (ImGui::IsMouseHoveringRect(outPort - ImVec2(8, 8), outPort + ImVec2(8, 8))) {
 				if (ImGui::IsMouseClicked(ImGuiMouseButton_Left)) s_linkFrom = nodeId;
 				if (ImGui::IsMouseClicked(ImGuiMouseButton_Right)) {
-					if (auto src = em.getComponent<FlowNodeComponent>(nodeId)) {
+					if (auto* src = em.getMutable<FlowNodeComponent>(nodeId)) {
 						src->nextNode = -1;
 						ResourceManager::get().setUnsavedChanges(true);
 					}
@@ -316,7 +322,7 @@ namespace FlowCanvas {
 			// Accept link on input port
 			if (ImGui::IsMouseHoveringRect(inPort - ImVec2(8, 8), inPort + ImVec2(8, 8))) {
 				if (s_linkFrom != INVALID_ENTITY && ImGui::IsMouseReleased(ImGuiMouseButton_Left)) {
-					if (auto src = em.getComponent<FlowNodeComponent>(s_linkFrom)) {
+					if (auto* src = em.getMutable<FlowNodeComponent>(s_linkFrom)) {
 						src->nextNode = (int)nodeId;
 						ResourceManager::get().setUnsavedChanges(true);
 					}
@@ -337,7 +343,7 @@ namespace FlowCanvas {
 
 		// Draw aggregated multi-edges (event routes) and explicit nextNode edges
 		for (Entity src : meta->sceneNodes) {
-			if (!em.getComponent<FlowNodeComponent>(src)) continue;
+			if (!cem.getComponent<FlowNodeComponent>(src)) continue;
 
 			// Skip if center missing
 			// if (!nodeCenters.count(src)) continue;
@@ -372,7 +378,7 @@ namespace FlowCanvas {
 			}
 
 			// Explicit nextNode edge (distinct color)
-			if (auto fn = em.getComponent<FlowNodeComponent>(src)) {
+			if (auto fn = cem.getComponent<FlowNodeComponent>(src)) {
 				if (fn->nextNode != INVALID_ENTITY) {
 					// if (!nodeCenters.count((Entity)fn->nextNode)) continue;
 					// ImVec2 srcCenter = nodeCenters[src];
@@ -14,19 +14,21 @@
 #include "Engine/EntitySystem/Components/DiceRollComponent.hpp"
 #include "Project/ProjectManager.hpp"
 #include "Engine/RenderSystem/SceneManager.hpp" // sync viewport with selected scene
+#include "Engine/GameplaySystem/FlowExecutor.hpp"
 
 void FlowEventsPanel::Render() {
     auto& em = EntityManager::get();
+    const EntityManager& cem = em;     // const reads never unshare prefab or forked components
     EditorUI* ui = EditorUI::get();
 
     // Helper: owner lookup (shared by header and context menu)
     auto findOwnerScene = [&](Entity evt)->Entity {
         Entity metaEntity = ProjectManager::getProjectMetaEntity();
-        auto base = em.getComponent(metaEntity, ComponentType::ProjectMetadata);
+        auto base = cem.getComponent(metaEntity, ComponentType::ProjectMetadata);
         if (!base) return INVALID_ENTITY;
-        auto meta = std::static_pointer_cast<ProjectMetaComponent>(base);
+        auto meta = std::static_pointer_cast<const ProjectMetaComponent>(base);
         for (Entity n : meta->sceneNodes) {
-            auto fn = em.getComponent<FlowNodeComponent>(n);
+            auto fn = cem.getComponent<FlowNodeComponent>(n);
             if (!fn) continue;
             for (Entity e : fn->eventSequence) if (e == evt) return n;
         }
@@ -41,16 +43,16 @@ void FlowEventsPanel::Render() {
     Entity sel = (ui ? ui->getSelectedEntity() : INVALID_ENTITY);
     if (em.hasComponent(sel, ComponentType::FlowNode)) {
         selectedNode = sel;
-    } else if (em.getComponent<DialogueComponent>(sel) ||
-               em.getComponent<ChoiceComponent>(sel) ||
-               em.getComponent<DiceRollComponent>(sel)) {
+    } else if (cem.getComponent<DialogueComponent>(sel) ||
+               cem.getComponent<ChoiceComponent>(sel) ||
+               cem.getComponent<DiceRollComponent>(sel)) {
         selectedNode = findOwnerScene(sel);
     }
     if (selectedNode == INVALID_ENTITY) {
         Entity metaEntity = ProjectManager::getProjectMetaEntity();
-        auto base = em.getComponent(metaEntity, ComponentType::ProjectMetadata);
+        auto base = cem.getComponent(metaEntity, ComponentType::ProjectMetadata);
         if (base) {
-            auto meta = std::static_pointer_cast<ProjectMetaComponent>(base);
+            auto meta = std::static_pointer_cast<const ProjectMetaComponent>(base);
             if (em.hasComponent(meta->startNode, ComponentType::FlowNode))
                 selectedNode = meta->startNode;
         }
@@ -64,14 +66,14 @@ void FlowEventsPanel::Render() {
         std::vector<std::string> labels;
         std::vector<const char*> items;
         Entity metaEntity = ProjectManager::getProjectMetaEntity();
-        if (auto base = em.getComponent(metaEntity, ComponentType::ProjectMetadata)) {
-            auto meta = std::static_pointer_cast<ProjectMetaComponent>(base);
+        if (auto base = cem.getComponent(metaEntity, ComponentType::ProjectMetadata)) {
+            auto meta = std::static_pointer_cast<const ProjectMetaComponent>(base);
             sceneIds.reserve(meta->sceneNodes.size());
             labels.reserve(meta->sceneNodes.size());
             for (Entity nodeId : meta->sceneNodes) {
                 sceneIds.push_back(nodeId);
-                auto fn = em.getComponent<FlowNodeComponent>(nodeId);
-                labels.emplace_back(fn ? fn->name : std::string("[Missing] ") + std::to_string((unsigned)nodeId));
+                auto fn = cem.getComponent<FlowNodeComponent>(nodeId);
+                labels.emplace_back(fn ? fn->name.str() : std::string("[Missing] ") + std::to_string((unsigned)nodeId));
             }
             // Important: build items after labels are finalized to avoid dangling c_str pointers
             items.reserve(labels.size());
@@ -116,27 +118,30 @@ void FlowEventsPanel::Render() {
         ImGui::TextDisabled("Tip: Select a FlowNode or an Event in Hierarchy, or pick a Scene above. Use Edit -> Add Event to create events.");
         return;
     } else {
-        auto fn = em.getComponent<FlowNodeComponent>(selectedNode);
-        std::string nodeName = fn ? fn->name : std::string("[Missing]");
+        auto fn = cem.getComponent<FlowNodeComponent>(selectedNode);
+        std::string nodeName = fn ? fn->name.str() : std::string("[Missing]");
         ImGui::Text("Selected Scene: %s (ID %u)", nodeName.c_str(), (unsigned)selectedNode);
         ImGui::TextDisabled("Use Edit -> Add Event to create events for this scene.");
     }
 
-    auto flow = em.getComponent<FlowNodeComponent>(selectedNode);
+    auto flow = cem.getComponent<FlowNodeComponent>(selectedNode);
     if (!flow) {
         ImGui::TextDisabled("Selected entity has no FlowNodeComponent.");
         return;
     }
+    // getMutable may swap in a private copy, so `flow` is re-read after each edit
+    auto editFlow = [&]() -> FlowNodeComponent& {
+        FlowNodeComponent& f = *em.getMutable<FlowNodeComponent>(selectedNode);
+        flow = cem.getComponent<FlowNodeComponent>(selectedNode);
+        return f;
+    };
 
     ImGui::Separator();
 
     // Clean invalid entries helper
     if (ImGui::SmallButton("Clear Invalid Entries")) {
-        flow->eventSequence.erase(
-            std::remove_if(flow->eventSequence.begin(), flow->eventSequence.end(),
-                [&](Entity e){ return e == INVALID_ENTITY; }),
-            flow->eventSequence.end()
-        );
+        auto& events = editFlow().eventSequence;
+        events.erase(std::remove(events.begin(), events.end(), INVALID_ENTITY), events.end());
         ResourceManager::get().setUnsavedChanges(true);
     }
 
@@ -148,11 +153,11 @@ void FlowEventsPanel::Render() {
         Entity owner = findOwnerScene(evt);
         if (owner == toNode) return true;
         if (owner != INVALID_ENTITY) {
-            if (auto ownFn = em.getComponent<FlowNodeComponent>(owner)) {
+            if (auto* ownFn = em.getMutable<FlowNodeComponent>(owner)) {
                 ownFn->eventSequence.erase(std::remove(ownFn->eventSequence.begin(), ownFn->eventSequence.end(), evt), ownFn->eventSequence.end());
             }
         }
-        if (auto dst = em.getComponent<FlowNodeComponent>(toNode)) {
+        if (auto* dst = em.getMutable<FlowNodeComponent>(toNode)) {
             dst->eventSequence.push_back(evt);
             ResourceManager::get().setUnsavedChanges(true);
             return true;
@@ -165,13 +170,13 @@ void FlowEventsPanel::Render() {
     std::vector<const char*> sceneItems;
     {
         Entity metaEntity = ProjectManager::getProjectMetaEntity();
-        auto base = em.getComponent(metaEntity, ComponentType::ProjectMetadata);
+        auto base = cem.getComponent(metaEntity, ComponentType::ProjectMetadata);
         if (base) {
-            auto meta = std::static_pointer_cast<ProjectMetaComponent>(base);
+            auto meta = std::static_pointer_cast<const ProjectMetaComponent>(base);
             sceneNames.emplace_back("<None>");
             for (Entity e : meta->sceneNodes) {
-                auto fn = em.getComponent<FlowNodeComponent>(e);
-                sceneNames.emplace_back(fn ? fn->name : std::string("[Missing] ") + std::to_string(e));
+                auto fn = cem.getComponent<FlowNodeComponent>(e);
+                sceneNames.emplace_back(fn ? fn->name.str() : std::string("[Missing] ") + std::to_string(e));
             }
             for (auto& s : sceneNames) sceneItems.push_back(s.c_str());
         }
@@ -185,11 +190,11 @@ void FlowEventsPanel::Render() {
 
         const char* typeLabel = "Unknown";
         std::string preview;
-        if (auto d = em.getComponent<DialogueComponent>(evt)) {
+        if (auto d = cem.getComponent<DialogueComponent>(evt)) {
             typeLabel = "Dialogue"; if (!d->lines.empty()) preview = d->lines.front();
-        } else if (auto c = em.getComponent<ChoiceComponent>(evt)) {
+        } else if (auto c = cem.getComponent<ChoiceComponent>(evt)) {
             typeLabel = "Choice"; if (!c->options.empty()) preview = c->options.front().text;
-        } else if (auto r = em.getComponent<DiceRollComponent>(evt)) {
+        } else if (auto r = cem.getComponent<DiceRollComponent>(evt)) {
             typeLabel = "Dice Roll"; preview = "d" + std::to_string(r->sides) + " >= " + std::to_string(r->threshold);
         }
 
@@ -226,7 +231,8 @@ void FlowEventsPanel::Render() {
             if (const ImGuiPayload* payload = ImGui::AcceptDragDropPayload("EVENT_REORDER_IN_SCENE")) {
                 int src = *(const int*)payload->Data;
                 if (src != i && src >= 0 && src < (int)flow->eventSequence.size()) {
-                    std::swap(flow->eventSequence[src], flow->eventSequence[i]);
+                    auto& events = editFlow().eventSequence;
+                    std::swap(events[src], events[i]);
                     ResourceManager::get().setUnsavedChanges(true);
                 }
             }
@@ -239,15 +245,18 @@ void FlowEventsPanel::Render() {
             bool canDown = (i < (int)flow->eventSequence.size() - 1);
 
             if (ImGui::MenuItem("Up", nullptr, false, canUp)) {
-                std::swap(flow->eventSequence[i-1], flow->eventSequence[i]);
+                auto& events = editFlow().eventSequence;
+                std::swap(events[i-1], events[i]);
                 ResourceManager::get().setUnsavedChanges(true);
             }
             if (ImGui::MenuItem("Down", nullptr, false, canDown)) {
-                std::swap(flow->eventSequence[i+1], flow->eventSequence[i]);
+                auto& events = editFlow().eventSequence;
+                std::swap(events[i+1], events[i]);
                 ResourceManager::get().setUnsavedChanges(true);
             }
             if (ImGui::MenuItem("Remove")) {
-                flow->eventSequence.erase(flow->eventSequence.begin() + i);
+                auto& events = editFlow().eventSequence;
+                events.erase(events.begin() + i);
                 ResourceManager::get().setUnsavedChanges(true);
                 ImGui::EndPopup();
                 ImGui::PopID();
@@ -263,24 +272,24 @@ void FlowEventsPanel::Render() {
         }
 
         // Inline "Result" editors (same as before)
-        if (auto d = em.getComponent<DialogueComponent>(evt)) {
+        if (auto d = cem.getComponent<DialogueComponent>(evt)) {
             ImGui::TextDisabled("Result:"); ImGui::SameLine();
-            std::string summary = d->targetFlowNode.empty() ? "Next Event or Next Scene (default)" : d->targetFlowNode;
+            std::string summary = d->targetFlowNode.empty() ? "Next Event or Next Scene (default)" : d->targetFlowNode.str();
             ImGui::Text("%s", summary.c_str());
 
             if (!sceneItems.empty()) {
                 int cur = 0;
-                if (!d->targetFlowNode.empty() && d->targetFlowNode.rfind("@Event:", 0) != 0) {
+                if (!d->targetFlowNode.empty() && !d->targetFlowNode.startsWith("@Event:")) {
                     for (int si = 1; si < (int)sceneNames.size(); ++si)
-                        if (sceneNames[si] == d->targetFlowNode) { cur = si; break; }
+                        if (sceneNames[si] == d->targetFlowNode.str()) { cur = si; break; }
                 }
                 if (ImGui::Combo("Set Scene##dlg", &cur, sceneItems.data(), (int)sceneItems.size())) {
-                    d->targetFlowNode = (cur == 0) ? std::string() : sceneNames[cur];
+                    em.getMutable<DialogueComponent>(evt)->targetFlowNode = (cur == 0) ? std::string() : sceneNames[cur];
                     ResourceManager::get().setUnsavedChanges(true);
                 }
                 ImGui::SameLine();
                 if (ImGui::SmallButton("Clear##dlg")) {
-                    d->targetFlowNode.clear();
+                    em.getMutable<DialogueComponent>(evt)->targetFlowNode = Atom();
                     ResourceManager::get().setUnsavedChanges(true);
                 }
             }
@@ -293,32 +302,32 @@ void FlowEventsPanel::Render() {
             }
             std::vector<const char*> items; for (auto& s : labels) items.push_back(s.c_str());
             int curEvt = 0;
-            if (!d->targetFlowNode.empty() && d->targetFlowNode.rfind("@Event:", 0) == 0) {
-                for (int k = 1; k < (int)labels.size(); ++k) if (labels[k] == d->targetFlowNode) { curEvt = k; break; }
+            if (!d->targetFlowNode.empty() && d->targetFlowNode.startsWith("@Event:")) {
+                for (int k = 1; k < (int)labels.size(); ++k) if (labels[k] == d->targetFlowNode.str()) { curEvt = k; break; }
             }
             if (ImGui::Combo("Set Event##dlg", &curEvt, items.data(), (int)items.size())) {
-                d->targetFlowNode = (curEvt == 0) ? std::string() : labels[curEvt];
+                em.getMutable<DialogueComponent>(evt)->targetFlowNode = (curEvt == 0) ? std::string() : labels[curEvt];
                 ResourceManager::get().setUnsavedChanges(true);
             }
-        } else if (auto r = em.getComponent<DiceRollComponent>(evt)) {
+        } else if (auto r = cem.getComponent<DiceRollComponent>(evt)) {
             ImGui::TextDisabled("Result:"); ImGui::SameLine();
-            std::string succ = r->onSuccess.empty() ? "Next Event/Scene" : r->onSuccess;
-            std::string fail = r->onFailure.empty() ? "Next Event/Scene" : r->onFailure;
+            std::string succ = r->onSuccess.empty() ? "Next Event/Scene" : r->onSuccess.str();
+            std::string fail = r->onFailure.empty() ? "Next Event/Scene" : r->onFailure.str();
             ImGui::Text("On Success -> %s | On Failure -> %s", succ.c_str(), fail.c_str());
 
             if (!sceneItems.empty()) {
                 int cs = 0, cf = 0;
-                if (!r->onSuccess.empty() && r->onSuccess.rfind("@Event:", 0) != 0)
-                    for (int si = 1; si < (int)sceneNames.size(); ++si) if (sceneNames[si] == r->onSuccess) { cs = si; break; }
-                if (!r->onFailure.empty() && r->onFailure.rfind("@Event:", 0) != 0)
-                    for (int si = 1; si < (int)sceneNames.size(); ++si) if (sceneNames[si] == r->onFailure) { cf = si; break; }
+                if (!r->onSuccess.empty() && !r->onSuccess.startsWith("@Event:"))
+                    for (int si = 1; si < (int)sceneNames.size(); ++si) if (sceneNames[si] == r->onSuccess.str()) { cs = si; break; }
+                if (!r->onFailure.empty() && !r->onFailure.startsWith("@Event:"))
+                    for (int si = 1; si < (int)sceneNames.size(); ++si) if (sceneNames[si] == r->onFailure.str()) { cf = si; break; }
 
                 if (ImGui::Combo("On Success -> Scene##dice", &cs, sceneItems.data(), (int)sceneItems.size())) {
-                    r->onSuccess = (cs == 0) ? std::string() : sceneNames[cs];
+                    em.getMutable<DiceRollComponent>(evt)->onSuccess = (cs == 0) ? std::string() : sceneNames[cs];
                     ResourceManager::get().setUnsavedChanges(true);
                 }
                 if (ImGui::Combo("On Failure -> Scene##dice", &cf, sceneItems.data(), (int)sceneItems.size())) {
-                    r->onFailure = (cf == 0) ? std::string() : sceneNames[cf];
+                    em.getMutable<DiceRollComponent>(evt)->onFailure = (cf == 0) ? std::string() : sceneNames[cf];
                     ResourceManager::get().setUnsavedChanges(true);
                 }
             }
@@ -331,20 +340,20 @@ void FlowEventsPanel::Render() {
             }
             std::vector<const char*> items; for (auto& s : events) items.push_back(s.c_str());
             int succEvt = 0, failEvt = 0;
-            if (!r->onSuccess.empty() && r->onSuccess.rfind("@Event:", 0) == 0)
-                for (int i2 = 1; i2 < (int)events.size(); ++i2) if (events[i2] == r->onSuccess) succEvt = i2;
-            if (!r->onFailure.empty() && r->onFailure.rfind("@Event:", 0) == 0)
-                for (int i2 = 1; i2 < (int)events.size(); ++i2) if (events[i2] == r->onFailure) failEvt = i2;
+            if (!r->onSuccess.empty() && r->onSuccess.startsWith("@Event:"))
+                for (int i2 = 1; i2 < (int)events.size(); ++i2) if (events[i2] == r->onSuccess.str()) succEvt = i2;
+            if (!r->onFailure.empty() && r->onFailure.startsWith("@Event:"))
+                for (int i2 = 1; i2 < (int)events.size(); ++i2) if (events[i2] == r->onFailure.str()) failEvt = i2;
 
             if (ImGui::Combo("On Success -> Event", &succEvt, items.data(), (int)items.size())) {
-                r->onSuccess = (succEvt == 0) ? std::string() : events[succEvt];
+                em.getMutable<DiceRollComponent>(evt)->onSuccess = (succEvt == 0) ? std::string() : events[succEvt];
                 ResourceManager::get().setUnsavedChanges(true);
             }
             if (ImGui::Combo("On Failure -> Event", &failEvt, items.data(), (int)items.size())) {
-                r->onFailure = (failEvt == 0) ? std::string() : events[failEvt];
+                em.getMutable<DiceRollComponent>(evt)->onFailure = (failEvt == 0) ? std::string() : events[failEvt];
                 ResourceManager::get().setUnsavedChanges(true);
             }
-        } else if (em.getComponent<ChoiceComponent>(evt)) {
+        } else if (cem.getComponent<ChoiceComponent>(evt)) {
             ImGui::TextDisabled("Result:"); ImGui::SameLine();
             ImGui::Text("Per choice option. Edit options in Choice inspector.");
         }
@@ -357,14 +366,14 @@ void FlowEventsPanel::Render() {
 
     // Validate branching targets (unchanged)
     if (ImGui::Button("Validate Branching")) {
-        auto findNodeByName = [&](const std::string& nodeName) -> Entity {
+        auto findNodeByName = [&](Atom nodeName) -> Entity {
             if (nodeName.empty()) return INVALID_ENTITY;
             Entity metaEntity = ProjectManager::getProjectMetaEntity();
-            auto base = em.getComponent(metaEntity, ComponentType::ProjectMetadata);
+            auto base = cem.getComponent(metaEntity, ComponentType::ProjectMetadata);
             if (!base) return INVALID_ENTITY;
-            auto meta = std::static_pointer_cast<ProjectMetaComponent>(base);
+            auto meta = std::static_pointer_cast<const ProjectMetaComponent>(base);
             for (Entity e : meta->sceneNodes) {
-                auto f = em.getComponent<FlowNodeComponent>(e);
+                auto f = cem.getComponent<FlowNodeComponent>(e);
                 if (f && f->name == nodeName) return e;
             }
             return INVALID_ENTITY;
@@ -374,40 +383,33 @@ void FlowEventsPanel::Render() {
             for (Entity e : flow->eventSequence) if (e == evt) return true;
             return false;
         };
-        auto parseEventTag = [&](const std::string& s) -> Entity {
-            const std::string tag = "@Event:";
-            if (s.rfind(tag, 0) == 0) {
-                try { return (Entity)std::stoull(s.substr(tag.size())); } catch (...) { return INVALID_ENTITY; }
-            }
-            return INVALID_ENTITY;
-        };
 
         int warnings = 0;
         for (Entity evt : flow->eventSequence) {
             if (evt == INVALID_ENTITY) continue;
 
-            if (auto d = em.getComponent<DialogueComponent>(evt)) {
-                Entity evtT = parseEventTag(d->targetFlowNode);
+            if (auto d = cem.getComponent<DialogueComponent>(evt)) {
+                Entity evtT = parseEventTarget(d->targetFlowNode.str());
                 if (evtT != INVALID_ENTITY && !belongsToThisNode(evtT)) ++warnings;
                 if (evtT == INVALID_ENTITY && !d->targetFlowNode.empty() && findNodeByName(d->targetFlowNode) == INVALID_ENTITY) ++warnings;
-            } else if (auto dice = em.getComponent<DiceRollComponent>(evt)) {
-                Entity succT = parseEventTag(dice->onSuccess);
-                Entity failT = parseEventTag(dice->onFailure);
+            } else if (auto dice = cem.getComponent<DiceRollComponent>(evt)) {
+                Entity succT = parseEventTarget(dice->onSuccess.str());
+                Entity failT = parseEventTarget(dice->onFailure.str());
                 if (succT != INVALID_ENTITY && !belongsToThisNode(succT)) ++warnings;
                 if (failT != INVALID_ENTITY && !belongsToThisNode(failT)) ++warnings;
                 if (succT == INVALID_ENTITY && !dice->onSuccess.empty() && findNodeByName(dice->onSuccess) == INVALID_ENTITY) ++warnings;
                 if (failT == INVALID_ENTITY && !dice->onFailure.empty() && findNodeByName(dice->onFailure) == INVALID_ENTITY) ++warnings;
-            } else if (auto ch = em.getComponent<ChoiceComponent>(evt)) {
+            } else if (auto ch = cem.getComponent<ChoiceComponent>(evt)) {
                 for (auto& opt : ch->options) {
                     std::string label = opt.text;
                     const std::string delim = " -> ";
                     size_t pos = label.rfind(delim);
                     if (pos != std::string::npos) {
                         std::string tgt = label.substr(pos + delim.size());
-                        Entity evtT = parseEventTag(tgt);
+                        Entity evtT = parseEventTarget(tgt);
                         if (evtT != INVALID_ENTITY) {
                             if (!belongsToThisNode(evtT)) ++warnings;
-                        } else if (!tgt.empty() && findNodeByName(tgt) == INVALID_ENTITY) {
+                        } else if (!tgt.empty() && findNodeByName(Atom::find(tgt)) == INVALID_ENTITY) {
                             ++warnings;
                         }
                     }
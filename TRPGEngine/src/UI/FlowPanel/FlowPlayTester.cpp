@@ -6,6 +6,7 @@
 #include "Project/ProjectManager.hpp"
 #include "Engine/RenderSystem/SceneManager.hpp"
 #include "Engine/GameplaySystem/FlowExecutor.hpp" // + bind/tick executor for play preview
+#include "Engine/World.hpp"
 
 // Shared play state and menu-bound controls
 static bool g_playing = false;
@@ -26,32 +27,35 @@ static Entity PickStartNode() {
     return INVALID_ENTITY;
 }
 
+// Binds the start node in the current (play) world
+static void StartFromNode() {
+    if (g_playCurrent != INVALID_ENTITY) {
+        FlowExecutor::get().reset();
+        SceneManager::get().setCurrentFlowNode(g_playCurrent);
+        if (EditorUI* ui = EditorUI::get()) ui->setSelectedEntity(g_playCurrent);
+        // Initial bind so overlay shows immediately (won't advance Choice/Dice due to executor change)
+        FlowExecutor::get().tick();
+    }
+}
+
 extern "C" {
     bool Editor_Run_IsPlaying() { return g_playing; }
     void Editor_Run_Play() {
         g_playing = true;
-        g_playCurrent = PickStartNode();
-        if (g_playCurrent != INVALID_ENTITY) {
-            FlowExecutor::get().reset();
-            SceneManager::get().setCurrentFlowNode(g_playCurrent);
-            if (EditorUI* ui = EditorUI::get()) ui->setSelectedEntity(g_playCurrent);
-            // Initial bind so overlay shows immediately (won't advance Choice/Dice due to executor change)
-            FlowExecutor::get().tick();
-        }
+        g_playCurrent = PickStartNode();    // picked from the editor world, same handles in the fork
+        World::beginPlaySession();          // play edits a snapshot; Stop throws it away
+        StartFromNode();
     }
     void Editor_Run_Stop() {
         g_playing = false;
         g_playCurrent = INVALID_ENTITY;
-        FlowExecutor::get().reset();
+        World::endPlaySession();
     }
     void Editor_Run_Restart() {
+        World::endPlaySession();
         g_playCurrent = PickStartNode();
-        if (g_playCurrent != INVALID_ENTITY) {
-            FlowExecutor::get().reset();
-            SceneManager::get().setCurrentFlowNode(g_playCurrent);
-            if (EditorUI* ui = EditorUI::get()) ui->setSelectedEntity(g_playCurrent);
-            FlowExecutor::get().tick(); // initial bind
-        }
+        World::beginPlaySession();
+        StartFromNode();
     }
 }
 
@@ -93,7 +97,7 @@ void FlowPlayTester::Render() {
     // Do not auto-tick here; HUD actions tick when needed.
     auto fn = em.getComponent<FlowNodeComponent>(g_playCurrent);
     const char* missing = "[Missing FlowNode]";
-    std::string name = fn ? fn->name : missing;
+    std::string name = fn ? fn->name.str() : missing;
 
     ImGui::Text("Current Node: %s (ID: %u)", name.c_str(), (unsigned)g_playCurrent);
     bool isEnd = (fn && fn->isEnd);
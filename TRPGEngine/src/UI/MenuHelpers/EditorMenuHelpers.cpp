@@ -103,14 +103,14 @@ bool attachEventToScene(Entity evt, Entity sceneNode) {
 
 	// Remove from previous owner
 	if (Entity owner = findOwnerScene(evt); owner != INVALID_ENTITY) {
-		if (auto ownFn = em.getComponent<FlowNodeComponent>(owner)) {
+		if (auto* ownFn = em.getMutable<FlowNodeComponent>(owner)) {
 			ownFn->eventSequence.erase(std::remove(ownFn->eventSequence.begin(), ownFn->eventSequence.end(), evt),
 			                           ownFn->eventSequence.end());
 		}
 	}
 
 	// Attach to destination
-	if (auto dst = em.getComponent<FlowNodeComponent>(sceneNode)) {
+	if (auto* dst = em.getMutable<FlowNodeComponent>(sceneNode)) {
 		dst->eventSequence.push_back(evt);
 		// Refresh SceneManager so Hierarchy and ScenePanel reflect immediately
 		SceneManager::get().setCurrentFlowNode(sceneNode);
@@ -2,7 +2,6 @@
 #define NOMINMAX
 #endif
 #include "UI/ScenePanel/SceneOverlayHUD.hpp"
-#include <random>
 #include <unordered_map>
 #include <algorithm> 
 #include "UI/EditorUI.hpp"
@@ -14,6 +13,8 @@
 #include "Engine/EntitySystem/Components/CharacterComponent.hpp"
 #include "Engine/EntitySystem/Components/ProjectMetaComponent.hpp"
 #include "Engine/RenderSystem/SceneManager.hpp"
+#include "Engine/GameplaySystem/FlowExecutor.hpp"
+#include "Engine/GameplaySystem/GameInstance.hpp"
 #include "Project/ProjectManager.hpp"
 
 void SceneOverlayHUD::Render() {
@@ -39,7 +40,7 @@ void SceneOverlayHUD::Render() {
         return;
     }
 
-    auto& em = EntityManager::get();
+    const EntityManager& em = EntityManager::get();     // drawing only reads
     EditorUI* ui = EditorUI::get();
     if (!ui) { ImGui::End(); return; }
 
@@ -50,7 +51,7 @@ void SceneOverlayHUD::Render() {
         Entity metaEntity = ProjectManager::getProjectMetaEntity();
         auto base = em.getComponent(metaEntity, ComponentType::ProjectMetadata);
         if (base) {
-            auto meta = std::static_pointer_cast<ProjectMetaComponent>(base);
+            auto meta = std::static_pointer_cast<const ProjectMetaComponent>(base);
             if (meta->startNode != INVALID_ENTITY) {
                 current = meta->startNode;
                 hasFlow = em.hasComponent(current, ComponentType::FlowNode);
@@ -65,7 +66,7 @@ void SceneOverlayHUD::Render() {
     }
 
     auto fn = em.getComponent<FlowNodeComponent>(current);
-    std::string name = fn ? fn->name : std::string("[Missing]");
+    std::string name = fn ? fn->name.str() : std::string("[Missing]");
     ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(0.95f, 0.98f, 1.0f, 1.0f));
     ImGui::Text("Node: %s (ID %u)", name.c_str(), (unsigned)current);
     ImGui::PopStyleColor();
@@ -92,7 +93,7 @@ void SceneOverlayHUD::Render() {
     static std::unordered_map<Entity, Entity> s_currentEventByNode; // node -> current event entity
     static Entity s_lastNode = INVALID_ENTITY;
 
-    auto getFirstValidEvent = [&](const std::shared_ptr<FlowNodeComponent>& nodeComp) -> Entity {
+    auto getFirstValidEvent = [&](const std::shared_ptr<const FlowNodeComponent>& nodeComp) -> Entity {
         if (!nodeComp) return INVALID_ENTITY;
         for (Entity e : nodeComp->eventSequence) if (e != INVALID_ENTITY) return e;
         return INVALID_ENTITY;
@@ -109,12 +110,12 @@ void SceneOverlayHUD::Render() {
     }
 
     // Helper: find FlowNode by name
-    auto findNodeByName = [&](const std::string& nodeName) -> Entity {
+    auto findNodeByName = [&](Atom nodeName) -> Entity {
         if (nodeName.empty()) return INVALID_ENTITY;
         Entity metaEntity = ProjectManager::getProjectMetaEntity();
         auto base = em.getComponent(metaEntity, ComponentType::ProjectMetadata);
         if (!base) return INVALID_ENTITY;
-        auto meta = std::static_pointer_cast<ProjectMetaComponent>(base);
+        auto meta = std::static_pointer_cast<const ProjectMetaComponent>(base);
         for (Entity e : meta->sceneNodes) {
             auto f = em.getComponent<FlowNodeComponent>(e);
             if (f && f->name == nodeName) return e;
@@ -122,18 +123,6 @@ void SceneOverlayHUD::Render() {
         return INVALID_ENTITY;
     };
 
-    auto parseEventTag = [&](const std::string& s) -> Entity {
-        // expects "@Event:<id>"
-        const std::string tag = "@Event:";
-        if (s.rfind(tag, 0) == 0) {
-            try {
-                uint64_t id = std::stoull(s.substr(tag.size()));
-                return (Entity)id;
-            } catch (...) { return INVALID_ENTITY; }
-        }
-        return INVALID_ENTITY;
-    };
-
     auto advanceToScene = [&](Entity sceneNode) {
         if (sceneNode == INVALID_ENTITY) return;
         ui->setSelectedEntity(sceneNode);
@@ -206,7 +195,7 @@ void SceneOverlayHUD::Render() {
                 idx++; progressed = true;
             } else {
                 // First try explicit target event tag
-                Entity evtTarget = parseEventTag(d->targetFlowNode);
+                Entity evtTarget = parseEventTarget(d->targetFlowNode.str());
                 if (evtTarget != INVALID_ENTITY && advanceToEvent(evtTarget)) {
                     progressed = true;
                 } else {
@@ -240,15 +229,12 @@ void SceneOverlayHUD::Render() {
         if (lastRoll > 0) ImGui::Text("Last roll: %d", lastRoll);
 
         if (ImGui::Button("Roll")) {
-            std::random_device rd;
-            std::mt19937 gen(rd());
-            std::uniform_int_distribution<> dist(1, (std::max)(1, dice->sides));
-            lastRoll = dist(gen);
+            lastRoll = GameInstance::get().rollDice(*dice);
             bool success = (lastRoll >= dice->threshold);
-            const std::string& nextName = success ? dice->onSuccess : dice->onFailure;
+            const Atom nextName = success ? dice->onSuccess : dice->onFailure;
 
             // Event target?
-            Entity evtTarget = parseEventTag(nextName);
+            Entity evtTarget = parseEventTarget(nextName.str());
             if (evtTarget != INVALID_ENTITY && advanceToEvent(evtTarget)) {
                 // ok
             } else {
@@ -284,11 +270,11 @@ void SceneOverlayHUD::Render() {
                 }
 
                 if (ImGui::Button(baseLabel.c_str())) {
-                    Entity evtTarget = parseEventTag(targetName);
+                    Entity evtTarget = parseEventTarget(targetName);
                     if (evtTarget != INVALID_ENTITY && advanceToEvent(evtTarget)) {
                         // ok
                     } else {
-                        Entity sceneTarget = findNodeByName(targetName);
+                        Entity sceneTarget = findNodeByName(Atom::find(targetName));
                         if (sceneTarget != INVALID_ENTITY) {
                             advanceToScene(sceneTarget);
                         } else {
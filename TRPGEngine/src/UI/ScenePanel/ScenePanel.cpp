@@ -108,7 +108,7 @@ void ScenePanel::renderScenePanel() {
 
     // Draw an in-panel status pill instead of a floating overlay window (no overlap with editor chrome)
     if (GameInstance::get().isRunning() || previewRunning) {
-        auto& em = EntityManager::get();
+        const EntityManager& em = EntityManager::get();     // drawing only reads
         Entity currentNode  = SceneManager::get().getCurrentFlowNode();
         auto nodeComp = em.getComponent<FlowNodeComponent>(currentNode);
         int evtIndex = FlowExecutor::get().currentEventIndex();
@@ -117,7 +117,7 @@ void ScenePanel::renderScenePanel() {
         ImVec2 pad = ImVec2(8, 6);
         ImVec2 textPos = ImVec2(pos.x + 10.0f, pos.y + 8.0f);
         std::string status = std::string("Play Mode  |  Scene: ")
-            + (nodeComp ? nodeComp->name : std::string("<Unknown>"))
+            + (nodeComp ? nodeComp->name.str() : std::string("<Unknown>"))
             + "  |  Event Index: " + std::to_string(evtIndex);
 
         auto dl = ImGui::GetWindowDrawList();
@@ -26,7 +26,7 @@ inline const std::unordered_map<EntityType, EntityTemplate>& getEntityTemplateMa
         {
             EntityType::FlowNode,
             { "Flow Node", EntityType::FlowNode, {
-                [] { auto c = std::make_shared<FlowNodeComponent>();
+                [] { auto c = makeComponent<FlowNodeComponent>();
                      // defaults (explicit to be safe)
                      c->name = "";
                      c->nextNode = INVALID_ENTITY;
@@ -37,43 +37,43 @@ inline const std::unordered_map<EntityType, EntityTemplate>& getEntityTemplateMa
         {
             EntityType::Dialogue,
             { "Dialogue", EntityType::Dialogue,{
-                [] { return std::make_shared<Transform2DComponent>(); },
-                [] { return std::make_shared<DialogueComponent>(); }
+                [] { return makeComponent<Transform2DComponent>(); },
+                [] { return makeComponent<DialogueComponent>(); }
             } }
         },
         {
             EntityType::Character,
             { "Character", EntityType::Character,{
-                [] { return std::make_shared<Transform2DComponent>(); },
-                [] { return std::make_shared<CharacterComponent>(); }
+                [] { return makeComponent<Transform2DComponent>(); },
+                [] { return makeComponent<CharacterComponent>(); }
             } }
         },
         {
             EntityType::UIButton,
             { "UI Button", EntityType::UIButton,{
-                [] { return std::make_shared<Transform2DComponent>(); },
-                [] { return std::make_shared<UIButtonComponent>(); }
+                [] { return makeComponent<Transform2DComponent>(); },
+                [] { return makeComponent<UIButtonComponent>(); }
             } }
         },
         {
             EntityType::Choice,
             { "Choice", EntityType::Choice,{
-                [] { return std::make_shared<Transform2DComponent>(); },
-                [] { return std::make_shared<ChoiceComponent>(); }
+                [] { return makeComponent<Transform2DComponent>(); },
+                [] { return makeComponent<ChoiceComponent>(); }
             } }
         },
         {
             EntityType::DiceRoll,
             { "Dice Roll", EntityType::DiceRoll,{
-                [] { return std::make_shared<Transform2DComponent>(); },
-                [] { return std::make_shared<DiceRollComponent>(); }
+                [] { return makeComponent<Transform2DComponent>(); },
+                [] { return makeComponent<DiceRollComponent>(); }
             } }
         },
         {
             EntityType::Background,
             { "Background", EntityType::Background, {
-                [] { return std::make_shared<Transform2DComponent>(); },
-                [] { return std::make_shared<BackgroundComponent>(); }
+                [] { return makeComponent<Transform2DComponent>(); },
+                [] { return makeComponent<BackgroundComponent>(); }
             } }
         }
     };